@@ -0,0 +1,259 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bfs.h"
+#include "graph.h"
+#include "graph_analytics.h"
+
+// Batch analytics driver: runs one whole-graph job and writes its result
+// to a binary file of one 4-byte, host byte order unsigned int per
+// vertex, indexed by the vertex IDs of the graph file (0-based):
+//
+//   wcc   the smallest vertex ID of each vertex's weakly connected
+//         component;
+//   khop  the number of hops from the nearest seed (-s v,v,... and/or
+//         -S file of whitespace separated IDs), 4294967295 beyond -k.
+//
+// The output file is mapped and written in place (see
+// graph_analytics_map_output()), so no second copy of the result is
+// held in memory. A one line summary goes to stdout.
+//
+// Usage: batch_analytics -g graph.mtx|graph.csr -a wcc|khop -o output.bin
+//                        [-s seed,seed,...] [-S seed_file] [-k hops]
+//                        [-t threads] [-n] [-j threads]
+
+struct batch_options {
+    const char * graph_path;
+    const char * job;
+    const char * output_path;
+    const char * seed_list;
+    const char * seed_path;
+    unsigned int hops;
+    unsigned int threads;
+    struct graph_load_options load;
+};
+
+// Growable array of seed vertices.
+struct seeds {
+    unsigned int * vertices;
+    size_t count;
+    size_t capacity;
+};
+
+static bool add_seed(struct seeds * seeds, unsigned long long vertex) {
+    if (vertex > UINT32_MAX) {
+        return false;
+    }
+
+    if (seeds->count == seeds->capacity) {
+        size_t capacity = seeds->capacity == 0 ? 64 : seeds->capacity * 2;
+        unsigned int * vertices = realloc(seeds->vertices, capacity * sizeof(unsigned int));
+
+        if (vertices == NULL) {
+            return false;
+        }
+
+        seeds->vertices = vertices;
+        seeds->capacity = capacity;
+    }
+
+    seeds->vertices[seeds->count++] = (unsigned int)vertex;
+    return true;
+}
+
+// Parses a comma separated list of seeds.
+static bool parse_seed_list(const char * arg, struct seeds * seeds) {
+    char * end = NULL;
+
+    while (*arg != '\0') {
+        unsigned long long vertex = strtoull(arg, &end, 10);
+
+        if (end == arg || !add_seed(seeds, vertex)) {
+            return false;
+        }
+
+        arg = (*end == ',') ? end + 1 : end;
+    }
+
+    return true;
+}
+
+// Reads whitespace separated seeds from a file.
+static bool read_seed_file(const char * path, struct seeds * seeds) {
+    FILE * in = fopen(path, "r");
+    unsigned long long vertex;
+
+    if (in == NULL) {
+        perror(path);
+        return false;
+    }
+
+    bool ok = true;
+    while (ok && fscanf(in, "%llu", &vertex) == 1) {
+        ok = add_seed(seeds, vertex);
+    }
+
+    ok = ok && feof(in);
+    fclose(in);
+    return ok;
+}
+
+// Returns the size of the largest component given its labels.
+static unsigned int largest_component(const unsigned int * labels, unsigned int vertex_count) {
+    unsigned int * sizes = calloc((size_t)vertex_count + 1, sizeof(unsigned int));
+    unsigned int largest = 0;
+
+    if (sizes == NULL) {
+        return 0;
+    }
+
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        sizes[labels[v]] += 1;
+        if (sizes[labels[v]] > largest) {
+            largest = sizes[labels[v]];
+        }
+    }
+
+    free(sizes);
+    return largest;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s -g graph.mtx|graph.csr -a wcc|khop -o output.bin [-s seed,seed,...] "
+                    "[-S seed_file] [-k hops] [-t threads] [-n] [-j threads]\n", program);
+}
+
+int main(int argc, char ** argv) {
+    struct batch_options opts = {
+        .graph_path = NULL,
+        .job = NULL,
+        .output_path = NULL,
+        .seed_list = NULL,
+        .seed_path = NULL,
+        .hops = 2,
+        .threads = 0,
+        .load = {.use_cache = true, .threads = 0}
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:a:o:s:S:k:t:nj:h")) != -1) {
+        switch (opt) {
+        case 'g':
+            opts.graph_path = optarg;
+            break;
+        case 'a':
+            opts.job = optarg;
+            break;
+        case 'o':
+            opts.output_path = optarg;
+            break;
+        case 's':
+            opts.seed_list = optarg;
+            break;
+        case 'S':
+            opts.seed_path = optarg;
+            break;
+        case 'k':
+            opts.hops = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 't':
+            opts.threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'n':
+            opts.load.use_cache = false;
+            break;
+        case 'j':
+            opts.load.threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    bool wcc = opts.job != NULL && strcmp(opts.job, "wcc") == 0;
+    bool khop = opts.job != NULL && strcmp(opts.job, "khop") == 0;
+    struct seeds seeds = {NULL, 0, 0};
+
+    if (opts.graph_path == NULL || opts.output_path == NULL || (!wcc && !khop) ||
+        (opts.seed_list != NULL && !parse_seed_list(opts.seed_list, &seeds)) ||
+        (opts.seed_path != NULL && !read_seed_file(opts.seed_path, &seeds)) ||
+        (khop && seeds.count == 0)) {
+        usage(argv[0]);
+        free(seeds.vertices);
+        return 2;
+    }
+
+    uint64_t load_start = bench_now_ns();
+    struct graph * graph = graph_load(opts.graph_path, &opts.load);
+
+    if (graph == NULL) {
+        free(seeds.vertices);
+        return 1;
+    }
+
+    uint64_t load_ns = bench_now_ns() - load_start;
+    unsigned int * result = graph_analytics_map_output(opts.output_path, graph->vertex_count);
+
+    if (result == NULL) {
+        perror(opts.output_path);
+        graph_delete(graph);
+        free(seeds.vertices);
+        return 1;
+    }
+
+    struct graph_analytics_stats stats;
+    uint64_t start = bench_now_ns();
+    bool ok = wcc ? graph_analytics_wcc(graph, opts.threads, result, &stats) :
+                    graph_analytics_k_hop(graph, opts.threads, seeds.vertices, seeds.count, opts.hops,
+                                          result, &stats);
+    uint64_t job_ns = bench_now_ns() - start;
+
+    if (!ok) {
+        fprintf(stderr, "%s failed (seed out of range or out of memory)\n", opts.job);
+    } else if (wcc) {
+        printf("wcc vertices %u edges %llu components %llu largest %u threads %u load_s %.3f job_s %.3f\n",
+               graph->vertex_count, (unsigned long long)graph->edge_count, (unsigned long long)stats.count,
+               largest_component(result, graph->vertex_count), stats.threads,
+               (double)load_ns / 1e9, (double)job_ns / 1e9);
+    } else {
+        printf("khop vertices %u edges %llu seeds %zu hops %u reached %llu levels %u edges_traversed %llu "
+               "threads %u load_s %.3f job_s %.3f\n",
+               graph->vertex_count, (unsigned long long)graph->edge_count, seeds.count, opts.hops,
+               (unsigned long long)stats.count, stats.levels, (unsigned long long)stats.edges_traversed,
+               stats.threads, (double)load_ns / 1e9, (double)job_ns / 1e9);
+    }
+
+    graph_analytics_unmap_output(result, graph->vertex_count);
+    graph_delete(graph);
+    free(seeds.vertices);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,300 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bench.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Both of these are normally passed in by the Makefile so that every
+// record identifies the build it came from.
+//
+#ifndef BENCH_GIT_REVISION
+#define BENCH_GIT_REVISION "unknown"
+#endif
+
+#ifndef BENCH_COMPILER_FLAGS
+#define BENCH_COMPILER_FLAGS "unknown"
+#endif
+
+// qsort() comparison function for doubles.
+static int __bench_compare_doubles(const void * a, const void * b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Sorts the samples if they have been modified since the last sort.
+static void __bench_samples_sort(struct bench_samples * samples) {
+    if (!samples->sorted) {
+        qsort(samples->ns, samples->count, sizeof(double), __bench_compare_doubles);
+        samples->sorted = true;
+    }
+}
+
+// Writes a string as a JSON string literal, escaping as required.
+static void __bench_emit_json_string(FILE * out, const char * str) {
+    fputc('"', out);
+
+    for (const char * c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+            fputc(*c, out);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(out, "\\u%04x", (unsigned char)*c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+
+    fputc('"', out);
+}
+
+// Returns the current value of a monotonic clock in nanoseconds.
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Initializes a sample buffer.
+bool bench_samples_init(struct bench_samples * samples, size_t capacity) {
+
+    if (samples == NULL) {
+        return false;
+    }
+
+    if (capacity == 0) {
+        capacity = 16;
+    }
+
+    samples->ns = (double *)malloc(capacity * sizeof(double));
+    samples->count = 0;
+    samples->capacity = (samples->ns == NULL) ? 0 : capacity;
+    samples->sorted = true;
+
+    return samples->ns != NULL;
+}
+
+// Appends a sample, doubling the buffer when it is full.
+bool bench_samples_add(struct bench_samples * samples, double ns) {
+
+    if (samples == NULL) {
+        return false;
+    }
+
+    if (samples->count == samples->capacity) {
+        size_t new_capacity = samples->capacity == 0 ? 16 : samples->capacity * 2;
+        double * new_ns = (double *)realloc(samples->ns, new_capacity * sizeof(double));
+
+        if (new_ns == NULL) {
+            return false;
+        }
+
+        samples->ns = new_ns;
+        samples->capacity = new_capacity;
+    }
+
+    samples->ns[samples->count] = ns;
+    samples->count += 1;
+    samples->sorted = false;
+
+    return true;
+}
+
+// Discards all samples but keeps the allocation.
+void bench_samples_reset(struct bench_samples * samples) {
+    samples->count = 0;
+    samples->sorted = true;
+}
+
+// Frees the storage owned by a sample buffer.
+void bench_samples_free(struct bench_samples * samples) {
+
+    if (samples == NULL) {
+        return;
+    }
+
+    free(samples->ns);
+    samples->ns = NULL;
+    samples->count = 0;
+    samples->capacity = 0;
+}
+
+// Returns the p-th percentile using linear interpolation between closest ranks.
+double bench_samples_percentile(struct bench_samples * samples, double p) {
+
+    if (samples == NULL || samples->count == 0) {
+        return 0.0;
+    }
+
+    __bench_samples_sort(samples);
+
+    if (p <= 0.0) {
+        return samples->ns[0];
+    } else if (p >= 100.0) {
+        return samples->ns[samples->count - 1];
+    }
+
+    double rank = (p / 100.0) * (double)(samples->count - 1);
+    size_t lower = (size_t)rank;
+    double fraction = rank - (double)lower;
+
+    if (lower + 1 >= samples->count) {
+        return samples->ns[lower];
+    }
+
+    return samples->ns[lower] + fraction * (samples->ns[lower + 1] - samples->ns[lower]);
+}
+
+// Computes min/percentiles/max/mean/stddev of the samples.
+void bench_samples_summarize(struct bench_samples * samples,
+                             struct bench_summary * summary) {
+
+    memset(summary, 0, sizeof(*summary));
+
+    if (samples == NULL || samples->count == 0) {
+        return;
+    }
+
+    double sum = 0.0;
+    for (size_t i = 0; i < samples->count; i++) {
+        sum += samples->ns[i];
+    }
+
+    double mean = sum / (double)samples->count;
+    double squares = 0.0;
+    for (size_t i = 0; i < samples->count; i++) {
+        double delta = samples->ns[i] - mean;
+        squares += delta * delta;
+    }
+
+    summary->samples = samples->count;
+    summary->mean = mean;
+    summary->stddev = (samples->count > 1) ? sqrt(squares / (double)(samples->count - 1)) : 0.0;
+    summary->min = bench_samples_percentile(samples, 0.0);
+    summary->p50 = bench_samples_percentile(samples, 50.0);
+    summary->p90 = bench_samples_percentile(samples, 90.0);
+    summary->p99 = bench_samples_percentile(samples, 99.0);
+    summary->max = bench_samples_percentile(samples, 100.0);
+}
+
+// Initializes a record for an operation at a given size.
+void bench_record_init(struct bench_record * record,
+                       const char * benchmark,
+                       const char * operation,
+                       size_t size) {
+
+    memset(record, 0, sizeof(*record));
+    record->benchmark = benchmark;
+    record->operation = operation;
+    record->size = size;
+}
+
+// Attaches a counter to a record.
+void bench_record_add_counter(struct bench_record * record,
+                              const char * name,
+                              double value) {
+
+    if (record->counter_count == BENCH_MAX_COUNTERS) {
+        return;
+    }
+
+    record->counters[record->counter_count].name = name;
+    record->counters[record->counter_count].value = value;
+    record->counter_count += 1;
+}
+
+// Writes a record as a single line JSON object.
+static void __bench_record_emit_json(FILE * out, const struct bench_record * record) {
+    const struct bench_summary * s = &record->summary;
+
+    fputs("{\"benchmark\":", out);
+    __bench_emit_json_string(out, record->benchmark);
+    fputs(",\"operation\":", out);
+    __bench_emit_json_string(out, record->operation);
+    fprintf(out, ",\"size\":%zu", record->size);
+    fprintf(out, ",\"samples\":%zu", s->samples);
+    fprintf(out, ",\"ns_per_op\":{\"min\":%.3f,\"p50\":%.3f,\"p90\":%.3f,"
+                 "\"p99\":%.3f,\"max\":%.3f,\"mean\":%.3f,\"stddev\":%.3f}",
+            s->min, s->p50, s->p90, s->p99, s->max, s->mean, s->stddev);
+
+    fputs(",\"counters\":{", out);
+    for (size_t i = 0; i < record->counter_count; i++) {
+        if (i != 0) {
+            fputc(',', out);
+        }
+        __bench_emit_json_string(out, record->counters[i].name);
+        fprintf(out, ":%.6g", record->counters[i].value);
+    }
+    fputc('}', out);
+
+    fputs(",\"git_revision\":", out);
+    __bench_emit_json_string(out, bench_git_revision());
+    fputs(",\"compiler_flags\":", out);
+    __bench_emit_json_string(out, bench_compiler_flags());
+    fputs("}\n", out);
+}
+
+// Writes a record as a single human readable line.
+static void __bench_record_emit_text(FILE * out, const struct bench_record * record) {
+    const struct bench_summary * s = &record->summary;
+
+    fprintf(out, "%-14s %-32s size %-10zu p50 %10.2f ns/op  p90 %10.2f  p99 %10.2f",
+            record->benchmark, record->operation, record->size, s->p50, s->p90, s->p99);
+
+    for (size_t i = 0; i < record->counter_count; i++) {
+        fprintf(out, "  %s %.4g", record->counters[i].name, record->counters[i].value);
+    }
+
+    fputc('\n', out);
+}
+
+// Writes a record in the requested format.
+void bench_record_emit(FILE * out,
+                       enum bench_format format,
+                       const struct bench_record * record) {
+
+    if (format == BENCH_FORMAT_JSON) {
+        __bench_record_emit_json(out, record);
+    } else {
+        __bench_record_emit_text(out, record);
+    }
+
+    fflush(out);
+}
+
+// Returns the git revision the benchmark was built from.
+const char * bench_git_revision(void) {
+    return BENCH_GIT_REVISION;
+}
+
+// Returns the compiler flags the benchmark was built with.
+const char * bench_compiler_flags(void) {
+    return BENCH_COMPILER_FLAGS;
+}
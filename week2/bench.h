@@ -0,0 +1,168 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Shared support for the benchmark drivers: a monotonic clock, a
+// sample buffer with percentile summaries, and result records that
+// can be printed either as human readable text or as one JSON object
+// per line (see bench_compare.c for the consumer of the latter).
+
+#define BENCH_MAX_COUNTERS 16
+
+// Output format selected on the command line of each driver.
+//
+enum bench_format {
+    BENCH_FORMAT_TEXT,
+    BENCH_FORMAT_JSON
+};
+
+// A growable buffer of per-sample nanoseconds-per-operation values.
+//
+struct bench_samples {
+    double * ns;
+    size_t count;
+    size_t capacity;
+    bool sorted;
+};
+
+// Summary statistics over a bench_samples buffer.
+//
+struct bench_summary {
+    size_t samples;
+    double min;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+    double mean;
+    double stddev;
+};
+
+// A named counter attached to a record, e.g. cache-misses per operation.
+//
+struct bench_counter {
+    const char * name;
+    double value;
+};
+
+// One benchmark result: an operation measured at a given size.
+//
+struct bench_record {
+    const char * benchmark;
+    const char * operation;
+    size_t size;
+    struct bench_summary summary;
+    struct bench_counter counters[BENCH_MAX_COUNTERS];
+    size_t counter_count;
+};
+
+// Returns the current value of a monotonic clock in nanoseconds.
+//
+uint64_t bench_now_ns(void);
+
+// Initializes a sample buffer.
+// \param samples  : Pointer to sample buffer.
+// \param capacity : Initial number of samples to reserve.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool bench_samples_init(struct bench_samples * samples, size_t capacity);
+
+// Appends a sample, growing the buffer if needed.
+// \param samples : Pointer to sample buffer.
+// \param ns      : Nanoseconds per operation for this sample.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool bench_samples_add(struct bench_samples * samples, double ns);
+
+// Discards all samples but keeps the allocation.
+// \param samples : Pointer to sample buffer.
+//
+void bench_samples_reset(struct bench_samples * samples);
+
+// Frees the storage owned by a sample buffer.
+// \param samples : Pointer to sample buffer.
+//
+void bench_samples_free(struct bench_samples * samples);
+
+// Returns the p-th percentile (0.0 - 100.0) of the samples, using
+// linear interpolation between closest ranks. Sorts the buffer.
+// \param samples : Pointer to sample buffer.
+// \param p       : Percentile to compute.
+// Returns the percentile, 0.0 if there are no samples.
+//
+double bench_samples_percentile(struct bench_samples * samples, double p);
+
+// Computes min/percentiles/max/mean/stddev of the samples.
+// \param samples : Pointer to sample buffer.
+// \param summary : Pointer to summary (provided by caller) to fill in.
+//
+void bench_samples_summarize(struct bench_samples * samples,
+                             struct bench_summary * summary);
+
+// Initializes a record for an operation at a given size.
+// \param record    : Pointer to record (provided by caller).
+// \param benchmark : Name of the benchmark driver.
+// \param operation : Name of the operation measured.
+// \param size      : Problem size (elements, vertices, ...).
+//
+void bench_record_init(struct bench_record * record,
+                       const char * benchmark,
+                       const char * operation,
+                       size_t size);
+
+// Attaches a counter to a record. Silently ignored once
+// BENCH_MAX_COUNTERS counters are present.
+// \param record : Pointer to record.
+// \param name   : Counter name, must outlive the record.
+// \param value  : Counter value.
+//
+void bench_record_add_counter(struct bench_record * record,
+                              const char * name,
+                              double value);
+
+// Writes a record in the requested format.
+// \param out    : Stream to write to.
+// \param format : BENCH_FORMAT_TEXT or BENCH_FORMAT_JSON.
+// \param record : Record to write.
+//
+void bench_record_emit(FILE * out,
+                       enum bench_format format,
+                       const struct bench_record * record);
+
+// Returns the git revision the benchmark was built from.
+//
+const char * bench_git_revision(void);
+
+// Returns the compiler flags the benchmark was built with.
+//
+const char * bench_compiler_flags(void);
+
+#endif
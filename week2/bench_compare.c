@@ -0,0 +1,460 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Compares two files of JSON benchmark records (as written by the
+// benchmark drivers with -f json) and exits non-zero when a result in
+// the new file is slower than the baseline by more than a threshold.
+//
+// A difference only counts as a regression when it is both larger than
+// the relative threshold and statistically distinguishable from noise.
+// The threshold applies to the -m metric (p50 by default), but records
+// only carry the mean and stddev of their samples, so significance is
+// always judged on the mean: the Welch t statistic of the two sample
+// sets has to exceed -z, with the mean moving the same way as the
+// metric. A p50 that regresses while the mean does not, or improves, is
+// reported as noise.
+//
+// Usage: bench_compare [-t percent] [-z t_stat] [-m metric] baseline.json new.json
+// Exit status: 0 no regressions, 1 regressions found, 2 usage or input error.
+
+#define NAME_LENGTH 128
+
+struct compare_entry {
+    char benchmark[NAME_LENGTH];
+    char operation[NAME_LENGTH];
+    char git_revision[NAME_LENGTH];
+    size_t size;
+    size_t samples;
+    double metric;
+    double mean;
+    double stddev;
+    bool matched;
+};
+
+struct compare_file {
+    struct compare_entry * entries;
+    size_t count;
+    size_t capacity;
+};
+
+struct compare_options {
+    double threshold_percent;
+    double min_t_statistic;
+    const char * metric;
+};
+
+// Parser state for a single line of JSON.
+struct json_parser {
+    const char * p;
+    const struct compare_options * opts;
+    struct compare_entry * entry;
+};
+
+static void skip_whitespace(struct json_parser * jp) {
+    while (isspace((unsigned char)*jp->p)) {
+        jp->p++;
+    }
+}
+
+// Parses a JSON string into buf, truncating if needed.
+static bool parse_string(struct json_parser * jp, char * buf, size_t length) {
+    size_t used = 0;
+
+    if (*jp->p != '"') {
+        return false;
+    }
+    jp->p++;
+
+    while (*jp->p != '"') {
+        char c = *jp->p;
+
+        if (c == '\0') {
+            return false;
+        } else if (c == '\\') {
+            jp->p++;
+            c = *jp->p;
+            if (c == 'u') {
+                // Control characters only, never produced in names we key on.
+                for (int i = 0; i < 4 && jp->p[1] != '\0'; i++) {
+                    jp->p++;
+                }
+                c = '?';
+            } else if (c == 'n') {
+                c = '\n';
+            } else if (c == 't') {
+                c = '\t';
+            } else if (c == '\0') {
+                return false;
+            }
+        }
+
+        if (used + 1 < length) {
+            buf[used++] = c;
+        }
+        jp->p++;
+    }
+
+    buf[used] = '\0';
+    jp->p++;
+    return true;
+}
+
+// Stores a scalar value found at a (flattened) key into the entry.
+static void store_number(struct json_parser * jp, const char * key, double value) {
+    struct compare_entry * e = jp->entry;
+    char metric_key[NAME_LENGTH];
+
+    snprintf(metric_key, sizeof(metric_key), "ns_per_op.%s", jp->opts->metric);
+
+    if (strcmp(key, "size") == 0) {
+        e->size = (size_t)value;
+    } else if (strcmp(key, "samples") == 0) {
+        e->samples = (size_t)value;
+    } else if (strcmp(key, "ns_per_op.mean") == 0) {
+        e->mean = value;
+    } else if (strcmp(key, "ns_per_op.stddev") == 0) {
+        e->stddev = value;
+    }
+
+    if (strcmp(key, metric_key) == 0) {
+        e->metric = value;
+    }
+}
+
+static void store_string(struct json_parser * jp, const char * key, const char * value) {
+    struct compare_entry * e = jp->entry;
+
+    if (strcmp(key, "benchmark") == 0) {
+        snprintf(e->benchmark, sizeof(e->benchmark), "%s", value);
+    } else if (strcmp(key, "operation") == 0) {
+        snprintf(e->operation, sizeof(e->operation), "%s", value);
+    } else if (strcmp(key, "git_revision") == 0) {
+        snprintf(e->git_revision, sizeof(e->git_revision), "%s", value);
+    }
+}
+
+static bool parse_value(struct json_parser * jp, const char * key);
+
+// Parses an object, flattening nested keys as "outer.inner".
+static bool parse_object(struct json_parser * jp, const char * prefix) {
+    char name[NAME_LENGTH];
+    char key[2 * NAME_LENGTH];
+
+    jp->p++;
+    skip_whitespace(jp);
+
+    if (*jp->p == '}') {
+        jp->p++;
+        return true;
+    }
+
+    while (true) {
+        skip_whitespace(jp);
+        if (!parse_string(jp, name, sizeof(name))) {
+            return false;
+        }
+
+        skip_whitespace(jp);
+        if (*jp->p != ':') {
+            return false;
+        }
+        jp->p++;
+        skip_whitespace(jp);
+
+        if (prefix[0] == '\0') {
+            snprintf(key, sizeof(key), "%s", name);
+        } else {
+            snprintf(key, sizeof(key), "%s.%s", prefix, name);
+        }
+
+        if (!parse_value(jp, key)) {
+            return false;
+        }
+
+        skip_whitespace(jp);
+        if (*jp->p == ',') {
+            jp->p++;
+        } else if (*jp->p == '}') {
+            jp->p++;
+            return true;
+        } else {
+            return false;
+        }
+    }
+}
+
+// Parses any JSON value. Arrays are accepted but their contents ignored.
+static bool parse_value(struct json_parser * jp, const char * key) {
+    char buf[NAME_LENGTH];
+
+    if (*jp->p == '{') {
+        return parse_object(jp, key);
+    } else if (*jp->p == '"') {
+        if (!parse_string(jp, buf, sizeof(buf))) {
+            return false;
+        }
+        store_string(jp, key, buf);
+        return true;
+    } else if (*jp->p == '[') {
+        jp->p++;
+        skip_whitespace(jp);
+        while (*jp->p != ']') {
+            if (!parse_value(jp, "")) {
+                return false;
+            }
+            skip_whitespace(jp);
+            if (*jp->p == ',') {
+                jp->p++;
+                skip_whitespace(jp);
+            }
+        }
+        jp->p++;
+        return true;
+    } else if (strncmp(jp->p, "true", 4) == 0 || strncmp(jp->p, "null", 4) == 0) {
+        jp->p += 4;
+        return true;
+    } else if (strncmp(jp->p, "false", 5) == 0) {
+        jp->p += 5;
+        return true;
+    }
+
+    char * end = NULL;
+    double value = strtod(jp->p, &end);
+    if (end == jp->p) {
+        return false;
+    }
+    jp->p = end;
+    store_number(jp, key, value);
+    return true;
+}
+
+// Reads every record in a JSON lines file.
+static bool load_file(const char * path,
+                      const struct compare_options * opts,
+                      struct compare_file * file) {
+    FILE * in = fopen(path, "r");
+    char * line = NULL;
+    size_t line_capacity = 0;
+    size_t line_number = 0;
+    bool ok = true;
+
+    if (in == NULL) {
+        perror(path);
+        return false;
+    }
+
+    while (getline(&line, &line_capacity, in) != -1) {
+        line_number += 1;
+
+        struct json_parser jp = {.p = line, .opts = opts, .entry = NULL};
+        skip_whitespace(&jp);
+        if (*jp.p == '\0') {
+            continue;
+        }
+
+        if (file->count == file->capacity) {
+            size_t new_capacity = file->capacity == 0 ? 64 : file->capacity * 2;
+            struct compare_entry * entries =
+                realloc(file->entries, new_capacity * sizeof(struct compare_entry));
+            if (entries == NULL) {
+                ok = false;
+                break;
+            }
+            file->entries = entries;
+            file->capacity = new_capacity;
+        }
+
+        jp.entry = &file->entries[file->count];
+        memset(jp.entry, 0, sizeof(*jp.entry));
+        jp.entry->metric = NAN;
+
+        if (*jp.p != '{' || !parse_object(&jp, "")) {
+            fprintf(stderr, "%s:%zu: malformed record\n", path, line_number);
+            ok = false;
+            break;
+        }
+
+        if (isnan(jp.entry->metric)) {
+            fprintf(stderr, "%s:%zu: record has no ns_per_op.%s\n",
+                    path, line_number, opts->metric);
+            ok = false;
+            break;
+        }
+
+        file->count += 1;
+    }
+
+    free(line);
+    fclose(in);
+    return ok;
+}
+
+static struct compare_entry * find_entry(struct compare_file * file,
+                                         const struct compare_entry * key) {
+    for (size_t i = 0; i < file->count; i++) {
+        struct compare_entry * e = &file->entries[i];
+
+        if (e->size == key->size &&
+            strcmp(e->benchmark, key->benchmark) == 0 &&
+            strcmp(e->operation, key->operation) == 0) {
+            return e;
+        }
+    }
+
+    return NULL;
+}
+
+// Welch's t statistic for the difference in means, 0 if it cannot be computed.
+static double welch_t(const struct compare_entry * a, const struct compare_entry * b) {
+    if (a->samples < 2 || b->samples < 2) {
+        return 0.0;
+    }
+
+    double se = sqrt((a->stddev * a->stddev) / (double)a->samples +
+                     (b->stddev * b->stddev) / (double)b->samples);
+
+    if (se == 0.0) {
+        if (b->mean == a->mean) {
+            return 0.0;
+        }
+        return (b->mean > a->mean) ? INFINITY : -INFINITY;
+    }
+
+    return (b->mean - a->mean) / se;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s [-t percent] [-z t_stat] [-m min|p50|p90|p99|max|mean] "
+                    "baseline.json new.json\n"
+                    "  -t applies to the -m metric; -z is a Welch t test on the mean\n", program);
+}
+
+int main(int argc, char ** argv) {
+    struct compare_options opts = {
+        .threshold_percent = 5.0,
+        .min_t_statistic = 3.0,
+        .metric = "p50"
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:z:m:h")) != -1) {
+        switch (opt) {
+        case 't':
+            opts.threshold_percent = strtod(optarg, NULL);
+            break;
+        case 'z':
+            opts.min_t_statistic = strtod(optarg, NULL);
+            break;
+        case 'm':
+            opts.metric = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (argc - optind != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct compare_file baseline = {0};
+    struct compare_file current = {0};
+
+    if (!load_file(argv[optind], &opts, &baseline) ||
+        !load_file(argv[optind + 1], &opts, &current)) {
+        free(baseline.entries);
+        free(current.entries);
+        return 2;
+    }
+
+    size_t regressions = 0;
+    size_t improvements = 0;
+
+    printf("%-16s %-28s %10s %12s %12s %9s %8s  %s\n",
+           "benchmark", "operation", "size", "baseline", "new", "change", "t(mean)", "verdict");
+
+    for (size_t i = 0; i < current.count; i++) {
+        struct compare_entry * now = &current.entries[i];
+        struct compare_entry * base = find_entry(&baseline, now);
+
+        if (base == NULL) {
+            printf("%-16s %-28s %10zu %12s %12.2f %9s %8s  new\n",
+                   now->benchmark, now->operation, now->size, "-", now->metric, "-", "-");
+            continue;
+        }
+
+        base->matched = true;
+
+        double change = (base->metric == 0.0) ? 0.0 :
+                        100.0 * (now->metric - base->metric) / base->metric;
+        double t = welch_t(base, now);
+        bool significant = (base->samples < 2 || now->samples < 2) ||
+                           (fabs(t) >= opts.min_t_statistic && (t > 0.0) == (change > 0.0));
+        const char * verdict = "unchanged";
+
+        if (fabs(change) > opts.threshold_percent) {
+            if (!significant) {
+                verdict = "noise";
+            } else if (change > 0.0) {
+                verdict = "REGRESSION";
+                regressions += 1;
+            } else {
+                verdict = "improved";
+                improvements += 1;
+            }
+        }
+
+        printf("%-16s %-28s %10zu %12.2f %12.2f %+8.1f%% %8.2f  %s\n",
+               now->benchmark, now->operation, now->size,
+               base->metric, now->metric, change, t, verdict);
+    }
+
+    for (size_t i = 0; i < baseline.count; i++) {
+        struct compare_entry * base = &baseline.entries[i];
+
+        if (!base->matched) {
+            printf("%-16s %-28s %10zu %12.2f %12s %9s %8s  missing\n",
+                   base->benchmark, base->operation, base->size, base->metric, "-", "-", "-");
+        }
+    }
+
+    printf("\n%zu regression(s), %zu improvement(s) beyond %.1f%% on ns/op %s, "
+           "significant at |t| >= %.1f on the mean\n",
+           regressions, improvements, opts.threshold_percent, opts.metric, opts.min_t_statistic);
+
+    free(baseline.entries);
+    free(current.entries);
+
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,1203 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bfs.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "queue.h"
+#include "radix_heap.h"
+
+#define BITS_PER_WORD 64
+
+// Sets a bit, returns whether it was already set.
+static inline bool __bfs_test_and_set(uint64_t * bitmap, unsigned int vertex) {
+    uint64_t mask = 1ull << (vertex % BITS_PER_WORD);
+    uint64_t * word = &bitmap[vertex / BITS_PER_WORD];
+    bool was_set = (*word & mask) != 0;
+
+    *word |= mask;
+    return was_set;
+}
+
+// Answers whether there is a path from source to target.
+bool bfs_path_exists(const struct graph * graph,
+                     unsigned int source,
+                     unsigned int target,
+                     struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    // The queue keeps the visited set: a vertex is pushed at most once.
+    //
+    struct queue * queue = queue_create_with_visited(graph->vertex_count);
+
+    if (queue == NULL) {
+        return false;
+    }
+
+    queue_push_if_new(queue, source);
+    stats->vertices_visited = 1;
+
+    bool found = false;
+    unsigned int depth = 0;
+
+    // Expand one level at a time so that the distance is known when the
+    // target is discovered: the level is whatever is queued at its start.
+    //
+    while (!found && queue_has_next(queue)) {
+        size_t level_size = queue_size(queue);
+        depth += 1;
+
+        if (level_size > stats->peak_queue_size) {
+            stats->peak_queue_size = level_size;
+        }
+
+        for (size_t i = 0; i < level_size && !found; i++) {
+            unsigned int vertex = 0;
+            queue_pop(queue, &vertex);
+
+            uint64_t end = graph->offsets[vertex + 1];
+            for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                stats->edges_traversed += 1;
+
+                if (!queue_push_if_new(queue, neighbor)) {
+                    continue;
+                }
+
+                stats->vertices_visited += 1;
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        size_t queued = queue_size(queue);
+        if (queued > stats->peak_queue_size) {
+            stats->peak_queue_size = queued;
+        }
+    }
+
+    if (found) {
+        stats->distance = depth;
+    }
+
+    queue_delete(queue);
+    return found;
+}
+
+// Returns whether a bit is set.
+static inline bool __bfs_test(const uint64_t * bitmap, unsigned int vertex) {
+    return (bitmap[vertex / BITS_PER_WORD] >> (vertex % BITS_PER_WORD)) & 1;
+}
+
+// One top-down level: pops the current level off the queue and pushes
+// every newly visited out-neighbor. Returns whether target was found.
+// The size of the new level and the sum of its out-degrees are written
+// to *frontier_size and *frontier_edges.
+static bool __bfs_top_down_level(const struct graph * graph,
+                                 struct queue * queue,
+                                 uint64_t * visited,
+                                 unsigned int target,
+                                 struct bfs_stats * stats,
+                                 size_t * frontier_size,
+                                 uint64_t * frontier_edges) {
+    size_t level_size = queue_size(queue);
+
+    *frontier_size = 0;
+    *frontier_edges = 0;
+
+    for (size_t i = 0; i < level_size; i++) {
+        unsigned int vertex = 0;
+        queue_pop(queue, &vertex);
+
+        uint64_t end = graph->offsets[vertex + 1];
+        for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+            unsigned int neighbor = graph->neighbors[e];
+            stats->edges_traversed += 1;
+
+            if (__bfs_test_and_set(visited, neighbor)) {
+                continue;
+            }
+
+            stats->vertices_visited += 1;
+            if (neighbor == target) {
+                return true;
+            }
+
+            queue_push(queue, neighbor);
+            *frontier_size += 1;
+            *frontier_edges += graph_degree(graph, neighbor);
+        }
+    }
+
+    return false;
+}
+
+// One bottom-up level: every unvisited vertex looks for an in-neighbor
+// in the frontier bitmap, stopping at the first. New vertices are set
+// in next. Returns whether target was found.
+static bool __bfs_bottom_up_level(const struct graph * graph,
+                                  uint64_t * visited,
+                                  const uint64_t * frontier,
+                                  uint64_t * next,
+                                  size_t words,
+                                  unsigned int target,
+                                  struct bfs_stats * stats,
+                                  size_t * frontier_size,
+                                  uint64_t * frontier_edges) {
+    const struct graph * transpose = graph->transpose;
+
+    memset(next, 0, words * sizeof(uint64_t));
+    *frontier_size = 0;
+    *frontier_edges = 0;
+
+    for (size_t w = 0; w < words; w++) {
+        uint64_t unvisited = ~visited[w];
+
+        // Bits past the last vertex are never visited.
+        //
+        if (w == words - 1 && graph->vertex_count % BITS_PER_WORD != 0) {
+            unvisited &= (1ull << (graph->vertex_count % BITS_PER_WORD)) - 1;
+        }
+
+        while (unvisited != 0) {
+            unsigned int vertex = (unsigned int)(w * BITS_PER_WORD) + (unsigned int)__builtin_ctzll(unvisited);
+            unvisited &= unvisited - 1;
+
+            uint64_t end = transpose->offsets[vertex + 1];
+            for (uint64_t e = transpose->offsets[vertex]; e < end; e++) {
+                stats->edges_traversed += 1;
+
+                if (!__bfs_test(frontier, transpose->neighbors[e])) {
+                    continue;
+                }
+
+                __bfs_test_and_set(visited, vertex);
+                __bfs_test_and_set(next, vertex);
+                stats->vertices_visited += 1;
+                if (vertex == target) {
+                    return true;
+                }
+
+                *frontier_size += 1;
+                *frontier_edges += graph_degree(graph, vertex);
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Answers whether there is a path from source to target, switching
+// search direction level by level.
+bool bfs_direction_optimizing_path_exists(const struct graph * graph,
+                                          unsigned int source,
+                                          unsigned int target,
+                                          struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || graph->transpose == NULL ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    size_t words = ((size_t)graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    uint64_t * visited = (uint64_t *)calloc(words, sizeof(uint64_t));
+    uint64_t * frontier = (uint64_t *)calloc(words, sizeof(uint64_t));
+    uint64_t * next = (uint64_t *)calloc(words, sizeof(uint64_t));
+    struct queue * queue = queue_create();
+
+    if (visited == NULL || frontier == NULL || next == NULL || queue == NULL) {
+        free(visited);
+        free(frontier);
+        free(next);
+        queue_delete(queue);
+        return false;
+    }
+
+    __bfs_test_and_set(visited, source);
+    queue_push(queue, source);
+    stats->vertices_visited = 1;
+
+    size_t frontier_size = 1;
+    uint64_t frontier_edges = graph_degree(graph, source);
+    uint64_t unexplored_edges = graph->edge_count - frontier_edges;
+    bool bottom_up = false;
+    bool growing = true;
+    bool found = false;
+    unsigned int depth = 0;
+
+    while (!found && frontier_size != 0) {
+        size_t previous_size = frontier_size;
+        depth += 1;
+
+        if (frontier_size > stats->peak_queue_size) {
+            stats->peak_queue_size = frontier_size;
+        }
+
+        // Move the frontier between the queue and the bitmap when the
+        // direction changes.
+        //
+        if (!bottom_up && frontier_edges > unexplored_edges / BFS_DIRECTION_ALPHA) {
+            unsigned int vertex = 0;
+
+            memset(frontier, 0, words * sizeof(uint64_t));
+            while (queue_pop(queue, &vertex)) {
+                __bfs_test_and_set(frontier, vertex);
+            }
+            bottom_up = true;
+        } else if (bottom_up && !growing && frontier_size < graph->vertex_count / BFS_DIRECTION_BETA) {
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = frontier[w]; bits != 0; bits &= bits - 1) {
+                    queue_push(queue, (unsigned int)(w * BITS_PER_WORD) + (unsigned int)__builtin_ctzll(bits));
+                }
+            }
+            bottom_up = false;
+        }
+
+        if (bottom_up) {
+            found = __bfs_bottom_up_level(graph, visited, frontier, next, words, target, stats,
+                                          &frontier_size, &frontier_edges);
+            uint64_t * swap = frontier;
+            frontier = next;
+            next = swap;
+            stats->bottom_up_levels += 1;
+        } else {
+            found = __bfs_top_down_level(graph, queue, visited, target, stats,
+                                         &frontier_size, &frontier_edges);
+        }
+
+        unexplored_edges -= (frontier_edges < unexplored_edges) ? frontier_edges : unexplored_edges;
+        growing = frontier_size > previous_size;
+    }
+
+    if (found) {
+        stats->distance = depth;
+    }
+
+    queue_delete(queue);
+    free(visited);
+    free(frontier);
+    free(next);
+    return found;
+}
+
+// One side of a bidirectional search.
+struct bfs_side {
+    const struct graph * graph;
+    struct queue * queue;
+    uint64_t * visited;
+    unsigned int depth;
+};
+
+// Expands one whole level of a side. Returns whether it met the other
+// side.
+static bool __bfs_bidirectional_level(struct bfs_side * side,
+                                      const struct bfs_side * other,
+                                      struct bfs_stats * stats) {
+    const struct graph * graph = side->graph;
+    size_t level_size = queue_size(side->queue);
+
+    for (size_t i = 0; i < level_size; i++) {
+        unsigned int vertex = 0;
+        queue_pop(side->queue, &vertex);
+
+        uint64_t end = graph->offsets[vertex + 1];
+        for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+            unsigned int neighbor = graph->neighbors[e];
+            stats->edges_traversed += 1;
+
+            if (__bfs_test(other->visited, neighbor)) {
+                return true;
+            }
+
+            if (__bfs_test_and_set(side->visited, neighbor)) {
+                continue;
+            }
+
+            stats->vertices_visited += 1;
+            queue_push(side->queue, neighbor);
+        }
+    }
+
+    return false;
+}
+
+// Answers whether there is a path from source to target, searching from
+// both ends.
+bool bfs_bidirectional_path_exists(const struct graph * graph,
+                                   unsigned int source,
+                                   unsigned int target,
+                                   struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || graph->transpose == NULL ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    size_t words = ((size_t)graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    struct bfs_side forward = {graph, queue_create(), (uint64_t *)calloc(words, sizeof(uint64_t)), 0};
+    struct bfs_side backward = {graph->transpose, queue_create(), (uint64_t *)calloc(words, sizeof(uint64_t)), 0};
+    bool found = false;
+
+    if (forward.queue != NULL && forward.visited != NULL &&
+        backward.queue != NULL && backward.visited != NULL) {
+
+        __bfs_test_and_set(forward.visited, source);
+        __bfs_test_and_set(backward.visited, target);
+        queue_push(forward.queue, source);
+        queue_push(backward.queue, target);
+        stats->vertices_visited = 2;
+
+        // Each side only ever completes whole levels, and the visited sets
+        // stay disjoint until they meet. So when expanding level d of one
+        // side finds a vertex the other side reached within D levels, no
+        // path is shorter than d + 1 + D, and this one is that long.
+        //
+        while (!found && queue_has_next(forward.queue) && queue_has_next(backward.queue)) {
+            size_t forward_size = queue_size(forward.queue);
+            size_t backward_size = queue_size(backward.queue);
+
+            if (forward_size + backward_size > stats->peak_queue_size) {
+                stats->peak_queue_size = forward_size + backward_size;
+            }
+
+            struct bfs_side * side = (forward_size <= backward_size) ? &forward : &backward;
+            struct bfs_side * other = (side == &forward) ? &backward : &forward;
+
+            found = __bfs_bidirectional_level(side, other, stats);
+            if (found) {
+                stats->distance = side->depth + 1 + other->depth;
+            }
+            side->depth += 1;
+        }
+    }
+
+    queue_delete(forward.queue);
+    queue_delete(backward.queue);
+    free(forward.visited);
+    free(backward.visited);
+    return found;
+}
+
+// Answers whether there is a path from source to target over a
+// compressed graph. Same level-by-level search as bfs_path_exists().
+bool bfs_compressed_path_exists(const struct graph_compressed * graph,
+                                unsigned int source,
+                                unsigned int target,
+                                struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    // The queue keeps the visited set: a vertex is pushed at most once.
+    //
+    struct queue * queue = queue_create_with_visited(graph->vertex_count);
+
+    if (queue == NULL) {
+        return false;
+    }
+
+    queue_push_if_new(queue, source);
+    stats->vertices_visited = 1;
+
+    bool found = false;
+    unsigned int depth = 0;
+
+    while (!found && queue_has_next(queue)) {
+        size_t level_size = queue_size(queue);
+        depth += 1;
+
+        if (level_size > stats->peak_queue_size) {
+            stats->peak_queue_size = level_size;
+        }
+
+        for (size_t i = 0; i < level_size && !found; i++) {
+            struct graph_compressed_cursor cursor;
+            unsigned int vertex = 0;
+            unsigned int neighbor = 0;
+            queue_pop(queue, &vertex);
+
+            graph_compressed_begin(graph, vertex, &cursor);
+            while (graph_compressed_next(&cursor, &neighbor)) {
+                stats->edges_traversed += 1;
+
+                if (!queue_push_if_new(queue, neighbor)) {
+                    continue;
+                }
+
+                stats->vertices_visited += 1;
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        size_t queued = queue_size(queue);
+        if (queued > stats->peak_queue_size) {
+            stats->peak_queue_size = queued;
+        }
+    }
+
+    if (found) {
+        stats->distance = depth;
+    }
+
+    queue_delete(queue);
+    return found;
+}
+
+// Answers a path query, pruned by the condensation of the graph.
+bool bfs_scc_path_exists(const struct graph_scc * scc,
+                         const struct graph * graph,
+                         unsigned int source,
+                         unsigned int target,
+                         struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (scc == NULL || graph == NULL || scc->vertex_count != graph->vertex_count ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    if (graph_scc_reachable(scc, source, target) == GRAPH_SCC_UNREACHABLE) {
+        return false;
+    }
+
+    struct queue * queue = queue_create_with_visited(graph->vertex_count);
+
+    if (queue == NULL) {
+        return false;
+    }
+
+    queue_push_if_new(queue, source);
+    stats->vertices_visited = 1;
+
+    unsigned int target_component = scc->components[target];
+    bool found = false;
+    unsigned int depth = 0;
+
+    while (!found && queue_has_next(queue)) {
+        size_t level_size = queue_size(queue);
+        depth += 1;
+
+        if (level_size > stats->peak_queue_size) {
+            stats->peak_queue_size = level_size;
+        }
+
+        for (size_t i = 0; i < level_size && !found; i++) {
+            unsigned int vertex = 0;
+            queue_pop(queue, &vertex);
+
+            uint64_t end = graph->offsets[vertex + 1];
+            for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                stats->edges_traversed += 1;
+
+                // Whatever cannot reach the target is not worth queueing.
+                //
+                if (!graph_scc_may_reach(scc, scc->components[neighbor], target_component) ||
+                    !queue_push_if_new(queue, neighbor)) {
+                    continue;
+                }
+
+                stats->vertices_visited += 1;
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        size_t queued = queue_size(queue);
+        if (queued > stats->peak_queue_size) {
+            stats->peak_queue_size = queued;
+        }
+    }
+
+    if (found) {
+        stats->distance = depth;
+    }
+
+    queue_delete(queue);
+    return found;
+}
+
+// Answers a path query within the bounds of a landmark index.
+bool bfs_landmarks_path_exists(const struct graph_landmarks * landmarks,
+                               const struct graph * graph,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (landmarks == NULL || graph == NULL || landmarks->vertex_count != graph->vertex_count ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    unsigned int lower = 0, upper = 0;
+
+    if (!graph_landmarks_bounds(landmarks, source, target, &lower, &upper)) {
+        return false;
+    }
+
+    if (lower == upper) {
+        stats->distance = upper;
+        return true;
+    }
+
+    struct queue * queue = queue_create_with_visited(graph->vertex_count);
+
+    if (queue == NULL) {
+        return false;
+    }
+
+    queue_push_if_new(queue, source);
+    stats->vertices_visited = 1;
+
+    const uint16_t * from_t = &landmarks->from[(size_t)target * landmarks->count];
+    const uint16_t * to_t = &landmarks->to[(size_t)target * landmarks->count];
+    bool found = false;
+    unsigned int depth = 0;
+
+    while (!found && queue_has_next(queue)) {
+        size_t level_size = queue_size(queue);
+        depth += 1;
+
+        if (level_size > stats->peak_queue_size) {
+            stats->peak_queue_size = level_size;
+        }
+
+        for (size_t i = 0; i < level_size && !found; i++) {
+            unsigned int vertex = 0;
+            queue_pop(queue, &vertex);
+
+            uint64_t end = graph->offsets[vertex + 1];
+            for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                stats->edges_traversed += 1;
+
+                if (neighbor == target) {
+                    stats->vertices_visited += 1;
+                    found = true;
+                    break;
+                }
+
+                if (queue_visited(queue, neighbor)) {
+                    continue;
+                }
+
+                // A vertex that cannot be on a path shorter than the
+                // upper bound is not worth queueing, and a bound of
+                // UINT32_MAX means it has no path at all. Met again
+                // deeper, it would fail again, so it is marked visited.
+                //
+                unsigned int bound = graph_landmarks_lower_bound(landmarks, neighbor, from_t, to_t);
+                if ((uint64_t)depth + bound >= upper) {
+                    queue_mark_visited(queue, neighbor);
+                    continue;
+                }
+
+                queue_push_if_new(queue, neighbor);
+                stats->vertices_visited += 1;
+            }
+        }
+
+        size_t queued = queue_size(queue);
+        if (queued > stats->peak_queue_size) {
+            stats->peak_queue_size = queued;
+        }
+    }
+
+    if (found) {
+        stats->distance = depth;
+    } else if (upper != UINT32_MAX) {
+        stats->distance = upper;
+        found = true;
+    }
+
+    queue_delete(queue);
+    return found;
+}
+
+// Finds the lightest path from source to target over 0/1 weights. A
+// vertex may be queued more than once, by a 0 edge after a 1 edge, so
+// settled vertices are skipped when popped again.
+bool bfs_0_1_path_exists(const struct graph * graph,
+                         const struct graph_weights * weights,
+                         unsigned int source,
+                         unsigned int target,
+                         struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || weights == NULL || weights->edge_count != graph->edge_count ||
+        weights->max_weight > 1 || source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    size_t words = ((size_t)graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    unsigned int * distances = (unsigned int *)malloc((size_t)graph->vertex_count * sizeof(unsigned int));
+    uint64_t * settled = (uint64_t *)calloc(words + 1, sizeof(uint64_t));
+    struct deque * deque = deque_create();
+    bool found = false;
+
+    if (distances == NULL || settled == NULL || deque == NULL) {
+        goto out;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        distances[v] = BFS_UNREACHABLE;
+    }
+
+    distances[source] = 0;
+    deque_push_back(deque, source);
+
+    unsigned int vertex;
+    while (deque_pop_front(deque, &vertex)) {
+        if (__bfs_test_and_set(settled, vertex)) {
+            continue;
+        }
+
+        stats->vertices_visited += 1;
+        if (vertex == target) {
+            found = true;
+            stats->distance = distances[vertex];
+            break;
+        }
+
+        uint64_t end = graph->offsets[vertex + 1];
+        for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+            unsigned int neighbor = graph->neighbors[e];
+            unsigned int distance = distances[vertex] + weights->weights[e];
+            stats->edges_traversed += 1;
+
+            if (distance >= distances[neighbor]) {
+                continue;
+            }
+
+            distances[neighbor] = distance;
+            bool pushed = weights->weights[e] == 0 ? deque_push_front(deque, neighbor) :
+                                                     deque_push_back(deque, neighbor);
+            if (!pushed) {
+                goto out;
+            }
+        }
+
+        if (deque_size(deque) > stats->peak_queue_size) {
+            stats->peak_queue_size = deque_size(deque);
+        }
+    }
+
+out:
+    deque_delete(deque);
+    free(settled);
+    free(distances);
+    return found;
+}
+
+// Finds the lightest path from source to target with Dijkstra's
+// algorithm on a radix heap, stopping when target is popped.
+bool bfs_dijkstra_path_exists(const struct graph * graph,
+                              const struct graph_weights * weights,
+                              unsigned int source,
+                              unsigned int target,
+                              struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || weights == NULL || weights->edge_count != graph->edge_count ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    unsigned int * distances = (unsigned int *)malloc((size_t)graph->vertex_count * sizeof(unsigned int));
+    struct radix_heap * heap = radix_heap_create(graph->vertex_count);
+    bool found = false;
+
+    if (distances == NULL || heap == NULL) {
+        goto out;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        distances[v] = BFS_UNREACHABLE;
+    }
+
+    distances[source] = 0;
+    radix_heap_push(heap, source, 0);
+
+    unsigned int vertex;
+    while (radix_heap_pop_min(heap, &vertex, NULL)) {
+        stats->vertices_visited += 1;
+        if (vertex == target) {
+            found = true;
+            stats->distance = distances[vertex];
+            break;
+        }
+
+        uint64_t end = graph->offsets[vertex + 1];
+        for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+            unsigned int neighbor = graph->neighbors[e];
+            uint64_t distance = (uint64_t)distances[vertex] + weights->weights[e];
+            stats->edges_traversed += 1;
+
+            // Settled vertices are never improved on, and paths too
+            // heavy to tell from BFS_UNREACHABLE are dropped.
+            //
+            if (distance >= distances[neighbor]) {
+                continue;
+            }
+
+            bool queued = distances[neighbor] == BFS_UNREACHABLE ?
+                          radix_heap_push(heap, neighbor, (unsigned int)distance) :
+                          radix_heap_decrease_key(heap, neighbor, (unsigned int)distance);
+            if (!queued) {
+                goto out;
+            }
+            distances[neighbor] = (unsigned int)distance;
+        }
+
+        if (radix_heap_size(heap) > stats->peak_queue_size) {
+            stats->peak_queue_size = radix_heap_size(heap);
+        }
+    }
+
+out:
+    radix_heap_delete(heap);
+    free(distances);
+    return found;
+}
+
+struct bfs_workspace {
+    unsigned int vertex_count;
+    uint64_t * visited;
+    unsigned int * queue;
+    // Entries of queue[] used by the last search: exactly the vertices
+    // whose visited bits are set.
+    size_t used;
+    // Parent of each vertex discovered by bfs_workspace_path(), valid
+    // where stamps[v] == epoch. Allocated by the first such search.
+    unsigned int * parents;
+    unsigned int * stamps;
+    unsigned int epoch;
+};
+
+// Creates a workspace.
+struct bfs_workspace * bfs_workspace_create(unsigned int vertex_count) {
+    struct bfs_workspace * workspace = (struct bfs_workspace *)calloc(1, sizeof(struct bfs_workspace));
+
+    if (workspace == NULL) {
+        return NULL;
+    }
+
+    size_t words = ((size_t)vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    workspace->vertex_count = vertex_count;
+    workspace->visited = (uint64_t *)calloc(words + 1, sizeof(uint64_t));
+    workspace->queue = (unsigned int *)malloc(((size_t)vertex_count + 1) * sizeof(unsigned int));
+
+    if (workspace->visited == NULL || workspace->queue == NULL) {
+        bfs_workspace_delete(workspace);
+        return NULL;
+    }
+
+    return workspace;
+}
+
+// Clears the visited bits set by the last search. Cheaper than clearing
+// the bitmap when searches stop early.
+static void __bfs_workspace_reset(struct bfs_workspace * workspace) {
+    for (size_t i = 0; i < workspace->used; i++) {
+        workspace->visited[workspace->queue[i] / BITS_PER_WORD] = 0;
+    }
+
+    workspace->used = 0;
+}
+
+// Starts a new generation of parent stamps, allocating the arrays on
+// first use. Stamps are only cleared when the counter wraps.
+static bool __bfs_workspace_next_epoch(struct bfs_workspace * workspace) {
+
+    if (workspace->stamps == NULL) {
+        workspace->parents = (unsigned int *)malloc(((size_t)workspace->vertex_count + 1) * sizeof(unsigned int));
+        workspace->stamps = (unsigned int *)calloc((size_t)workspace->vertex_count + 1, sizeof(unsigned int));
+
+        if (workspace->parents == NULL || workspace->stamps == NULL) {
+            free(workspace->parents);
+            free(workspace->stamps);
+            workspace->parents = NULL;
+            workspace->stamps = NULL;
+            return false;
+        }
+    }
+
+    workspace->epoch += 1;
+    if (workspace->epoch == 0) {
+        memset(workspace->stamps, 0, ((size_t)workspace->vertex_count + 1) * sizeof(unsigned int));
+        workspace->epoch = 1;
+    }
+
+    return true;
+}
+
+// Answers whether there is a path from source to target, reusing the
+// workspace's bitmap and queue.
+bool bfs_workspace_path_exists(struct bfs_workspace * workspace,
+                               const struct graph * graph,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (workspace == NULL || graph == NULL || graph->vertex_count > workspace->vertex_count ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    __bfs_workspace_reset(workspace);
+    uint64_t * visited = workspace->visited;
+    unsigned int * queue = workspace->queue;
+
+    __bfs_test_and_set(visited, source);
+    queue[0] = source;
+    stats->vertices_visited = 1;
+
+    size_t head = 0, tail = 1;
+    bool found = false;
+    unsigned int depth = 0;
+
+    while (!found && head < tail) {
+        size_t level_end = tail;
+        depth += 1;
+
+        if (tail - head > stats->peak_queue_size) {
+            stats->peak_queue_size = tail - head;
+        }
+
+        for (; head < level_end && !found; head++) {
+            unsigned int vertex = queue[head];
+            uint64_t end = graph->offsets[vertex + 1];
+
+            for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                stats->edges_traversed += 1;
+
+                if (__bfs_test_and_set(visited, neighbor)) {
+                    continue;
+                }
+
+                queue[tail++] = neighbor;
+                stats->vertices_visited += 1;
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        if (tail - head > stats->peak_queue_size) {
+            stats->peak_queue_size = tail - head;
+        }
+    }
+
+    if (found) {
+        stats->distance = depth;
+    }
+
+    workspace->used = tail;
+    return found;
+}
+
+// Computes the distance from source to every vertex. The distances
+// array doubles as the visited set.
+bool bfs_workspace_distances(struct bfs_workspace * workspace,
+                             const struct graph * graph,
+                             unsigned int source,
+                             unsigned int * distances,
+                             struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (workspace == NULL || graph == NULL || distances == NULL ||
+        graph->vertex_count > workspace->vertex_count || source >= graph->vertex_count) {
+        return false;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        distances[v] = BFS_UNREACHABLE;
+    }
+
+    // The queue is about to be overwritten, and with it the record of
+    // which visited bits are set.
+    //
+    __bfs_workspace_reset(workspace);
+    unsigned int * queue = workspace->queue;
+    size_t head = 0, tail = 1;
+    queue[0] = source;
+    distances[source] = 0;
+    stats->vertices_visited = 1;
+
+    while (head < tail) {
+        unsigned int vertex = queue[head++];
+        unsigned int depth = distances[vertex] + 1;
+        uint64_t end = graph->offsets[vertex + 1];
+
+        if (tail - head > stats->peak_queue_size) {
+            stats->peak_queue_size = tail - head;
+        }
+
+        for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+            unsigned int neighbor = graph->neighbors[e];
+            stats->edges_traversed += 1;
+
+            if (distances[neighbor] == BFS_UNREACHABLE) {
+                distances[neighbor] = depth;
+                queue[tail++] = neighbor;
+                stats->vertices_visited += 1;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Finds a shortest path from source to target. The stamps array is the
+// visited set, so the bitmap is left clear, and once the search is over
+// the path is written over the front of the queue.
+const unsigned int * bfs_workspace_path(struct bfs_workspace * workspace,
+                                        const struct graph * graph,
+                                        unsigned int source,
+                                        unsigned int target,
+                                        size_t * length,
+                                        struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (length != NULL) {
+        *length = 0;
+    }
+
+    if (workspace == NULL || graph == NULL || length == NULL || graph->vertex_count > workspace->vertex_count ||
+        source >= graph->vertex_count || target >= graph->vertex_count) {
+        return NULL;
+    }
+
+    __bfs_workspace_reset(workspace);
+    if (!__bfs_workspace_next_epoch(workspace)) {
+        return NULL;
+    }
+
+    unsigned int * queue = workspace->queue;
+    unsigned int * parents = workspace->parents;
+    unsigned int * stamps = workspace->stamps;
+    unsigned int epoch = workspace->epoch;
+
+    stamps[source] = epoch;
+    parents[source] = source;
+    queue[0] = source;
+    stats->vertices_visited = 1;
+
+    size_t head = 0, tail = 1;
+    bool found = (source == target);
+    unsigned int depth = 0;
+
+    while (!found && head < tail) {
+        size_t level_end = tail;
+        depth += 1;
+
+        if (tail - head > stats->peak_queue_size) {
+            stats->peak_queue_size = tail - head;
+        }
+
+        for (; head < level_end && !found; head++) {
+            unsigned int vertex = queue[head];
+            uint64_t end = graph->offsets[vertex + 1];
+
+            for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                stats->edges_traversed += 1;
+
+                if (stamps[neighbor] == epoch) {
+                    continue;
+                }
+
+                stamps[neighbor] = epoch;
+                parents[neighbor] = vertex;
+                queue[tail++] = neighbor;
+                stats->vertices_visited += 1;
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (!found) {
+        return NULL;
+    }
+
+    // At least depth + 1 vertices were queued, so the path fits in the
+    // queue. Walk the parents back from the target into place.
+    //
+    stats->distance = depth;
+    unsigned int vertex = target;
+    for (size_t i = depth + 1; i > 0; i--) {
+        queue[i - 1] = vertex;
+        vertex = parents[vertex];
+    }
+
+    *length = (size_t)depth + 1;
+    return queue;
+}
+
+// Frees a workspace.
+void bfs_workspace_delete(struct bfs_workspace * workspace) {
+
+    if (workspace == NULL) {
+        return;
+    }
+
+    free(workspace->visited);
+    free(workspace->queue);
+    free(workspace->parents);
+    free(workspace->stamps);
+    free(workspace);
+}
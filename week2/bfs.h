@@ -0,0 +1,295 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _BFS_H
+#define _BFS_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.h"
+#include "graph_compressed.h"
+#include "graph_landmarks.h"
+#include "graph_scc.h"
+#include "graph_weights.h"
+
+// Breadth first search over a CSR graph, driven by struct queue.
+// PRECONDITION: queue_register_malloc() and queue_register_free() have
+//               been called, as every search creates a queue.
+
+#define BFS_UNREACHABLE UINT_MAX
+
+// Direction switching thresholds of bfs_direction_optimizing_path_exists(),
+// the values suggested by Beamer et al. Switch to bottom-up when the
+// edges out of the frontier exceed 1/ALPHA of the edges out of unvisited
+// vertices; switch back to top-down when the frontier shrinks below
+// 1/BETA of the vertices.
+#define BFS_DIRECTION_ALPHA 14
+#define BFS_DIRECTION_BETA 24
+
+// Work done by one search, filled in when a pointer is passed.
+//
+struct bfs_stats {
+    uint64_t edges_traversed;
+    uint64_t vertices_visited;
+    size_t peak_queue_size;
+    unsigned int distance;
+    unsigned int bottom_up_levels;
+    unsigned int dense_levels;
+};
+
+// Answers whether there is a path from source to target, stopping as
+// soon as target is discovered.
+// \param graph  : Pointer to graph.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL. On
+//                 return, stats->distance is the number of edges on a
+//                 shortest path, BFS_UNREACHABLE if there is none.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_path_exists(const struct graph * graph,
+                     unsigned int source,
+                     unsigned int target,
+                     struct bfs_stats * stats);
+
+// Answers the same question as bfs_path_exists(), switching between
+// top-down levels (frontier in a struct queue, scanning out-edges) and
+// bottom-up levels (frontier in a bitmap, every unvisited vertex
+// scanning its in-edges until it finds a parent in the frontier).
+// Bottom-up wins on the large middle levels of low-diameter graphs,
+// where most out-edges lead to vertices that are already visited.
+// \param graph  : Pointer to graph, graph->transpose must be set (see
+//                 graph_load_options.transpose).
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL.
+//                 stats->bottom_up_levels counts the bottom-up levels.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input
+// and a missing transpose).
+//
+bool bfs_direction_optimizing_path_exists(const struct graph * graph,
+                                          unsigned int source,
+                                          unsigned int target,
+                                          struct bfs_stats * stats);
+
+// Answers the same question as bfs_path_exists() by searching forward
+// from source over graph and backward from target over its transpose,
+// each side with its own queue, always expanding a whole level of the
+// side with the smaller frontier. Stops as soon as the two sides meet,
+// which on small-world graphs is after touching a tiny fraction of the
+// vertices a one-sided search would.
+// \param graph  : Pointer to graph, graph->transpose must be set.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL.
+//                 stats->peak_queue_size is the largest total of both
+//                 queues.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input
+// and a missing transpose).
+//
+bool bfs_bidirectional_path_exists(const struct graph * graph,
+                                   unsigned int source,
+                                   unsigned int target,
+                                   struct bfs_stats * stats);
+
+// Answers the same question as bfs_path_exists() over a compressed
+// graph, decoding each neighbor list as it is scanned. Trades a few
+// instructions per edge for reading about a third of the bytes.
+// \param graph  : Pointer to compressed graph.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_compressed_path_exists(const struct graph_compressed * graph,
+                                unsigned int source,
+                                unsigned int target,
+                                struct bfs_stats * stats);
+
+// Answers the same question as bfs_path_exists(), refusing pairs the
+// condensation proves unreachable without searching (see
+// graph_scc_reachable()), and never queueing a vertex whose component
+// cannot be on a path to the target.
+// \param scc    : Pointer to the components of graph.
+// \param graph  : Pointer to graph.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL. A
+//                 refused query has visited no vertices.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_scc_path_exists(const struct graph_scc * scc,
+                         const struct graph * graph,
+                         unsigned int source,
+                         unsigned int target,
+                         struct bfs_stats * stats);
+
+// Answers the same question as bfs_path_exists() with the help of a
+// landmark index (see graph_landmarks.h). Queries whose bounds meet, or
+// that a landmark proves unreachable, are answered without searching.
+// The others search only while a shorter path than the upper bound is
+// possible: a vertex is not queued if its depth plus its lower bound
+// to the target reaches the upper bound, and if the target is not
+// found the upper bound is the distance.
+// \param landmarks : Pointer to the landmark index of graph.
+// \param graph     : Pointer to graph.
+// \param source    : Vertex to start from.
+// \param target    : Vertex to look for.
+// \param stats     : Pointer to stats (provided by caller), or NULL. A
+//                    query answered by the bounds has visited no
+//                    vertices.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_landmarks_path_exists(const struct graph_landmarks * landmarks,
+                               const struct graph * graph,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats);
+
+// Finds the lightest path from source to target in a graph whose edges
+// weigh 0 or 1, in O(V + E) time: a 0-1 BFS on a struct deque, which
+// pushes vertices reached over a 0 edge at the front and the others at
+// the back, so it pops them in order of distance like Dijkstra would,
+// without a heap.
+// \param graph   : Pointer to graph.
+// \param weights : Pointer to weights of graph, all 0 or 1.
+// \param source  : Vertex to start from.
+// \param target  : Vertex to look for.
+// \param stats   : Pointer to stats (provided by caller), or NULL. On
+//                  return, stats->distance is the weight of a lightest
+//                  path and stats->vertices_visited the number of
+//                  vertices settled.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input,
+// such as a weight above 1).
+//
+bool bfs_0_1_path_exists(const struct graph * graph,
+                         const struct graph_weights * weights,
+                         unsigned int source,
+                         unsigned int target,
+                         struct bfs_stats * stats);
+
+// Finds the lightest path from source to target in a graph with
+// integer edge weights, with Dijkstra's algorithm on a radix heap (see
+// radix_heap.h). Any weights work; for 0/1 weights
+// bfs_0_1_path_exists() needs no heap at all.
+// \param graph   : Pointer to graph.
+// \param weights : Pointer to weights of graph.
+// \param source  : Vertex to start from.
+// \param target  : Vertex to look for.
+// \param stats   : Pointer to stats (provided by caller), or NULL. On
+//                  return, stats->distance is the weight of a lightest
+//                  path and stats->vertices_visited the number of
+//                  vertices settled.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+// Paths of weight BFS_UNREACHABLE or more are not found.
+//
+bool bfs_dijkstra_path_exists(const struct graph * graph,
+                              const struct graph_weights * weights,
+                              unsigned int source,
+                              unsigned int target,
+                              struct bfs_stats * stats);
+
+// Scratch state for repeated searches over graphs of up to a given
+// number of vertices: a visited bitmap and an array used as the FIFO
+// queue, since a vertex is queued at most once. Allocated once and
+// reused, so a search costs no allocation, and only the bits set by the
+// previous search are cleared. Not thread-safe: one workspace per
+// thread.
+//
+struct bfs_workspace;
+
+// Creates a workspace.
+// \param vertex_count : Largest number of vertices of a graph searched.
+// Returns a new workspace on success, NULL on failure.
+//
+struct bfs_workspace * bfs_workspace_create(unsigned int vertex_count);
+
+// Answers the same question as bfs_path_exists() with the scratch
+// state of a workspace.
+// \param workspace : Pointer to workspace.
+// \param graph     : Pointer to graph, with no more vertices than the
+//                    workspace was created for.
+// \param source    : Vertex to start from.
+// \param target    : Vertex to look for.
+// \param stats     : Pointer to stats (provided by caller), or NULL.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_workspace_path_exists(struct bfs_workspace * workspace,
+                               const struct graph * graph,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats);
+
+// Computes the distance from source to every vertex, with the queue of
+// a workspace.
+// \param workspace : Pointer to workspace.
+// \param graph     : Pointer to graph, with no more vertices than the
+//                    workspace was created for.
+// \param source    : Vertex to start from.
+// \param distances : Array of graph->vertex_count entries (provided by
+//                    caller), set to BFS_UNREACHABLE for vertices that
+//                    cannot be reached.
+// \param stats     : Pointer to stats (provided by caller), or NULL.
+// Returns TRUE on success, FALSE on bad input.
+//
+bool bfs_workspace_distances(struct bfs_workspace * workspace,
+                             const struct graph * graph,
+                             unsigned int source,
+                             unsigned int * distances,
+                             struct bfs_stats * stats);
+
+// Finds a shortest path from source to target: the click path behind
+// bfs_workspace_path_exists(). Each discovered vertex records its
+// parent in an array of the workspace, stamped with a generation number
+// so that no search has to clear it; both arrays (8 bytes a vertex) are
+// allocated by the first call and reused after that.
+// \param workspace : Pointer to workspace.
+// \param graph     : Pointer to graph, with no more vertices than the
+//                    workspace was created for.
+// \param source    : Vertex to start from.
+// \param target    : Vertex to look for.
+// \param length    : Set to the number of vertices on the path, source
+//                    and target included (stats->distance + 1), 0 if
+//                    there is none.
+// \param stats     : Pointer to stats (provided by caller), or NULL.
+// Returns the path from source to target, which belongs to the
+// workspace and is valid until its next search, NULL if there is no
+// path (or on bad input or allocation failure).
+//
+const unsigned int * bfs_workspace_path(struct bfs_workspace * workspace,
+                                        const struct graph * graph,
+                                        unsigned int source,
+                                        unsigned int target,
+                                        size_t * length,
+                                        struct bfs_stats * stats);
+
+// Frees a workspace.
+// \param workspace : Workspace to free, may be NULL.
+//
+void bfs_workspace_delete(struct bfs_workspace * workspace);
+
+#endif
@@ -0,0 +1,831 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bfs.h"
+#include "bfs_cache.h"
+#include "bfs_frontier.h"
+#include "bfs_multi_source.h"
+#include "bfs_parallel.h"
+#include "bfs_partitioned.h"
+#include "graph.h"
+#include "linked_list.h"
+#include "queue.h"
+#include "rng.h"
+
+// End-to-end BFS benchmark: loads a graph, answers a reproducible set of
+// "is there a path from s to t" queries, and reports load time, the
+// per-query latency distribution, aggregate traversed edges per second
+// (TEPS) and the peak queue size.
+//
+// Sources are drawn from vertices with at least one out-edge, targets
+// uniformly, both from the -S seed, so a given graph and seed always
+// ask the same questions.
+//
+// A .mtx graph is converted to a binary CSR cache (graph.mtx.csr) on
+// first use and mapped on later runs, see graph_load(); -n disables it
+// and -j sets the number of parser threads. -s parses through the
+// streaming loader instead of mapping the file, with -b bytes per read
+// buffer.
+//
+// -e selects the BFS engines to run (default: all of them), -t the
+// number of threads for the parallel engine and of worker processes for
+// the partitioned one. Every engine answers the
+// same queries, and answers are checked against the first engine run:
+// any disagreement is reported and makes the exit status 1. Selecting
+// an engine that needs the transposed graph (direction, bidirectional)
+// has it built at load time and kept in the cache. The compressed
+// engine varint encodes the graph (see graph_compressed.h) before its
+// queries and reports its size against the load record's graph_bytes.
+//
+// -r relabels the graph into a cache friendlier order (degree, rcm, hub,
+// see enum graph_order), also kept in the cache. Queries are drawn in
+// the file's vertex IDs and mapped, so every order asks the same
+// questions.
+//
+// The path engine reconstructs a shortest path for every query (see
+// bfs_workspace_path()), to show what recording parents costs over the
+// workspace engine.
+//
+// The partitioned engine splits the graph between worker processes that
+// exchange frontier vertices over shared memory (see bfs_partitioned.h),
+// and reports how many vertices cross partitions per query.
+//
+// The zero_one engine runs the 0-1 BFS (see bfs_0_1_path_exists()) with
+// every edge weighing 1, the cost of supporting 0/1 weights when there
+// are none.
+//
+// The scc engine computes the strongly connected components first (see
+// graph_scc.h), refuses the queries they prove unreachable and prunes
+// the rest; it reports the fraction refused without a search.
+//
+// The landmarks engine answers with a -k landmark distance index (see
+// graph_landmarks.h), kept next to the binary cache unless -n is given,
+// and reports the fraction of queries its bounds answered outright.
+//
+// -p makes the stream skewed the way served traffic is: after the first
+// P queries, every source is one of theirs. The cached engine answers
+// through a bfs_cache of -c pair entries and -m megabytes of source
+// distance arrays and reports its hit rate and memory.
+//
+// Usage: bfs_benchmark -g graph.mtx|graph.csr [-q queries] [-S seed] [-n] [-j threads]
+//                      [-s] [-b buffer_bytes] [-r order] [-e engine,engine,...]
+//                      [-t threads] [-p popular_sources] [-c pair_entries]
+//                      [-m source_megabytes] [-k landmarks] [-f text|json] [-o file]
+
+#define MAX_ENGINES 16
+
+struct bfs_benchmark_options {
+    const char * graph_path;
+    size_t queries;
+    uint64_t seed;
+    struct graph_load_options load;
+    const char * engines;
+    unsigned int bfs_threads;
+    size_t popular_sources;
+    size_t cache_pairs;
+    size_t cache_megabytes;
+    unsigned int landmarks;
+    enum bench_format format;
+    FILE * out;
+};
+
+// A BFS implementation answering path queries, either one at a time
+// (path_exists) or a batch of up to BFS_MULTI_SOURCE_LANES at a time
+// (batch), whichever is not NULL. setup(), add_counters() and teardown()
+// may be NULL.
+struct engine {
+    const char * name;
+    const char * operation;
+    bool needs_transpose;
+    bool (*setup)(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context);
+    bool (*path_exists)(void * context,
+                        const struct graph * graph,
+                        unsigned int source,
+                        unsigned int target,
+                        struct bfs_stats * stats);
+    bool (*batch)(void * context,
+                  const struct graph * graph,
+                  struct bfs_query * queries,
+                  size_t count,
+                  struct bfs_stats * stats);
+    void (*add_counters)(void * context, struct bench_record * record);
+    void (*teardown)(void * context);
+};
+
+static bool serial_path_exists(void * context,
+                               const struct graph * graph,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats) {
+    (void)context;
+    return bfs_path_exists(graph, source, target, stats);
+}
+
+static bool direction_optimizing_path_exists(void * context,
+                                             const struct graph * graph,
+                                             unsigned int source,
+                                             unsigned int target,
+                                             struct bfs_stats * stats) {
+    (void)context;
+    return bfs_direction_optimizing_path_exists(graph, source, target, stats);
+}
+
+static bool bidirectional_path_exists(void * context,
+                                      const struct graph * graph,
+                                      unsigned int source,
+                                      unsigned int target,
+                                      struct bfs_stats * stats) {
+    (void)context;
+    return bfs_bidirectional_path_exists(graph, source, target, stats);
+}
+
+static bool adaptive_path_exists(void * context,
+                                 const struct graph * graph,
+                                 unsigned int source,
+                                 unsigned int target,
+                                 struct bfs_stats * stats) {
+    (void)context;
+    return bfs_adaptive_path_exists(graph, source, target, stats);
+}
+
+static bool multi_source_batch(void * context,
+                               const struct graph * graph,
+                               struct bfs_query * queries,
+                               size_t count,
+                               struct bfs_stats * stats) {
+    (void)context;
+    return bfs_multi_source_batch(graph, queries, count, stats);
+}
+
+static bool parallel_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    (void)graph;
+    *context = bfs_pool_create(opts->bfs_threads);
+    return *context != NULL;
+}
+
+static bool parallel_path_exists(void * context,
+                                 const struct graph * graph,
+                                 unsigned int source,
+                                 unsigned int target,
+                                 struct bfs_stats * stats) {
+    return bfs_parallel_path_exists((struct bfs_pool *)context, graph, source, target, stats);
+}
+
+static void parallel_add_counters(void * context, struct bench_record * record) {
+    bench_record_add_counter(record, "threads", (double)bfs_pool_threads((struct bfs_pool *)context));
+}
+
+static void parallel_teardown(void * context) {
+    bfs_pool_delete((struct bfs_pool *)context);
+}
+
+struct partitioned_context {
+    struct bfs_partitioned * partitioned;
+    size_t queries;
+};
+
+static bool partitioned_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    struct partitioned_context * partitioned = (struct partitioned_context *)calloc(1, sizeof(struct partitioned_context));
+
+    if (partitioned == NULL) {
+        return false;
+    }
+
+    partitioned->partitioned = bfs_partitioned_create(graph, opts->bfs_threads);
+    if (partitioned->partitioned == NULL) {
+        free(partitioned);
+        return false;
+    }
+
+    *context = partitioned;
+    return true;
+}
+
+static bool partitioned_path_exists(void * context,
+                                    const struct graph * graph,
+                                    unsigned int source,
+                                    unsigned int target,
+                                    struct bfs_stats * stats) {
+    struct partitioned_context * partitioned = (struct partitioned_context *)context;
+
+    (void)graph;
+    partitioned->queries += 1;
+    return bfs_partitioned_path_exists(partitioned->partitioned, source, target, stats);
+}
+
+static void partitioned_add_counters(void * context, struct bench_record * record) {
+    const struct partitioned_context * partitioned = (const struct partitioned_context *)context;
+
+    bench_record_add_counter(record, "workers", (double)bfs_partitioned_workers(partitioned->partitioned));
+    bench_record_add_counter(record, "exchanged_per_query", partitioned->queries == 0 ? 0.0 :
+                             (double)bfs_partitioned_vertices_exchanged(partitioned->partitioned) /
+                             (double)partitioned->queries);
+}
+
+static void partitioned_teardown(void * context) {
+    struct partitioned_context * partitioned = (struct partitioned_context *)context;
+
+    bfs_partitioned_delete(partitioned->partitioned);
+    free(partitioned);
+}
+
+static bool workspace_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    (void)opts;
+    *context = bfs_workspace_create(graph->vertex_count);
+    return *context != NULL;
+}
+
+static bool workspace_path_exists(void * context,
+                                  const struct graph * graph,
+                                  unsigned int source,
+                                  unsigned int target,
+                                  struct bfs_stats * stats) {
+    return bfs_workspace_path_exists((struct bfs_workspace *)context, graph, source, target, stats);
+}
+
+static bool path_path_exists(void * context,
+                             const struct graph * graph,
+                             unsigned int source,
+                             unsigned int target,
+                             struct bfs_stats * stats) {
+    size_t length;
+    return bfs_workspace_path((struct bfs_workspace *)context, graph, source, target, &length, stats) != NULL;
+}
+
+static void workspace_teardown(void * context) {
+    bfs_workspace_delete((struct bfs_workspace *)context);
+}
+
+static bool compressed_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    (void)opts;
+    *context = graph_compress(graph);
+    return *context != NULL;
+}
+
+static bool compressed_path_exists(void * context,
+                                   const struct graph * graph,
+                                   unsigned int source,
+                                   unsigned int target,
+                                   struct bfs_stats * stats) {
+    (void)graph;
+    return bfs_compressed_path_exists((const struct graph_compressed *)context, source, target, stats);
+}
+
+static void compressed_add_counters(void * context, struct bench_record * record) {
+    const struct graph_compressed * compressed = (const struct graph_compressed *)context;
+
+    bench_record_add_counter(record, "bytes_per_edge",
+                             compressed->edge_count == 0 ? 0.0 :
+                             (double)compressed->data_length / (double)compressed->edge_count);
+    bench_record_add_counter(record, "graph_bytes", (double)graph_compressed_bytes(compressed));
+}
+
+static void compressed_teardown(void * context) {
+    graph_compressed_delete((struct graph_compressed *)context);
+}
+
+// Every edge weighs 1, so that the 0-1 BFS answers the same distances
+// as the others and shows what the deque and distance array cost.
+static bool zero_one_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    (void)opts;
+    *context = graph_weights_create(graph, 1);
+    return *context != NULL;
+}
+
+static bool zero_one_path_exists(void * context,
+                                 const struct graph * graph,
+                                 unsigned int source,
+                                 unsigned int target,
+                                 struct bfs_stats * stats) {
+    return bfs_0_1_path_exists(graph, (const struct graph_weights *)context, source, target, stats);
+}
+
+static void zero_one_teardown(void * context) {
+    graph_weights_delete((struct graph_weights *)context);
+}
+
+static bool cached_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    *context = bfs_cache_create(graph, opts->cache_pairs, opts->cache_megabytes << 20);
+    return *context != NULL;
+}
+
+static bool cached_path_exists(void * context,
+                               const struct graph * graph,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats) {
+    (void)graph;
+    return bfs_cache_path_exists((struct bfs_cache *)context, source, target, stats);
+}
+
+static void cached_add_counters(void * context, struct bench_record * record) {
+    struct bfs_cache_stats stats;
+    bfs_cache_get_stats((const struct bfs_cache *)context, &stats);
+
+    bench_record_add_counter(record, "hit_rate", stats.lookups == 0 ? 0.0 :
+                             (double)(stats.pair_hits + stats.source_hits) / (double)stats.lookups);
+    bench_record_add_counter(record, "source_fills", (double)stats.source_fills);
+    bench_record_add_counter(record, "cache_bytes", (double)stats.memory_bytes);
+}
+
+static void cached_teardown(void * context) {
+    bfs_cache_delete((struct bfs_cache *)context);
+}
+
+// Components of the graph, and how many queries they refused.
+struct scc_context {
+    struct graph_scc * scc;
+    size_t queries;
+    size_t refused;
+    uint64_t setup_ns;
+};
+
+static bool scc_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    (void)opts;
+    struct scc_context * scc = (struct scc_context *)calloc(1, sizeof(struct scc_context));
+
+    if (scc == NULL) {
+        return false;
+    }
+
+    uint64_t start = bench_now_ns();
+    scc->scc = graph_scc_compute(graph);
+    scc->setup_ns = bench_now_ns() - start;
+
+    if (scc->scc == NULL) {
+        free(scc);
+        return false;
+    }
+
+    *context = scc;
+    return true;
+}
+
+static bool scc_path_exists(void * context,
+                            const struct graph * graph,
+                            unsigned int source,
+                            unsigned int target,
+                            struct bfs_stats * stats) {
+    struct scc_context * scc = (struct scc_context *)context;
+
+    scc->queries += 1;
+    scc->refused += (graph_scc_reachable(scc->scc, source, target) == GRAPH_SCC_UNREACHABLE);
+    return bfs_scc_path_exists(scc->scc, graph, source, target, stats);
+}
+
+static void scc_add_counters(void * context, struct bench_record * record) {
+    const struct scc_context * scc = (const struct scc_context *)context;
+
+    bench_record_add_counter(record, "refused_fraction",
+                             scc->queries == 0 ? 0.0 : (double)scc->refused / (double)scc->queries);
+    bench_record_add_counter(record, "components", (double)scc->scc->component_count);
+    bench_record_add_counter(record, "largest_component", (double)scc->scc->largest_component);
+    bench_record_add_counter(record, "index_seconds", (double)scc->setup_ns / 1e9);
+    bench_record_add_counter(record, "index_bytes", (double)graph_scc_bytes(scc->scc));
+}
+
+static void scc_teardown(void * context) {
+    struct scc_context * scc = (struct scc_context *)context;
+
+    graph_scc_delete(scc->scc);
+    free(scc);
+}
+
+// Landmark index, and how many queries its bounds answered.
+struct landmarks_context {
+    struct graph_landmarks * landmarks;
+    size_t queries;
+    size_t answered;
+    uint64_t setup_ns;
+};
+
+static bool landmarks_setup(const struct bfs_benchmark_options * opts, const struct graph * graph, void ** context) {
+    struct landmarks_context * landmarks = (struct landmarks_context *)calloc(1, sizeof(struct landmarks_context));
+
+    if (landmarks == NULL) {
+        return false;
+    }
+
+    uint64_t start = bench_now_ns();
+    landmarks->landmarks = opts->load.use_cache ?
+                           graph_landmarks_load_or_build(opts->graph_path, graph, opts->landmarks) :
+                           graph_landmarks_build(graph, opts->landmarks);
+    landmarks->setup_ns = bench_now_ns() - start;
+
+    if (landmarks->landmarks == NULL) {
+        free(landmarks);
+        return false;
+    }
+
+    *context = landmarks;
+    return true;
+}
+
+static bool landmarks_path_exists(void * context,
+                                  const struct graph * graph,
+                                  unsigned int source,
+                                  unsigned int target,
+                                  struct bfs_stats * stats) {
+    struct landmarks_context * landmarks = (struct landmarks_context *)context;
+
+    bool found = bfs_landmarks_path_exists(landmarks->landmarks, graph, source, target, stats);
+    landmarks->queries += 1;
+    landmarks->answered += (stats->vertices_visited == 0);
+    return found;
+}
+
+static void landmarks_add_counters(void * context, struct bench_record * record) {
+    const struct landmarks_context * landmarks = (const struct landmarks_context *)context;
+
+    bench_record_add_counter(record, "answered_fraction", landmarks->queries == 0 ? 0.0 :
+                             (double)landmarks->answered / (double)landmarks->queries);
+    bench_record_add_counter(record, "landmarks", (double)landmarks->landmarks->count);
+    bench_record_add_counter(record, "index_seconds", (double)landmarks->setup_ns / 1e9);
+    bench_record_add_counter(record, "index_bytes", (double)graph_landmarks_bytes(landmarks->landmarks));
+}
+
+static void landmarks_teardown(void * context) {
+    struct landmarks_context * landmarks = (struct landmarks_context *)context;
+
+    graph_landmarks_delete(landmarks->landmarks);
+    free(landmarks);
+}
+
+static const struct engine engines[] = {
+    {"serial", "bfs_path_exists", false, NULL, serial_path_exists, NULL, NULL, NULL},
+    {"workspace", "bfs_workspace_path_exists", false, workspace_setup, workspace_path_exists, NULL,
+     NULL, workspace_teardown},
+    {"path", "bfs_workspace_path", false, workspace_setup, path_path_exists, NULL, NULL,
+     workspace_teardown},
+    {"parallel", "bfs_parallel_path_exists", false, parallel_setup, parallel_path_exists, NULL,
+     parallel_add_counters, parallel_teardown},
+    {"partitioned", "bfs_partitioned_path_exists", false, partitioned_setup, partitioned_path_exists, NULL,
+     partitioned_add_counters, partitioned_teardown},
+    {"direction", "bfs_direction_optimizing_path_exists", true, NULL, direction_optimizing_path_exists,
+     NULL, NULL, NULL},
+    {"bidirectional", "bfs_bidirectional_path_exists", true, NULL, bidirectional_path_exists,
+     NULL, NULL, NULL},
+    {"adaptive", "bfs_adaptive_path_exists", false, NULL, adaptive_path_exists, NULL, NULL, NULL},
+    {"multi_source", "bfs_multi_source_batch", false, NULL, NULL, multi_source_batch, NULL, NULL},
+    {"compressed", "bfs_compressed_path_exists", false, compressed_setup, compressed_path_exists, NULL,
+     compressed_add_counters, compressed_teardown},
+    {"zero_one", "bfs_0_1_path_exists", false, zero_one_setup, zero_one_path_exists, NULL, NULL,
+     zero_one_teardown},
+    {"cached", "bfs_cache_path_exists", false, cached_setup, cached_path_exists, NULL,
+     cached_add_counters, cached_teardown},
+    {"scc", "bfs_scc_path_exists", false, scc_setup, scc_path_exists, NULL, scc_add_counters,
+     scc_teardown},
+    {"landmarks", "bfs_landmarks_path_exists", false, landmarks_setup, landmarks_path_exists, NULL,
+     landmarks_add_counters, landmarks_teardown},
+};
+
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+static void choose_queries(const struct graph * graph,
+                           uint64_t seed,
+                           size_t popular,
+                           struct bfs_query * queries,
+                           size_t count) {
+    struct rng rng;
+    rng_seed(&rng, seed);
+
+    for (size_t i = 0; i < count; i++) {
+        unsigned int source = graph_vertex_id(graph, (unsigned int)rng_bounded(&rng, graph->vertex_count));
+
+        // Give up on finding a vertex with out-edges after a while, the
+        // graph might have none.
+        //
+        for (int attempt = 0; attempt < 64 && graph_degree(graph, source) == 0; attempt++) {
+            source = graph_vertex_id(graph, (unsigned int)rng_bounded(&rng, graph->vertex_count));
+        }
+
+        if (popular != 0 && i >= popular) {
+            source = queries[rng_bounded(&rng, popular)].source;
+        }
+
+        queries[i].source = source;
+        queries[i].target = graph_vertex_id(graph, (unsigned int)rng_bounded(&rng, graph->vertex_count));
+    }
+}
+
+// Looks up the engines named in a comma separated list.
+static size_t select_engines(const char * list, const struct engine ** selected) {
+    size_t count = 0;
+
+    while (*list != '\0') {
+        size_t length = strcspn(list, ",");
+        size_t e = 0;
+
+        while (e < ENGINE_COUNT &&
+               (strlen(engines[e].name) != length || strncmp(engines[e].name, list, length) != 0)) {
+            e++;
+        }
+
+        if (e == ENGINE_COUNT || count == MAX_ENGINES) {
+            fprintf(stderr, "Unknown engine or too many engines: %.*s\n", (int)length, list);
+            return 0;
+        }
+
+        selected[count] = &engines[e];
+        count += 1;
+        list += length + (list[length] == ',');
+    }
+
+    return count;
+}
+
+// Answers every query with one engine and emits its record. Distances
+// are written to answers, or checked against them if check is TRUE.
+// Batches are timed as a whole, each query is charged an equal share.
+// Returns the number of disagreements, SIZE_MAX if the engine failed.
+static size_t run_engine(const struct engine * engine,
+                         const struct bfs_benchmark_options * opts,
+                         const struct graph * graph,
+                         struct bfs_query * queries,
+                         unsigned int * answers,
+                         bool check) {
+    struct bench_samples samples;
+    struct bench_record record;
+    void * context = NULL;
+
+    if (engine->setup != NULL && !engine->setup(opts, graph, &context)) {
+        fprintf(stderr, "%s: failed to set up\n", engine->name);
+        return SIZE_MAX;
+    }
+
+    bench_samples_init(&samples, opts->queries);
+
+    uint64_t total_edges = 0;
+    uint64_t total_ns = 0;
+    size_t reachable = 0;
+    size_t peak_queue_size = 0;
+    uint64_t bottom_up_levels = 0;
+    uint64_t dense_levels = 0;
+    size_t mismatches = 0;
+
+    size_t step = (engine->batch != NULL) ? BFS_MULTI_SOURCE_LANES : 1;
+
+    for (size_t first = 0; first < opts->queries; first += step) {
+        size_t count = (opts->queries - first < step) ? opts->queries - first : step;
+        struct bfs_stats stats;
+
+        uint64_t start = bench_now_ns();
+        if (engine->batch != NULL) {
+            engine->batch(context, graph, &queries[first], count, &stats);
+        } else {
+            engine->path_exists(context, graph, queries[first].source, queries[first].target, &stats);
+            queries[first].distance = stats.distance;
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+
+        bench_samples_add(&samples, (double)elapsed / (double)count);
+        total_ns += elapsed;
+        total_edges += stats.edges_traversed;
+        bottom_up_levels += stats.bottom_up_levels;
+        dense_levels += stats.dense_levels;
+        if (stats.peak_queue_size > peak_queue_size) {
+            peak_queue_size = stats.peak_queue_size;
+        }
+
+        for (size_t i = first; i < first + count; i++) {
+            reachable += (queries[i].distance != BFS_UNREACHABLE);
+
+            if (!check) {
+                answers[i] = queries[i].distance;
+            } else if (answers[i] != queries[i].distance) {
+                fprintf(stderr, "%s: query %zu (%u -> %u) answered distance %u, expected %u\n",
+                        engine->name, i, queries[i].source, queries[i].target, queries[i].distance,
+                        answers[i]);
+                mismatches += 1;
+            }
+        }
+    }
+
+    bench_record_init(&record, "bfs", engine->operation, graph->vertex_count);
+    bench_samples_summarize(&samples, &record.summary);
+    bench_record_add_counter(&record, "teps", total_ns == 0 ? 0.0 : (double)total_edges * 1e9 / (double)total_ns);
+    bench_record_add_counter(&record, "edges_per_query", (double)total_edges / (double)opts->queries);
+    bench_record_add_counter(&record, "reachable_fraction", (double)reachable / (double)opts->queries);
+    bench_record_add_counter(&record, "peak_queue_size", (double)peak_queue_size);
+    if (engine->batch != NULL) {
+        bench_record_add_counter(&record, "batch_size", (double)step);
+    }
+    if (dense_levels != 0) {
+        bench_record_add_counter(&record, "dense_levels_per_query",
+                                 (double)dense_levels / (double)opts->queries);
+    }
+    if (bottom_up_levels != 0) {
+        bench_record_add_counter(&record, "bottom_up_levels_per_query",
+                                 (double)bottom_up_levels / (double)opts->queries);
+    }
+    if (engine->add_counters != NULL) {
+        engine->add_counters(context, &record);
+    }
+    bench_record_emit(opts->out, opts->format, &record);
+
+    bench_samples_free(&samples);
+    if (engine->teardown != NULL) {
+        engine->teardown(context);
+    }
+
+    return mismatches;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s -g graph.mtx|graph.csr [-q queries] [-S seed] [-n] [-j threads] "
+                    "[-s] [-b buffer_bytes] [-r order] [-e engine,engine,...] [-t threads] "
+                    "[-p popular_sources] [-c pair_entries] [-m source_megabytes] [-k landmarks] "
+                    "[-f text|json] [-o file]\n", program);
+}
+
+int main(int argc, char ** argv) {
+    struct bfs_benchmark_options opts = {
+        .graph_path = NULL,
+        .queries = 100,
+        .seed = 1,
+        .load = {.use_cache = true, .threads = 0},
+        .engines = "serial,workspace,path,parallel,partitioned,direction,bidirectional,adaptive,multi_source,compressed,zero_one,cached,scc,landmarks",
+        .bfs_threads = 0,
+        .popular_sources = 0,
+        .cache_pairs = 65536,
+        .cache_megabytes = 64,
+        .landmarks = 16,
+        .format = BENCH_FORMAT_TEXT,
+        .out = stdout
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:q:S:nj:sb:r:e:t:p:c:m:k:f:o:h")) != -1) {
+        switch (opt) {
+        case 'g':
+            opts.graph_path = optarg;
+            break;
+        case 'q':
+            opts.queries = strtoull(optarg, NULL, 10);
+            break;
+        case 'S':
+            opts.seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'n':
+            opts.load.use_cache = false;
+            break;
+        case 'j':
+            opts.load.threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 's':
+            opts.load.streaming = true;
+            break;
+        case 'b':
+            opts.load.stream_buffer_size = strtoull(optarg, NULL, 10);
+            break;
+        case 'r':
+            if (!graph_order_parse(optarg, &opts.load.order)) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'e':
+            opts.engines = optarg;
+            break;
+        case 't':
+            opts.bfs_threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'p':
+            opts.popular_sources = strtoull(optarg, NULL, 10);
+            break;
+        case 'c':
+            opts.cache_pairs = strtoull(optarg, NULL, 10);
+            break;
+        case 'm':
+            opts.cache_megabytes = strtoull(optarg, NULL, 10);
+            break;
+        case 'k':
+            opts.landmarks = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'f':
+            opts.format = (strcmp(optarg, "json") == 0) ? BENCH_FORMAT_JSON : BENCH_FORMAT_TEXT;
+            break;
+        case 'o':
+            opts.out = fopen(optarg, "w");
+            if (opts.out == NULL) {
+                perror(optarg);
+                return 2;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const struct engine * selected[MAX_ENGINES];
+    size_t engine_count = select_engines(opts.engines, selected);
+
+    if (opts.graph_path == NULL || opts.queries == 0 || engine_count == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (size_t e = 0; e < engine_count; e++) {
+        opts.load.transpose |= selected[e]->needs_transpose;
+    }
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+    queue_register_malloc(&malloc);
+    queue_register_free(&free);
+
+    // Load.
+    //
+    uint64_t load_start = bench_now_ns();
+    struct graph * graph = graph_load(opts.graph_path, &opts.load);
+    uint64_t load_ns = bench_now_ns() - load_start;
+
+    if (graph == NULL) {
+        return 1;
+    }
+
+    struct bench_samples samples;
+    struct bench_record record;
+    bench_samples_init(&samples, 1);
+
+    bench_samples_add(&samples, (double)load_ns / (double)(graph->edge_count == 0 ? 1 : graph->edge_count));
+    bench_record_init(&record, "bfs", "graph_load", graph->edge_count);
+    bench_samples_summarize(&samples, &record.summary);
+    bench_record_add_counter(&record, "load_seconds", (double)load_ns / 1e9);
+    bench_record_add_counter(&record, "vertices", (double)graph->vertex_count);
+    bench_record_add_counter(&record, "edges", (double)graph->edge_count);
+    bench_record_add_counter(&record, "graph_bytes", (double)graph_bytes(graph));
+    bench_record_add_counter(&record, "mapped", graph->mapping != NULL ? 1.0 : 0.0);
+    bench_record_add_counter(&record, "streaming", opts.load.streaming ? 1.0 : 0.0);
+    bench_record_add_counter(&record, "transpose", graph->transpose != NULL ? 1.0 : 0.0);
+    bench_record_add_counter(&record, "order", (double)graph->order);
+    bench_record_emit(opts.out, opts.format, &record);
+    bench_samples_free(&samples);
+
+    // Queries, answered by every selected engine.
+    //
+    struct bfs_query * queries = (struct bfs_query *)malloc(opts.queries * sizeof(struct bfs_query));
+    unsigned int * answers = (unsigned int *)malloc(opts.queries * sizeof(unsigned int));
+
+    if (queries == NULL || answers == NULL) {
+        free(queries);
+        free(answers);
+        graph_delete(graph);
+        return 1;
+    }
+    choose_queries(graph, opts.seed, opts.popular_sources, queries, opts.queries);
+
+    // Without answers from the first engine there is nothing to check
+    // the others against.
+    //
+    int status = 0;
+    for (size_t e = 0; e < engine_count; e++) {
+        size_t mismatches = run_engine(selected[e], &opts, graph, queries, answers, e != 0);
+
+        if (mismatches != 0) {
+            status = 1;
+        }
+        if (mismatches == SIZE_MAX && e == 0) {
+            break;
+        }
+    }
+
+    free(answers);
+    free(queries);
+    graph_delete(graph);
+    linked_list_final_cleanup();
+
+    if (opts.out != stdout) {
+        fclose(opts.out);
+    }
+
+    return status;
+}
@@ -0,0 +1,385 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bfs_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BFS_CACHE_NONE UINT32_MAX
+
+// Key of a slot that was handed out but holds nothing: no source or
+// (source, target) pair encodes to it.
+#define BFS_CACHE_NO_KEY UINT64_MAX
+
+// A fixed-capacity LRU map from 64-bit keys to slots 0 .. capacity - 1.
+// Slots are stable while their key stays cached, so callers keep their
+// values in parallel arrays indexed by slot. Recency is a doubly linked
+// list through prev/next, lookup a chained hash through chain/buckets.
+struct bfs_cache_lru {
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t head;
+    uint32_t tail;
+    uint64_t * keys;
+    uint32_t * prev;
+    uint32_t * next;
+    uint32_t * chain;
+    uint32_t * buckets;
+    uint64_t bucket_mask;
+};
+
+struct bfs_cache {
+    const struct graph * graph;
+    struct bfs_workspace * workspace;
+    struct bfs_cache_lru pairs;
+    unsigned int * pair_distances;
+    struct bfs_cache_lru sources;
+    unsigned int ** source_distances;
+    // Direct-mapped record of sources that missed recently, plus one,
+    // 0 for an empty entry.
+    unsigned int recent_sources[BFS_CACHE_RECENT_SOURCES];
+    struct bfs_cache_stats stats;
+};
+
+// Fibonacci hashing of a key into a bucket.
+static uint64_t __bfs_cache_hash(const struct bfs_cache_lru * lru, uint64_t key) {
+    return ((key * 0x9e3779b97f4a7c15ull) >> 32) & lru->bucket_mask;
+}
+
+// Allocates an empty LRU, returns the bytes allocated or 0 on failure.
+static size_t __bfs_cache_lru_init(struct bfs_cache_lru * lru, uint32_t capacity) {
+    uint64_t buckets = 1;
+
+    while (buckets < 2 * (uint64_t)capacity) {
+        buckets <<= 1;
+    }
+
+    memset(lru, 0, sizeof(*lru));
+    lru->capacity = capacity;
+    lru->head = BFS_CACHE_NONE;
+    lru->tail = BFS_CACHE_NONE;
+    lru->bucket_mask = buckets - 1;
+    lru->keys = (uint64_t *)malloc(((size_t)capacity + 1) * sizeof(uint64_t));
+    lru->prev = (uint32_t *)malloc(((size_t)capacity + 1) * sizeof(uint32_t));
+    lru->next = (uint32_t *)malloc(((size_t)capacity + 1) * sizeof(uint32_t));
+    lru->chain = (uint32_t *)malloc(((size_t)capacity + 1) * sizeof(uint32_t));
+    lru->buckets = (uint32_t *)malloc(buckets * sizeof(uint32_t));
+
+    if (lru->keys == NULL || lru->prev == NULL || lru->next == NULL ||
+        lru->chain == NULL || lru->buckets == NULL) {
+        return 0;
+    }
+
+    memset(lru->buckets, 0xff, buckets * sizeof(uint32_t));
+    return (size_t)capacity * (sizeof(uint64_t) + 3 * sizeof(uint32_t)) + buckets * sizeof(uint32_t);
+}
+
+// Frees the arrays of an LRU.
+static void __bfs_cache_lru_free(struct bfs_cache_lru * lru) {
+    free(lru->keys);
+    free(lru->prev);
+    free(lru->next);
+    free(lru->chain);
+    free(lru->buckets);
+}
+
+// Takes a slot out of the recency list.
+static void __bfs_cache_lru_unlink(struct bfs_cache_lru * lru, uint32_t slot) {
+    if (lru->prev[slot] != BFS_CACHE_NONE) {
+        lru->next[lru->prev[slot]] = lru->next[slot];
+    } else {
+        lru->head = lru->next[slot];
+    }
+
+    if (lru->next[slot] != BFS_CACHE_NONE) {
+        lru->prev[lru->next[slot]] = lru->prev[slot];
+    } else {
+        lru->tail = lru->prev[slot];
+    }
+}
+
+// Puts a slot at the most recently used end of the list.
+static void __bfs_cache_lru_push_front(struct bfs_cache_lru * lru, uint32_t slot) {
+    lru->prev[slot] = BFS_CACHE_NONE;
+    lru->next[slot] = lru->head;
+
+    if (lru->head != BFS_CACHE_NONE) {
+        lru->prev[lru->head] = slot;
+    } else {
+        lru->tail = slot;
+    }
+
+    lru->head = slot;
+}
+
+// Puts a slot at the least recently used end of the list.
+static void __bfs_cache_lru_push_back(struct bfs_cache_lru * lru, uint32_t slot) {
+    lru->next[slot] = BFS_CACHE_NONE;
+    lru->prev[slot] = lru->tail;
+
+    if (lru->tail != BFS_CACHE_NONE) {
+        lru->next[lru->tail] = slot;
+    } else {
+        lru->head = slot;
+    }
+
+    lru->tail = slot;
+}
+
+// Links a slot into the hash chain of its new key.
+static void __bfs_cache_lru_chain(struct bfs_cache_lru * lru, uint32_t slot, uint64_t key) {
+    uint64_t bucket = __bfs_cache_hash(lru, key);
+
+    lru->keys[slot] = key;
+    lru->chain[slot] = lru->buckets[bucket];
+    lru->buckets[bucket] = slot;
+}
+
+// Takes a slot out of the hash chain of its key.
+static void __bfs_cache_lru_unchain(struct bfs_cache_lru * lru, uint32_t slot) {
+    uint32_t * link = &lru->buckets[__bfs_cache_hash(lru, lru->keys[slot])];
+
+    while (*link != slot) {
+        link = &lru->chain[*link];
+    }
+    *link = lru->chain[slot];
+}
+
+// Returns the slot of a key, marking it most recently used, or
+// BFS_CACHE_NONE if it is not cached.
+static uint32_t __bfs_cache_lru_find(struct bfs_cache_lru * lru, uint64_t key) {
+    if (lru->capacity == 0) {
+        return BFS_CACHE_NONE;
+    }
+
+    for (uint32_t slot = lru->buckets[__bfs_cache_hash(lru, key)]; slot != BFS_CACHE_NONE; slot = lru->chain[slot]) {
+        if (lru->keys[slot] == key) {
+            if (slot != lru->head) {
+                __bfs_cache_lru_unlink(lru, slot);
+                __bfs_cache_lru_push_front(lru, slot);
+            }
+            return slot;
+        }
+    }
+
+    return BFS_CACHE_NONE;
+}
+
+// Adds a key that is not cached, evicting the least recently used one
+// when full. Returns its slot, BFS_CACHE_NONE if the capacity is 0.
+static uint32_t __bfs_cache_lru_insert(struct bfs_cache_lru * lru, uint64_t key) {
+    uint32_t slot;
+
+    if (lru->capacity == 0) {
+        return BFS_CACHE_NONE;
+    }
+
+    if (lru->count < lru->capacity) {
+        slot = lru->count++;
+    } else {
+        slot = lru->tail;
+        __bfs_cache_lru_unlink(lru, slot);
+        __bfs_cache_lru_unchain(lru, slot);
+    }
+
+    __bfs_cache_lru_chain(lru, slot, key);
+    __bfs_cache_lru_push_front(lru, slot);
+
+    return slot;
+}
+
+// Drops the key of a slot whose value could not be filled in, and makes
+// the slot the next one handed out.
+static void __bfs_cache_lru_forget(struct bfs_cache_lru * lru, uint32_t slot) {
+    __bfs_cache_lru_unchain(lru, slot);
+    __bfs_cache_lru_chain(lru, slot, BFS_CACHE_NO_KEY);
+    __bfs_cache_lru_unlink(lru, slot);
+    __bfs_cache_lru_push_back(lru, slot);
+}
+
+// Creates a cache for one graph.
+struct bfs_cache * bfs_cache_create(const struct graph * graph,
+                                    size_t pair_capacity,
+                                    size_t source_bytes) {
+
+    if (graph == NULL || pair_capacity >= BFS_CACHE_NONE) {
+        return NULL;
+    }
+
+    struct bfs_cache * cache = (struct bfs_cache *)calloc(1, sizeof(struct bfs_cache));
+    if (cache == NULL) {
+        return NULL;
+    }
+
+    size_t array_bytes = ((size_t)graph->vertex_count + 1) * sizeof(unsigned int);
+    size_t source_capacity = source_bytes / array_bytes;
+    if (source_capacity >= BFS_CACHE_NONE) {
+        source_capacity = BFS_CACHE_NONE - 1;
+    }
+
+    cache->graph = graph;
+    cache->workspace = bfs_workspace_create(graph->vertex_count);
+    size_t pair_bytes = __bfs_cache_lru_init(&cache->pairs, (uint32_t)pair_capacity);
+    size_t source_lru_bytes = __bfs_cache_lru_init(&cache->sources, (uint32_t)source_capacity);
+    cache->pair_distances = (unsigned int *)malloc((pair_capacity + 1) * sizeof(unsigned int));
+    cache->source_distances = (unsigned int **)calloc(source_capacity + 1, sizeof(unsigned int *));
+
+    if (cache->workspace == NULL || pair_bytes == 0 || source_lru_bytes == 0 ||
+        cache->pair_distances == NULL || cache->source_distances == NULL) {
+        bfs_cache_delete(cache);
+        return NULL;
+    }
+
+    // The workspace holds a bitmap and a queue entry per vertex.
+    //
+    cache->stats.memory_bytes = sizeof(struct bfs_cache) + pair_bytes + source_lru_bytes +
+                                pair_capacity * sizeof(unsigned int) +
+                                source_capacity * sizeof(unsigned int *) +
+                                (size_t)graph->vertex_count / 8 + array_bytes;
+
+    return cache;
+}
+
+// Returns TRUE if source missed recently, and records that it missed.
+static bool __bfs_cache_source_recurs(struct bfs_cache * cache, unsigned int source) {
+    unsigned int * entry = &cache->recent_sources[((source * 0x9e3779b9u) >> 16) % BFS_CACHE_RECENT_SOURCES];
+
+    if (*entry == source + 1) {
+        return true;
+    }
+
+    *entry = source + 1;
+    return false;
+}
+
+// Sweeps from source into a source array, evicting the least recently
+// used one if the budget is spent. Returns the array, NULL on failure.
+static unsigned int * __bfs_cache_fill_source(struct bfs_cache * cache,
+                                              unsigned int source,
+                                              struct bfs_stats * stats) {
+    uint32_t slot = __bfs_cache_lru_insert(&cache->sources, source);
+    unsigned int ** distances = &cache->source_distances[slot];
+
+    if (*distances == NULL) {
+        *distances = (unsigned int *)malloc(((size_t)cache->graph->vertex_count + 1) * sizeof(unsigned int));
+
+        if (*distances == NULL) {
+            __bfs_cache_lru_forget(&cache->sources, slot);
+            return NULL;
+        }
+
+        cache->stats.memory_bytes += ((size_t)cache->graph->vertex_count + 1) * sizeof(unsigned int);
+        cache->stats.source_entries += 1;
+    }
+
+    // A failed sweep must not leave a stale array behind under this
+    // source: the slot is kept, with its array, for the next fill.
+    //
+    if (!bfs_workspace_distances(cache->workspace, cache->graph, source, *distances, stats)) {
+        __bfs_cache_lru_forget(&cache->sources, slot);
+        return NULL;
+    }
+
+    cache->stats.source_fills += 1;
+    return *distances;
+}
+
+// Answers a query from the caches, or by searching and caching.
+bool bfs_cache_path_exists(struct bfs_cache * cache,
+                           unsigned int source,
+                           unsigned int target,
+                           struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (cache == NULL || source >= cache->graph->vertex_count || target >= cache->graph->vertex_count) {
+        return false;
+    }
+
+    cache->stats.lookups += 1;
+
+    uint64_t key = ((uint64_t)source << 32) | target;
+    uint32_t slot = __bfs_cache_lru_find(&cache->pairs, key);
+
+    if (slot != BFS_CACHE_NONE) {
+        cache->stats.pair_hits += 1;
+        stats->distance = cache->pair_distances[slot];
+        return stats->distance != BFS_UNREACHABLE;
+    }
+
+    slot = __bfs_cache_lru_find(&cache->sources, source);
+    if (slot != BFS_CACHE_NONE) {
+        cache->stats.source_hits += 1;
+        stats->distance = cache->source_distances[slot][target];
+    } else if (cache->sources.capacity != 0 && __bfs_cache_source_recurs(cache, source)) {
+        unsigned int * distances = __bfs_cache_fill_source(cache, source, stats);
+
+        if (distances == NULL) {
+            return false;
+        }
+        stats->distance = distances[target];
+    } else {
+        bfs_workspace_path_exists(cache->workspace, cache->graph, source, target, stats);
+    }
+
+    slot = __bfs_cache_lru_insert(&cache->pairs, key);
+    if (slot != BFS_CACHE_NONE) {
+        cache->pair_distances[slot] = stats->distance;
+        cache->stats.pair_entries = cache->pairs.count;
+    }
+
+    return stats->distance != BFS_UNREACHABLE;
+}
+
+// Reads the counters of a cache.
+void bfs_cache_get_stats(const struct bfs_cache * cache, struct bfs_cache_stats * stats) {
+    *stats = cache->stats;
+}
+
+// Frees a cache.
+void bfs_cache_delete(struct bfs_cache * cache) {
+
+    if (cache == NULL) {
+        return;
+    }
+
+    if (cache->source_distances != NULL) {
+        for (uint32_t slot = 0; slot < cache->sources.capacity; slot++) {
+            free(cache->source_distances[slot]);
+        }
+    }
+
+    bfs_workspace_delete(cache->workspace);
+    __bfs_cache_lru_free(&cache->pairs);
+    __bfs_cache_lru_free(&cache->sources);
+    free(cache->pair_distances);
+    free(cache->source_distances);
+    free(cache);
+}
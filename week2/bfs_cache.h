@@ -0,0 +1,105 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _BFS_CACHE_H
+#define _BFS_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bfs.h"
+#include "graph.h"
+
+// Result cache in front of a bfs_workspace, for query streams where the
+// same sources keep coming back. Two LRU caches, each optional:
+//
+//   - pair results: (source, target) -> distance, up to a number of
+//     entries;
+//   - source arrays: the distance from a source to every vertex, 4
+//     bytes per vertex, up to a memory budget. A source gets one on its
+//     second miss within BFS_CACHE_RECENT_SOURCES distinct sources, so
+//     one-off sources never pay for a full sweep.
+//
+// A query is answered from the pair cache, else from its source's
+// array, else by a search whose answer is then cached. Hits do no
+// traversal at all. Not thread-safe.
+
+#define BFS_CACHE_RECENT_SOURCES 1024
+
+// Counters over the life of a cache.
+//
+struct bfs_cache_stats {
+    uint64_t lookups;
+    uint64_t pair_hits;
+    uint64_t source_hits;
+    // Full single-source sweeps run to fill a source array.
+    uint64_t source_fills;
+    size_t pair_entries;
+    size_t source_entries;
+    // Bytes allocated by the cache, its workspace included.
+    size_t memory_bytes;
+};
+
+struct bfs_cache;
+
+// Creates a cache for one graph.
+// \param graph          : Pointer to graph, must outlive the cache.
+// \param pair_capacity  : Number of (source, target) results to keep,
+//                         0 for none.
+// \param source_bytes   : Memory budget for source distance arrays in
+//                         bytes, 0 for none.
+// Returns a new cache on success, NULL on failure.
+//
+struct bfs_cache * bfs_cache_create(const struct graph * graph,
+                                    size_t pair_capacity,
+                                    size_t source_bytes);
+
+// Answers whether there is a path from source to target, from the cache
+// when possible.
+// \param cache  : Pointer to cache.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL. Only
+//                 distance is set on a hit; after a fill, the stats are
+//                 those of the full sweep.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_cache_path_exists(struct bfs_cache * cache,
+                           unsigned int source,
+                           unsigned int target,
+                           struct bfs_stats * stats);
+
+// Reads the counters of a cache.
+// \param cache : Pointer to cache.
+// \param stats : Pointer to stats (provided by caller).
+//
+void bfs_cache_get_stats(const struct bfs_cache * cache, struct bfs_cache_stats * stats);
+
+// Frees a cache.
+// \param cache : Cache to free, may be NULL.
+//
+void bfs_cache_delete(struct bfs_cache * cache);
+
+#endif
@@ -0,0 +1,321 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bfs_frontier.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BITS_PER_WORD 64
+
+// Returns the number of words in the bitmap of a frontier.
+static size_t __bfs_frontier_words(const struct bfs_frontier * frontier) {
+    return ((size_t)frontier->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+
+// Moves the queued vertices into the bitmap, allocated on first use.
+static bool __bfs_frontier_to_dense(struct bfs_frontier * frontier) {
+    unsigned int vertex = 0;
+
+    if (frontier->bitmap == NULL) {
+        frontier->bitmap = (uint64_t *)calloc(__bfs_frontier_words(frontier) + 1, sizeof(uint64_t));
+
+        if (frontier->bitmap == NULL) {
+            return false;
+        }
+    }
+
+    while (queue_pop(frontier->queue, &vertex)) {
+        frontier->bitmap[vertex / BITS_PER_WORD] |= 1ull << (vertex % BITS_PER_WORD);
+    }
+
+    frontier->mode = BFS_FRONTIER_MODE_DENSE;
+    frontier->cursor = 0;
+    return true;
+}
+
+// Moves the vertices of the bitmap into the queue, in increasing order,
+// leaving the bitmap clear.
+static bool __bfs_frontier_to_sparse(struct bfs_frontier * frontier) {
+    size_t words = __bfs_frontier_words(frontier);
+
+    for (size_t w = 0; w < words; w++) {
+        uint64_t bits = frontier->bitmap[w];
+
+        while (bits != 0) {
+            if (!queue_push(frontier->queue, (unsigned int)(w * BITS_PER_WORD + (size_t)__builtin_ctzll(bits)))) {
+                return false;
+            }
+            bits &= bits - 1;
+        }
+
+        frontier->bitmap[w] = 0;
+    }
+
+    frontier->mode = BFS_FRONTIER_MODE_SPARSE;
+    frontier->cursor = 0;
+    return true;
+}
+
+// Creates an empty, sparse frontier.
+struct bfs_frontier * bfs_frontier_create(unsigned int vertex_count) {
+    struct bfs_frontier * frontier = (struct bfs_frontier *)calloc(1, sizeof(struct bfs_frontier));
+
+    if (frontier == NULL) {
+        return NULL;
+    }
+
+    frontier->mode = BFS_FRONTIER_MODE_SPARSE;
+    frontier->vertex_count = vertex_count;
+    frontier->queue = queue_create();
+
+    if (frontier->queue == NULL) {
+        free(frontier);
+        return NULL;
+    }
+
+    return frontier;
+}
+
+// Adds a vertex, turning the frontier dense past the threshold.
+bool bfs_frontier_add(struct bfs_frontier * frontier, unsigned int vertex) {
+
+    if (frontier->mode == BFS_FRONTIER_MODE_DENSE) {
+        frontier->bitmap[vertex / BITS_PER_WORD] |= 1ull << (vertex % BITS_PER_WORD);
+        return true;
+    }
+
+    if (!queue_push(frontier->queue, vertex)) {
+        return false;
+    }
+
+    frontier->count += 1;
+
+    if (frontier->count > frontier->vertex_count / BFS_FRONTIER_DENSE) {
+        return __bfs_frontier_to_dense(frontier);
+    }
+
+    return true;
+}
+
+// Takes the oldest (sparse) or lowest (dense) vertex out of the frontier.
+bool bfs_frontier_pop(struct bfs_frontier * frontier, unsigned int * vertex) {
+
+    if (frontier->mode == BFS_FRONTIER_MODE_SPARSE) {
+        if (!queue_pop(frontier->queue, vertex)) {
+            return false;
+        }
+
+        frontier->count -= 1;
+        return true;
+    }
+
+    // Words before the cursor have been emptied by earlier pops.
+    //
+    size_t words = __bfs_frontier_words(frontier);
+    while (frontier->cursor < words && frontier->bitmap[frontier->cursor] == 0) {
+        frontier->cursor += 1;
+    }
+
+    if (frontier->cursor == words) {
+        frontier->cursor = 0;
+        frontier->count = 0;
+        return false;
+    }
+
+    uint64_t * word = &frontier->bitmap[frontier->cursor];
+    *vertex = (unsigned int)(frontier->cursor * BITS_PER_WORD + (size_t)__builtin_ctzll(*word));
+    *word &= *word - 1;
+
+    if (frontier->count != 0) {
+        frontier->count -= 1;
+    }
+
+    return true;
+}
+
+// Recounts a dense frontier and turns it sparse if it has shrunk.
+bool bfs_frontier_adapt(struct bfs_frontier * frontier) {
+
+    if (frontier->mode == BFS_FRONTIER_MODE_SPARSE) {
+        return true;
+    }
+
+    size_t words = __bfs_frontier_words(frontier);
+    size_t count = 0;
+
+    for (size_t w = 0; w < words; w++) {
+        count += (size_t)__builtin_popcountll(frontier->bitmap[w]);
+    }
+
+    frontier->count = count;
+    frontier->cursor = 0;
+
+    if (count < frontier->vertex_count / BFS_FRONTIER_SPARSE) {
+        return __bfs_frontier_to_sparse(frontier);
+    }
+
+    return true;
+}
+
+// Returns the number of vertices in the frontier.
+size_t bfs_frontier_size(const struct bfs_frontier * frontier) {
+    return frontier->count;
+}
+
+// Empties the frontier, keeping its mode.
+void bfs_frontier_clear(struct bfs_frontier * frontier) {
+    unsigned int vertex = 0;
+
+    while (queue_pop(frontier->queue, &vertex)) {
+    }
+
+    if (frontier->bitmap != NULL) {
+        memset(frontier->bitmap, 0, __bfs_frontier_words(frontier) * sizeof(uint64_t));
+    }
+
+    frontier->count = 0;
+    frontier->cursor = 0;
+}
+
+// Frees a frontier.
+void bfs_frontier_delete(struct bfs_frontier * frontier) {
+
+    if (frontier == NULL) {
+        return;
+    }
+
+    queue_delete(frontier->queue);
+    free(frontier->bitmap);
+    free(frontier);
+}
+
+// Answers whether there is a path from source to target, one level at a
+// time from the current frontier into the next.
+bool bfs_adaptive_path_exists(const struct graph * graph,
+                              unsigned int source,
+                              unsigned int target,
+                              struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    size_t words = ((size_t)graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    uint64_t * visited = (uint64_t *)calloc(words, sizeof(uint64_t));
+    struct bfs_frontier * current = bfs_frontier_create(graph->vertex_count);
+    struct bfs_frontier * next = bfs_frontier_create(graph->vertex_count);
+    bool found = false;
+
+    if (visited == NULL || current == NULL || next == NULL) {
+        goto out;
+    }
+
+    visited[source / BITS_PER_WORD] |= 1ull << (source % BITS_PER_WORD);
+    if (!bfs_frontier_add(current, source)) {
+        goto out;
+    }
+    stats->vertices_visited = 1;
+
+    unsigned int depth = 0;
+    while (!found && bfs_frontier_size(current) != 0) {
+        unsigned int vertex = 0;
+        depth += 1;
+
+        if (bfs_frontier_size(current) > stats->peak_queue_size) {
+            stats->peak_queue_size = bfs_frontier_size(current);
+        }
+
+        if (current->mode == BFS_FRONTIER_MODE_DENSE) {
+            stats->dense_levels += 1;
+        }
+
+        while (!found && bfs_frontier_pop(current, &vertex)) {
+            uint64_t end = graph->offsets[vertex + 1];
+
+            for (uint64_t e = graph->offsets[vertex]; e < end; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                uint64_t mask = 1ull << (neighbor % BITS_PER_WORD);
+                stats->edges_traversed += 1;
+
+                if (visited[neighbor / BITS_PER_WORD] & mask) {
+                    continue;
+                }
+
+                visited[neighbor / BITS_PER_WORD] |= mask;
+                stats->vertices_visited += 1;
+
+                if (neighbor == target) {
+                    found = true;
+                    break;
+                }
+
+                // A vertex the frontier could not take would be lost
+                // to the search: fail rather than answer wrongly.
+                //
+                if (!bfs_frontier_add(next, neighbor)) {
+                    goto out;
+                }
+            }
+        }
+
+        if (!bfs_frontier_adapt(next) && !found) {
+            goto out;
+        }
+        if (bfs_frontier_size(next) > stats->peak_queue_size) {
+            stats->peak_queue_size = bfs_frontier_size(next);
+        }
+
+        // Whatever is left of the level when the target turns up.
+        //
+        bfs_frontier_clear(current);
+
+        struct bfs_frontier * swap = current;
+        current = next;
+        next = swap;
+    }
+
+    if (found) {
+        stats->distance = depth;
+    }
+
+out:
+    bfs_frontier_delete(current);
+    bfs_frontier_delete(next);
+    free(visited);
+    return found;
+}
@@ -0,0 +1,131 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _BFS_FRONTIER_H
+#define _BFS_FRONTIER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bfs.h"
+#include "graph.h"
+#include "queue.h"
+
+// A BFS frontier that picks its own representation: a struct queue
+// while it is sparse, a bitmap over all vertices while it is dense. A
+// queue entry costs a list node per vertex and hands vertices out in
+// discovery order; the bitmap costs one bit per vertex of the graph and
+// hands them out in increasing order, so a heavy level walks offsets[]
+// and neighbors[] front to back.
+//
+// The frontier turns dense as soon as it holds more than 1/DENSE of the
+// vertices, where 4 bytes per entry would outweigh the bitmap, and back
+// to sparse in bfs_frontier_adapt() once it holds fewer than 1/SPARSE,
+// the gap keeping a frontier near the threshold from flapping.
+
+#define BFS_FRONTIER_DENSE 32
+#define BFS_FRONTIER_SPARSE 64
+
+enum bfs_frontier_mode {
+    BFS_FRONTIER_MODE_SPARSE,
+    BFS_FRONTIER_MODE_DENSE
+};
+
+// count is exact in sparse mode. In dense mode adds are blind ORs, and
+// count is recomputed with popcount by bfs_frontier_adapt().
+//
+struct bfs_frontier {
+    enum bfs_frontier_mode mode;
+    unsigned int vertex_count;
+    size_t count;
+    struct queue * queue;
+    uint64_t * bitmap;
+    size_t cursor;
+};
+
+// Creates an empty, sparse frontier.
+// PRECONDITION: queue_register_malloc() and queue_register_free() have
+//               been called.
+// \param vertex_count : Number of vertices of the graph.
+// Returns a new frontier on success, NULL on failure.
+//
+struct bfs_frontier * bfs_frontier_create(unsigned int vertex_count);
+
+// Adds a vertex, turning the frontier dense if it has grown past the
+// threshold. The caller makes sure a vertex is added only once per
+// level in sparse mode (e.g. with a visited set).
+// \param frontier : Pointer to frontier.
+// \param vertex   : Vertex to add.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool bfs_frontier_add(struct bfs_frontier * frontier, unsigned int vertex);
+
+// Takes a vertex out of the frontier: the oldest one in sparse mode,
+// the lowest one in dense mode, found with a tzcnt word scan.
+// \param frontier : Pointer to frontier.
+// \param vertex   : Set to the vertex taken.
+// Returns TRUE if there was one, FALSE if the frontier is empty.
+//
+bool bfs_frontier_pop(struct bfs_frontier * frontier, unsigned int * vertex);
+
+// Brings the count up to date after a level of adds, and turns a dense
+// frontier that has shrunk below the threshold back into a queue.
+// \param frontier : Pointer to frontier.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool bfs_frontier_adapt(struct bfs_frontier * frontier);
+
+// Returns the number of vertices in the frontier, see struct
+// bfs_frontier for when it is exact.
+// \param frontier : Pointer to frontier.
+//
+size_t bfs_frontier_size(const struct bfs_frontier * frontier);
+
+// Empties the frontier, keeping its mode.
+// \param frontier : Pointer to frontier.
+//
+void bfs_frontier_clear(struct bfs_frontier * frontier);
+
+// Frees a frontier.
+// \param frontier : Frontier to free, may be NULL.
+//
+void bfs_frontier_delete(struct bfs_frontier * frontier);
+
+// Answers the same question as bfs_path_exists() with a pair of
+// adaptive frontiers in place of the queue.
+// \param graph  : Pointer to graph.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL.
+//                 stats->dense_levels counts the levels expanded from a
+//                 dense frontier.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_adaptive_path_exists(const struct graph * graph,
+                              unsigned int source,
+                              unsigned int target,
+                              struct bfs_stats * stats);
+
+#endif
@@ -0,0 +1,203 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bfs_multi_source.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BITS_PER_WORD 64
+#define WORDS BFS_MULTI_SOURCE_WORDS
+
+// Sets of lanes, one bit per search.
+typedef uint64_t bfs_lanes[WORDS];
+
+// Marks the queries whose target has been seen as answered at depth.
+static void __bfs_multi_source_check(struct bfs_query * queries,
+                                     size_t count,
+                                     const uint64_t * seen,
+                                     uint64_t * pending,
+                                     unsigned int depth) {
+    for (size_t i = 0; i < count; i++) {
+        size_t word = i / BITS_PER_WORD;
+        uint64_t bit = 1ull << (i % BITS_PER_WORD);
+
+        if ((pending[word] & bit) && (seen[(size_t)queries[i].target * WORDS + word] & bit)) {
+            queries[i].distance = depth;
+            pending[word] &= ~bit;
+        }
+    }
+}
+
+// Returns whether any lane is set.
+static inline bool __bfs_multi_source_any(const uint64_t * lanes) {
+    uint64_t any = 0;
+
+    for (int w = 0; w < WORDS; w++) {
+        any |= lanes[w];
+    }
+
+    return any != 0;
+}
+
+// Runs up to BFS_MULTI_SOURCE_LANES searches together. The bitsets must
+// be zero on entry; frontier and next are zero again on return.
+static void __bfs_multi_source_sweep(const struct graph * graph,
+                                     struct bfs_query * queries,
+                                     size_t count,
+                                     uint64_t * seen,
+                                     uint64_t * frontier,
+                                     uint64_t * next,
+                                     struct bfs_stats * stats) {
+    bfs_lanes pending = {0};
+
+    for (size_t i = 0; i < count; i++) {
+        size_t word = i / BITS_PER_WORD;
+        uint64_t bit = 1ull << (i % BITS_PER_WORD);
+
+        queries[i].distance = BFS_UNREACHABLE;
+        if (queries[i].source >= graph->vertex_count || queries[i].target >= graph->vertex_count) {
+            continue;
+        }
+
+        seen[(size_t)queries[i].source * WORDS + word] |= bit;
+        frontier[(size_t)queries[i].source * WORDS + word] |= bit;
+        pending[word] |= bit;
+        stats->vertices_visited += 1;
+    }
+
+    __bfs_multi_source_check(queries, count, seen, pending, 0);
+
+    for (unsigned int depth = 1; __bfs_multi_source_any(pending); depth++) {
+        size_t frontier_vertices = 0;
+        uint64_t discovered = 0;
+
+        for (unsigned int v = 0; v < graph->vertex_count; v++) {
+            uint64_t * visit = &frontier[(size_t)v * WORDS];
+            bfs_lanes active;
+            uint64_t any = 0;
+
+            // Searches that are already answered stop expanding. The
+            // frontier is cleared as it is consumed, so that it can be
+            // reused as the next level's next-frontier.
+            //
+            for (int w = 0; w < WORDS; w++) {
+                active[w] = visit[w] & pending[w];
+                any |= visit[w];
+            }
+
+            if (any == 0) {
+                continue;
+            }
+
+            memset(visit, 0, sizeof(bfs_lanes));
+            if (!__bfs_multi_source_any(active)) {
+                continue;
+            }
+
+            frontier_vertices += 1;
+
+            uint64_t end = graph->offsets[v + 1];
+            for (uint64_t e = graph->offsets[v]; e < end; e++) {
+                size_t neighbor = (size_t)graph->neighbors[e] * WORDS;
+
+                for (int w = 0; w < WORDS; w++) {
+                    uint64_t fresh = active[w] & ~seen[neighbor + w];
+
+                    next[neighbor + w] |= fresh;
+                    seen[neighbor + w] |= fresh;
+                    discovered += (uint64_t)__builtin_popcountll(fresh);
+                }
+            }
+
+            stats->edges_traversed += end - graph->offsets[v];
+        }
+
+        if (frontier_vertices > stats->peak_queue_size) {
+            stats->peak_queue_size = frontier_vertices;
+        }
+
+        if (discovered == 0) {
+            break;
+        }
+
+        stats->vertices_visited += discovered;
+        __bfs_multi_source_check(queries, count, seen, pending, depth);
+
+        uint64_t * swap = frontier;
+        frontier = next;
+        next = swap;
+    }
+
+    // Searches that stopped early leave bits in the last next-frontier.
+    //
+    memset(frontier, 0, (size_t)graph->vertex_count * WORDS * sizeof(uint64_t));
+    memset(next, 0, (size_t)graph->vertex_count * WORDS * sizeof(uint64_t));
+}
+
+// Answers a batch of path queries, BFS_MULTI_SOURCE_LANES at a time.
+bool bfs_multi_source_batch(const struct graph * graph,
+                            struct bfs_query * queries,
+                            size_t count,
+                            struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (graph == NULL || (queries == NULL && count != 0)) {
+        return false;
+    }
+
+    size_t words = ((size_t)graph->vertex_count + 1) * WORDS;
+    uint64_t * seen = (uint64_t *)calloc(words, sizeof(uint64_t));
+    uint64_t * frontier = (uint64_t *)calloc(words, sizeof(uint64_t));
+    uint64_t * next = (uint64_t *)calloc(words, sizeof(uint64_t));
+
+    if (seen == NULL || frontier == NULL || next == NULL) {
+        free(seen);
+        free(frontier);
+        free(next);
+        return false;
+    }
+
+    for (size_t first = 0; first < count; first += BFS_MULTI_SOURCE_LANES) {
+        size_t lanes = (count - first < BFS_MULTI_SOURCE_LANES) ? count - first : BFS_MULTI_SOURCE_LANES;
+
+        if (first != 0) {
+            memset(seen, 0, words * sizeof(uint64_t));
+        }
+
+        __bfs_multi_source_sweep(graph, queries + first, lanes, seen, frontier, next, stats);
+    }
+
+    free(seen);
+    free(frontier);
+    free(next);
+    return true;
+}
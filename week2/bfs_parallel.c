@@ -0,0 +1,435 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bfs_parallel.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BITS_PER_WORD 64
+#define CACHE_LINE_BYTES 64
+
+// Frontier vertices claimed at a time. Small enough to balance levels
+// dominated by a few hubs, large enough to keep the shared cursor cold.
+#define BFS_PARALLEL_CHUNK 64
+
+// Per-thread state, padded to a cache line so that the counters of
+// neighboring threads do not share one.
+struct bfs_pool_thread {
+    pthread_t thread;
+    struct bfs_pool * pool;
+    unsigned int id;
+    unsigned int * next;
+    size_t next_count;
+    size_t next_capacity;
+    size_t next_offset;
+    uint64_t edges_traversed;
+    bool failed;
+} __attribute__((aligned(CACHE_LINE_BYTES)));
+
+struct bfs_pool {
+    unsigned int thread_count;
+    struct bfs_pool_thread * threads;
+    pthread_barrier_t barrier;
+    bool shutdown;
+
+    // Threads are parked on this until all of them have been created.
+    pthread_mutex_t mutex;
+    pthread_cond_t started_cond;
+    bool started;
+
+    // The current search. Frontier arrays alternate between levels:
+    // level d is read from frontiers[d & 1] and level d + 1 is written
+    // to the other one.
+    const struct graph * graph;
+    unsigned int source;
+    unsigned int target;
+    _Atomic uint64_t * visited;
+    unsigned int * frontiers[2];
+    unsigned int capacity;
+    size_t frontier_size;
+    _Atomic size_t cursor __attribute__((aligned(CACHE_LINE_BYTES)));
+    atomic_bool found __attribute__((aligned(CACHE_LINE_BYTES)));
+    bool done;
+    bool failed;
+    unsigned int depth;
+    size_t peak_frontier_size;
+    uint64_t vertices_visited;
+};
+
+// Appends a vertex to a thread's next-frontier buffer.
+static inline bool __bfs_parallel_push(struct bfs_pool_thread * t, unsigned int vertex) {
+    if (t->next_count == t->next_capacity) {
+        size_t capacity = t->next_capacity == 0 ? 1024 : t->next_capacity * 2;
+        unsigned int * next = realloc(t->next, capacity * sizeof(unsigned int));
+
+        if (next == NULL) {
+            return false;
+        }
+
+        t->next = next;
+        t->next_capacity = capacity;
+    }
+
+    t->next[t->next_count] = vertex;
+    t->next_count += 1;
+    return true;
+}
+
+// Claims a vertex, returns whether this thread was the one to set its bit.
+static inline bool __bfs_parallel_claim(_Atomic uint64_t * visited, unsigned int vertex) {
+    uint64_t mask = 1ull << (vertex % BITS_PER_WORD);
+    _Atomic uint64_t * word = &visited[vertex / BITS_PER_WORD];
+
+    // Most edges lead to vertices that are already visited, and a plain
+    // load keeps the line shared instead of pulling it in exclusive.
+    //
+    if (atomic_load_explicit(word, memory_order_relaxed) & mask) {
+        return false;
+    }
+
+    return (atomic_fetch_or_explicit(word, mask, memory_order_relaxed) & mask) == 0;
+}
+
+// Expands the current level: claims chunks of the frontier until it is
+// exhausted or the target has been found.
+static void __bfs_parallel_expand(struct bfs_pool_thread * t) {
+    struct bfs_pool * pool = t->pool;
+    const struct graph * graph = pool->graph;
+    const unsigned int * frontier = pool->frontiers[pool->depth & 1];
+
+    t->next_count = 0;
+
+    while (!atomic_load_explicit(&pool->found, memory_order_relaxed)) {
+        size_t begin = atomic_fetch_add_explicit(&pool->cursor, BFS_PARALLEL_CHUNK, memory_order_relaxed);
+        if (begin >= pool->frontier_size) {
+            return;
+        }
+
+        size_t end = begin + BFS_PARALLEL_CHUNK;
+        if (end > pool->frontier_size) {
+            end = pool->frontier_size;
+        }
+
+        for (size_t i = begin; i < end; i++) {
+            unsigned int vertex = frontier[i];
+            uint64_t last = graph->offsets[vertex + 1];
+
+            t->edges_traversed += last - graph->offsets[vertex];
+
+            for (uint64_t e = graph->offsets[vertex]; e < last; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+
+                if (!__bfs_parallel_claim(pool->visited, neighbor)) {
+                    continue;
+                }
+
+                if (neighbor == pool->target || !__bfs_parallel_push(t, neighbor)) {
+                    t->failed = (neighbor != pool->target);
+                    t->edges_traversed -= last - e - 1;
+                    atomic_store_explicit(&pool->found, true, memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Runs one search. Every thread of the pool calls this together.
+static void __bfs_parallel_search(struct bfs_pool_thread * t) {
+    struct bfs_pool * pool = t->pool;
+    size_t words = ((size_t)pool->graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    size_t first = words * t->id / pool->thread_count;
+    size_t last = words * (t->id + 1) / pool->thread_count;
+
+    for (size_t w = first; w < last; w++) {
+        atomic_store_explicit(&pool->visited[w], 0, memory_order_relaxed);
+    }
+    t->edges_traversed = 0;
+    t->failed = false;
+    pthread_barrier_wait(&pool->barrier);
+
+    if (t->id == 0) {
+        __bfs_parallel_claim(pool->visited, pool->source);
+        pool->frontiers[0][0] = pool->source;
+        pool->frontier_size = 1;
+        pool->peak_frontier_size = 1;
+        pool->vertices_visited = 1;
+        pool->depth = 0;
+        pool->done = false;
+        pool->failed = false;
+        atomic_store(&pool->cursor, 0);
+        atomic_store(&pool->found, false);
+    }
+    pthread_barrier_wait(&pool->barrier);
+
+    while (true) {
+        __bfs_parallel_expand(t);
+        pthread_barrier_wait(&pool->barrier);
+
+        // Lay the next-frontier buffers out back to back, on one thread:
+        // it is a loop over threads, not vertices.
+        //
+        if (t->id == 0) {
+            size_t total = 0;
+
+            for (unsigned int i = 0; i < pool->thread_count; i++) {
+                pool->threads[i].next_offset = total;
+                total += pool->threads[i].next_count;
+                pool->failed |= pool->threads[i].failed;
+            }
+
+            pool->depth += 1;
+            pool->vertices_visited += total + atomic_load(&pool->found);
+            pool->frontier_size = total;
+            pool->done = atomic_load(&pool->found) || total == 0;
+            atomic_store(&pool->cursor, 0);
+
+            if (total > pool->peak_frontier_size) {
+                pool->peak_frontier_size = total;
+            }
+        }
+        pthread_barrier_wait(&pool->barrier);
+
+        if (pool->done) {
+            return;
+        }
+
+        memcpy(pool->frontiers[pool->depth & 1] + t->next_offset, t->next,
+               t->next_count * sizeof(unsigned int));
+        pthread_barrier_wait(&pool->barrier);
+    }
+}
+
+static void * __bfs_pool_thread_main(void * arg) {
+    struct bfs_pool_thread * t = (struct bfs_pool_thread *)arg;
+    struct bfs_pool * pool = t->pool;
+
+    pthread_mutex_lock(&pool->mutex);
+    while (!pool->started && !pool->shutdown) {
+        pthread_cond_wait(&pool->started_cond, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (!pool->started) {
+        return NULL;
+    }
+
+    // bfs_pool_delete() raises shutdown, then waits on the barrier:
+    // only check it once past the barrier.
+    //
+    while (true) {
+        pthread_barrier_wait(&pool->barrier);
+
+        if (pool->shutdown) {
+            return NULL;
+        }
+
+        __bfs_parallel_search(t);
+    }
+
+    return NULL;
+}
+
+// Makes room for searches over a graph of vertex_count vertices.
+static bool __bfs_pool_reserve(struct bfs_pool * pool, unsigned int vertex_count) {
+    if (vertex_count <= pool->capacity && pool->visited != NULL) {
+        return true;
+    }
+
+    size_t words = ((size_t)vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    _Atomic uint64_t * visited = malloc((words == 0 ? 1 : words) * sizeof(uint64_t));
+    unsigned int * frontier = malloc(((size_t)vertex_count + 1) * sizeof(unsigned int));
+    unsigned int * next_frontier = malloc(((size_t)vertex_count + 1) * sizeof(unsigned int));
+
+    if (visited == NULL || frontier == NULL || next_frontier == NULL) {
+        free((void *)visited);
+        free(frontier);
+        free(next_frontier);
+        return false;
+    }
+
+    free((void *)pool->visited);
+    free(pool->frontiers[0]);
+    free(pool->frontiers[1]);
+    pool->visited = visited;
+    pool->frontiers[0] = frontier;
+    pool->frontiers[1] = next_frontier;
+    pool->capacity = vertex_count;
+    return true;
+}
+
+// Starts a pool of BFS threads.
+struct bfs_pool * bfs_pool_create(unsigned int threads) {
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1;
+    }
+    if (threads > BFS_PARALLEL_MAX_THREADS) {
+        threads = BFS_PARALLEL_MAX_THREADS;
+    }
+
+    struct bfs_pool * pool = (struct bfs_pool *)aligned_alloc(CACHE_LINE_BYTES, sizeof(struct bfs_pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    memset(pool, 0, sizeof(*pool));
+
+    pool->threads = (struct bfs_pool_thread *)aligned_alloc(CACHE_LINE_BYTES,
+                                                            threads * sizeof(struct bfs_pool_thread));
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
+    memset(pool->threads, 0, threads * sizeof(struct bfs_pool_thread));
+
+    pool->thread_count = threads;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->started_cond, NULL);
+
+    for (unsigned int i = 0; i < threads; i++) {
+        pool->threads[i].pool = pool;
+        pool->threads[i].id = i;
+    }
+
+    // The barrier counts every thread, so the pool only starts once all
+    // of them exist. Otherwise the ones created are told to exit.
+    //
+    unsigned int created = 1;
+    while (created < threads &&
+           pthread_create(&pool->threads[created].thread, NULL, __bfs_pool_thread_main,
+                          &pool->threads[created]) == 0) {
+        created++;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    if (created == threads) {
+        pthread_barrier_init(&pool->barrier, NULL, threads);
+        pool->started = true;
+    } else {
+        pool->shutdown = true;
+    }
+    pthread_cond_broadcast(&pool->started_cond);
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (!pool->started) {
+        for (unsigned int i = 1; i < created; i++) {
+            pthread_join(pool->threads[i].thread, NULL);
+        }
+        pthread_cond_destroy(&pool->started_cond);
+        pthread_mutex_destroy(&pool->mutex);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+// Returns the number of threads taking part in each search.
+unsigned int bfs_pool_threads(const struct bfs_pool * pool) {
+    return pool == NULL ? 0 : pool->thread_count;
+}
+
+// Answers whether there is a path from source to target on all threads.
+bool bfs_parallel_path_exists(struct bfs_pool * pool,
+                              const struct graph * graph,
+                              unsigned int source,
+                              unsigned int target,
+                              struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (pool == NULL || graph == NULL || source >= graph->vertex_count || target >= graph->vertex_count) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    if (!__bfs_pool_reserve(pool, graph->vertex_count)) {
+        return false;
+    }
+
+    pool->graph = graph;
+    pool->source = source;
+    pool->target = target;
+
+    pthread_barrier_wait(&pool->barrier);
+    __bfs_parallel_search(&pool->threads[0]);
+
+    if (pool->failed) {
+        return false;
+    }
+
+    bool found = atomic_load(&pool->found);
+    for (unsigned int i = 0; i < pool->thread_count; i++) {
+        stats->edges_traversed += pool->threads[i].edges_traversed;
+    }
+    stats->vertices_visited = pool->vertices_visited;
+    stats->peak_queue_size = pool->peak_frontier_size;
+    stats->distance = found ? pool->depth : BFS_UNREACHABLE;
+
+    return found;
+}
+
+// Stops the threads of a pool and frees it.
+void bfs_pool_delete(struct bfs_pool * pool) {
+
+    if (pool == NULL) {
+        return;
+    }
+
+    pool->shutdown = true;
+    pthread_barrier_wait(&pool->barrier);
+
+    for (unsigned int i = 1; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i].thread, NULL);
+    }
+
+    for (unsigned int i = 0; i < pool->thread_count; i++) {
+        free(pool->threads[i].next);
+    }
+
+    pthread_barrier_destroy(&pool->barrier);
+    pthread_cond_destroy(&pool->started_cond);
+    pthread_mutex_destroy(&pool->mutex);
+    free((void *)pool->visited);
+    free(pool->frontiers[0]);
+    free(pool->frontiers[1]);
+    free(pool->threads);
+    free(pool);
+}
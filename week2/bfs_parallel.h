@@ -0,0 +1,80 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _BFS_PARALLEL_H
+#define _BFS_PARALLEL_H
+
+#include <stdbool.h>
+
+#include "bfs.h"
+#include "graph.h"
+
+// Level-synchronous BFS on a pool of threads. Each level's frontier is
+// an array that the threads claim in chunks; newly discovered vertices
+// are claimed with an atomic OR on a shared visited bitmap and appended
+// to a per-thread next-frontier buffer, and the buffers are concatenated
+// into the next level's array at the level barrier.
+//
+// struct queue is not used here: its node pool is not thread safe.
+// Unlike bfs_path_exists() no queue_register_*() calls are needed.
+
+#define BFS_PARALLEL_MAX_THREADS 256
+
+struct bfs_pool;
+
+// Starts a pool of BFS threads. The calling thread takes part in every
+// search, so a pool of N threads starts N - 1 new ones.
+// \param threads : Number of threads, 0 for one per online CPU.
+// Returns a new pool on success, NULL on failure.
+//
+struct bfs_pool * bfs_pool_create(unsigned int threads);
+
+// Returns the number of threads taking part in each search.
+// \param pool : Pointer to pool.
+//
+unsigned int bfs_pool_threads(const struct bfs_pool * pool);
+
+// Answers whether there is a path from source to target, like
+// bfs_path_exists(), searching each level on every thread of the pool.
+// A pool runs one search at a time: calls must not overlap.
+// \param pool   : Pointer to pool.
+// \param graph  : Pointer to graph.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// \param stats  : Pointer to stats (provided by caller), or NULL.
+//                 stats->peak_queue_size is the largest frontier.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input).
+//
+bool bfs_parallel_path_exists(struct bfs_pool * pool,
+                              const struct graph * graph,
+                              unsigned int source,
+                              unsigned int target,
+                              struct bfs_stats * stats);
+
+// Stops the threads of a pool and frees it.
+// \param pool : Pool to delete, may be NULL.
+//
+void bfs_pool_delete(struct bfs_pool * pool);
+
+#endif
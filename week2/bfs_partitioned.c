@@ -0,0 +1,719 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "bfs_partitioned.h"
+
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BITS_PER_WORD 64
+#define CACHE_LINE_BYTES 64
+
+// Waits between liveness checks. A waiting process yields for the first
+// of them, then sleeps BFS_PARTITIONED_PAUSE_NS at a time.
+#define BFS_PARTITIONED_LIVENESS_SPINS 64
+#define BFS_PARTITIONED_PAUSE_NS 20000
+
+enum bfs_partitioned_command {
+    BFS_PARTITIONED_SEARCH,
+    BFS_PARTITIONED_SHUTDOWN
+};
+
+// A ring from one worker to another. Only the consumer writes head and
+// only the producer writes tail, each on a cache line of its own.
+struct bfs_partitioned_queue {
+    _Atomic size_t head __attribute__((aligned(CACHE_LINE_BYTES)));
+    _Atomic size_t tail __attribute__((aligned(CACHE_LINE_BYTES)));
+    unsigned int vertices[BFS_PARTITIONED_QUEUE_CAPACITY] __attribute__((aligned(CACHE_LINE_BYTES)));
+};
+
+// A barrier in shared memory. Unlike a process-shared pthread_barrier_t,
+// a process waiting at it can give up when another one has died.
+struct bfs_partitioned_barrier {
+    _Atomic unsigned int arrived;
+    _Atomic unsigned int generation;
+};
+
+// What a worker publishes at the end of each level, and of its start.
+struct bfs_partitioned_slot {
+    size_t next_size;
+    bool found;
+    bool failed;
+    uint64_t edges_traversed;
+    uint64_t vertices_visited;
+    uint64_t vertices_sent;
+} __attribute__((aligned(CACHE_LINE_BYTES)));
+
+// The part of a partitioned search every process maps.
+struct bfs_partitioned_shared {
+    // The parent and every worker meet at command_barrier twice per
+    // search: to start it and once it is over.
+    struct bfs_partitioned_barrier command_barrier;
+    struct bfs_partitioned_barrier level_barrier;
+    // Raised once a process of the search is found dead: every wait
+    // gives up, and every later search fails.
+    atomic_bool aborted;
+    enum bfs_partitioned_command command;
+    unsigned int source;
+    unsigned int target;
+
+    // Workers that are done sending for the current level, counted from
+    // the start of the search.
+    _Atomic unsigned int senders_done __attribute__((aligned(CACHE_LINE_BYTES)));
+
+    // Written by worker 0 at the end of a search.
+    bool found;
+    unsigned int distance;
+    size_t peak_frontier_size;
+
+    struct bfs_partitioned_slot slots[BFS_PARTITIONED_MAX_WORKERS];
+};
+
+struct bfs_partitioned {
+    const struct graph * graph;
+    unsigned int worker_count;
+    // Worker w owns vertices bounds[w] .. bounds[w + 1] - 1.
+    unsigned int bounds[BFS_PARTITIONED_MAX_WORKERS + 1];
+    // 0 once a worker has been reaped.
+    pid_t pids[BFS_PARTITIONED_MAX_WORKERS];
+    pid_t parent;
+    // Set in each worker's copy, after the fork().
+    bool in_worker;
+    void * mapping;
+    size_t mapping_length;
+    struct bfs_partitioned_shared * shared;
+    // The ring from worker f to worker t is queues[f * worker_count + t].
+    struct bfs_partitioned_queue * queues;
+    uint64_t vertices_exchanged;
+};
+
+// State private to one worker process.
+struct bfs_partitioned_worker {
+    struct bfs_partitioned * partitioned;
+    struct bfs_partitioned_shared * shared;
+    unsigned int id;
+    unsigned int first;
+    unsigned int vertex_count;
+    // The worker's rows of the CSR, offsets rebased to its neighbors.
+    uint64_t * offsets;
+    unsigned int * neighbors;
+    // Visited bits of its own vertices, and sent bits of everyone else's.
+    uint64_t * visited;
+    uint64_t * sent;
+    unsigned int * frontier;
+    unsigned int * next;
+    size_t frontier_size;
+    size_t next_size;
+    // Head of each outgoing ring as last read, to only reload it when
+    // the ring looks full.
+    size_t heads[BFS_PARTITIONED_MAX_WORKERS];
+    unsigned int target;
+    bool found;
+    uint64_t edges_traversed;
+    uint64_t vertices_visited;
+    uint64_t vertices_sent;
+};
+
+// Returns the worker owning a vertex.
+static inline unsigned int __bfs_partitioned_owner(const struct bfs_partitioned * partitioned, unsigned int vertex) {
+    unsigned int low = 0;
+    unsigned int high = partitioned->worker_count;
+
+    while (high - low > 1) {
+        unsigned int middle = low + (high - low) / 2;
+
+        if (vertex >= partitioned->bounds[middle]) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+// Returns FALSE once a process of the search has died: the parent reaps
+// dead workers, a worker checks that its parent is still there.
+static bool __bfs_partitioned_alive(struct bfs_partitioned * partitioned) {
+    struct bfs_partitioned_shared * shared = partitioned->shared;
+    bool alive = true;
+
+    if (atomic_load_explicit(&shared->aborted, memory_order_relaxed)) {
+        return false;
+    }
+
+    if (partitioned->in_worker) {
+        alive = getppid() == partitioned->parent;
+    } else {
+        for (unsigned int w = 0; w < partitioned->worker_count; w++) {
+            if (partitioned->pids[w] != 0 && waitpid(partitioned->pids[w], NULL, WNOHANG) == partitioned->pids[w]) {
+                partitioned->pids[w] = 0;
+                alive = false;
+            }
+        }
+    }
+
+    if (!alive) {
+        atomic_store(&shared->aborted, true);
+    }
+
+    return alive;
+}
+
+// Waits a little for the other processes, checking now and then that
+// they are alive. Returns FALSE if one has died.
+static bool __bfs_partitioned_pause(struct bfs_partitioned * partitioned, unsigned int * spins) {
+    *spins += 1;
+
+    if (*spins % BFS_PARTITIONED_LIVENESS_SPINS == 0 && !__bfs_partitioned_alive(partitioned)) {
+        return false;
+    }
+
+    if (*spins < BFS_PARTITIONED_LIVENESS_SPINS) {
+        sched_yield();
+    } else {
+        struct timespec pause = {.tv_sec = 0, .tv_nsec = BFS_PARTITIONED_PAUSE_NS};
+        nanosleep(&pause, NULL);
+    }
+
+    return !atomic_load_explicit(&partitioned->shared->aborted, memory_order_relaxed);
+}
+
+// Waits until parties processes have reached the barrier. Returns FALSE
+// if a process of the search died meanwhile.
+static bool __bfs_partitioned_barrier_wait(struct bfs_partitioned * partitioned,
+                                           struct bfs_partitioned_barrier * barrier,
+                                           unsigned int parties) {
+    unsigned int generation = atomic_load_explicit(&barrier->generation, memory_order_acquire);
+
+    if (atomic_fetch_add_explicit(&barrier->arrived, 1, memory_order_acq_rel) + 1 == parties) {
+        atomic_store_explicit(&barrier->arrived, 0, memory_order_relaxed);
+        atomic_fetch_add_explicit(&barrier->generation, 1, memory_order_release);
+        return true;
+    }
+
+    unsigned int spins = 0;
+    while (atomic_load_explicit(&barrier->generation, memory_order_acquire) == generation) {
+        if (!__bfs_partitioned_pause(partitioned, &spins)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Claims one of the worker's own vertices for the next frontier.
+static inline void __bfs_partitioned_claim(struct bfs_partitioned_worker * w, unsigned int vertex) {
+    unsigned int local = vertex - w->first;
+    uint64_t mask = 1ull << (local % BITS_PER_WORD);
+
+    if (w->visited[local / BITS_PER_WORD] & mask) {
+        return;
+    }
+
+    w->visited[local / BITS_PER_WORD] |= mask;
+    w->next[w->next_size] = vertex;
+    w->next_size += 1;
+    w->vertices_visited += 1;
+    w->found |= (vertex == w->target);
+}
+
+// Claims every vertex waiting in the worker's incoming rings.
+static void __bfs_partitioned_drain(struct bfs_partitioned_worker * w) {
+    struct bfs_partitioned * partitioned = w->partitioned;
+
+    for (unsigned int from = 0; from < partitioned->worker_count; from++) {
+        if (from == w->id) {
+            continue;
+        }
+
+        struct bfs_partitioned_queue * queue = &partitioned->queues[from * partitioned->worker_count + w->id];
+        size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+        for (size_t i = head; i != tail; i++) {
+            __bfs_partitioned_claim(w, queue->vertices[i % BFS_PARTITIONED_QUEUE_CAPACITY]);
+        }
+
+        atomic_store_explicit(&queue->head, tail, memory_order_release);
+    }
+}
+
+// Sends a vertex to the worker owning it, draining the incoming rings
+// while the outgoing one is full. Returns FALSE if a process died.
+static bool __bfs_partitioned_send(struct bfs_partitioned_worker * w, unsigned int to, unsigned int vertex) {
+    struct bfs_partitioned * partitioned = w->partitioned;
+    struct bfs_partitioned_queue * queue = &partitioned->queues[w->id * partitioned->worker_count + to];
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    unsigned int spins = 0;
+
+    while (tail - w->heads[to] == BFS_PARTITIONED_QUEUE_CAPACITY) {
+        w->heads[to] = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+        if (tail - w->heads[to] == BFS_PARTITIONED_QUEUE_CAPACITY) {
+            __bfs_partitioned_drain(w);
+            if (!__bfs_partitioned_pause(partitioned, &spins)) {
+                return false;
+            }
+        }
+    }
+
+    queue->vertices[tail % BFS_PARTITIONED_QUEUE_CAPACITY] = vertex;
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    w->vertices_sent += 1;
+    return true;
+}
+
+// Expands the worker's frontier: its own neighbors are claimed, the
+// others' are sent to them once per search. Returns FALSE if a process
+// died.
+static bool __bfs_partitioned_expand(struct bfs_partitioned_worker * w) {
+    struct bfs_partitioned * partitioned = w->partitioned;
+
+    for (size_t i = 0; i < w->frontier_size && !w->found; i++) {
+        unsigned int local = w->frontier[i] - w->first;
+        uint64_t last = w->offsets[local + 1];
+
+        for (uint64_t e = w->offsets[local]; e < last; e++) {
+            unsigned int neighbor = w->neighbors[e];
+            w->edges_traversed += 1;
+
+            if (neighbor - w->first < w->vertex_count) {
+                __bfs_partitioned_claim(w, neighbor);
+                if (w->found) {
+                    break;
+                }
+                continue;
+            }
+
+            uint64_t mask = 1ull << (neighbor % BITS_PER_WORD);
+            if (w->sent[neighbor / BITS_PER_WORD] & mask) {
+                continue;
+            }
+
+            w->sent[neighbor / BITS_PER_WORD] |= mask;
+            if (!__bfs_partitioned_send(w, __bfs_partitioned_owner(partitioned, neighbor), neighbor)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Runs one search on a worker. Every worker calls this together.
+// Returns FALSE if a process died.
+static bool __bfs_partitioned_search(struct bfs_partitioned_worker * w) {
+    struct bfs_partitioned * partitioned = w->partitioned;
+    struct bfs_partitioned_shared * shared = w->shared;
+    struct bfs_partitioned_slot * slot = &shared->slots[w->id];
+    unsigned int workers = partitioned->worker_count;
+    unsigned int source = shared->source;
+
+    memset(w->visited, 0, ((size_t)w->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD * sizeof(uint64_t));
+    memset(w->sent, 0, ((size_t)partitioned->graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD * sizeof(uint64_t));
+    w->target = shared->target;
+    w->found = false;
+    w->edges_traversed = 0;
+    w->vertices_visited = 0;
+    w->vertices_sent = 0;
+    w->next_size = 0;
+
+    if (source - w->first < w->vertex_count) {
+        __bfs_partitioned_claim(w, source);
+    }
+
+    size_t peak_frontier_size = 1;
+    unsigned int depth = 0;
+
+    while (true) {
+        unsigned int * frontier = w->next;
+        w->next = w->frontier;
+        w->frontier = frontier;
+        w->frontier_size = w->next_size;
+        w->next_size = 0;
+
+        if (!__bfs_partitioned_expand(w)) {
+            return false;
+        }
+
+        // A worker waiting for the others to finish sending keeps
+        // draining, as they may be blocked on a ring to it.
+        //
+        unsigned int done = workers * (depth + 1);
+        unsigned int spins = 0;
+        atomic_fetch_add_explicit(&shared->senders_done, 1, memory_order_release);
+        while (atomic_load_explicit(&shared->senders_done, memory_order_acquire) < done) {
+            __bfs_partitioned_drain(w);
+            if (!__bfs_partitioned_pause(partitioned, &spins)) {
+                return false;
+            }
+        }
+        __bfs_partitioned_drain(w);
+
+        slot->next_size = w->next_size;
+        slot->found = w->found;
+        if (!__bfs_partitioned_barrier_wait(partitioned, &shared->level_barrier, workers)) {
+            return false;
+        }
+
+        size_t total = 0;
+        bool found = false;
+        for (unsigned int i = 0; i < workers; i++) {
+            total += shared->slots[i].next_size;
+            found |= shared->slots[i].found;
+        }
+
+        depth += 1;
+        if (total > peak_frontier_size) {
+            peak_frontier_size = total;
+        }
+
+        if (found || total == 0) {
+            if (w->id == 0) {
+                shared->found = found;
+                shared->distance = found ? depth : BFS_UNREACHABLE;
+                shared->peak_frontier_size = peak_frontier_size;
+            }
+            break;
+        }
+    }
+
+    slot->edges_traversed = w->edges_traversed;
+    slot->vertices_visited = w->vertices_visited;
+    slot->vertices_sent = w->vertices_sent;
+    return true;
+}
+
+// Copies a worker's rows of the graph and allocates its search state.
+static bool __bfs_partitioned_worker_init(struct bfs_partitioned_worker * w,
+                                          struct bfs_partitioned * partitioned,
+                                          unsigned int id) {
+    const struct graph * graph = partitioned->graph;
+
+    memset(w, 0, sizeof(*w));
+    w->partitioned = partitioned;
+    w->shared = partitioned->shared;
+    w->id = id;
+    w->first = partitioned->bounds[id];
+    w->vertex_count = partitioned->bounds[id + 1] - w->first;
+
+    uint64_t first_edge = graph->offsets[w->first];
+    uint64_t edge_count = graph->offsets[w->first + w->vertex_count] - first_edge;
+    size_t visited_words = ((size_t)w->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    size_t sent_words = ((size_t)graph->vertex_count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    w->offsets = (uint64_t *)malloc(((size_t)w->vertex_count + 1) * sizeof(uint64_t));
+    w->neighbors = (unsigned int *)malloc((edge_count == 0 ? 1 : edge_count) * sizeof(unsigned int));
+    w->visited = (uint64_t *)malloc((visited_words == 0 ? 1 : visited_words) * sizeof(uint64_t));
+    w->sent = (uint64_t *)malloc((sent_words == 0 ? 1 : sent_words) * sizeof(uint64_t));
+    w->frontier = (unsigned int *)malloc(((size_t)w->vertex_count + 1) * sizeof(unsigned int));
+    w->next = (unsigned int *)malloc(((size_t)w->vertex_count + 1) * sizeof(unsigned int));
+
+    if (w->offsets == NULL || w->neighbors == NULL || w->visited == NULL || w->sent == NULL ||
+        w->frontier == NULL || w->next == NULL) {
+        return false;
+    }
+
+    for (unsigned int v = 0; v <= w->vertex_count; v++) {
+        w->offsets[v] = graph->offsets[w->first + v] - first_edge;
+    }
+    memcpy(w->neighbors, graph->neighbors + first_edge, edge_count * sizeof(unsigned int));
+
+    return true;
+}
+
+static void __bfs_partitioned_worker_free(struct bfs_partitioned_worker * w) {
+    free(w->offsets);
+    free(w->neighbors);
+    free(w->visited);
+    free(w->sent);
+    free(w->frontier);
+    free(w->next);
+}
+
+// Body of a worker process, never returns. A worker exits when told to,
+// or when another process of the search has died.
+static void __bfs_partitioned_worker_main(struct bfs_partitioned * partitioned, unsigned int id) {
+    struct bfs_partitioned_shared * shared = partitioned->shared;
+    unsigned int parties = partitioned->worker_count + 1;
+    struct bfs_partitioned_worker w;
+
+    partitioned->in_worker = true;
+    shared->slots[id].failed = !__bfs_partitioned_worker_init(&w, partitioned, id);
+    bool alive = __bfs_partitioned_barrier_wait(partitioned, &shared->command_barrier, parties);
+
+    while (alive) {
+        alive = __bfs_partitioned_barrier_wait(partitioned, &shared->command_barrier, parties);
+
+        if (!alive || shared->command == BFS_PARTITIONED_SHUTDOWN) {
+            break;
+        }
+
+        alive = __bfs_partitioned_search(&w) &&
+                __bfs_partitioned_barrier_wait(partitioned, &shared->command_barrier, parties);
+    }
+
+    __bfs_partitioned_worker_free(&w);
+    _exit(0);
+}
+
+// Cuts the vertices into contiguous ranges of about the same number of
+// out-edges.
+static void __bfs_partitioned_split(struct bfs_partitioned * partitioned) {
+    const struct graph * graph = partitioned->graph;
+
+    partitioned->bounds[0] = 0;
+    for (unsigned int w = 1; w < partitioned->worker_count; w++) {
+        uint64_t edge = graph->edge_count * w / partitioned->worker_count;
+        unsigned int low = partitioned->bounds[w - 1];
+        unsigned int high = graph->vertex_count;
+
+        // First vertex whose row starts at or after edge.
+        //
+        while (low < high) {
+            unsigned int middle = low + (high - low) / 2;
+
+            if (graph->offsets[middle] < edge) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        partitioned->bounds[w] = low;
+    }
+    partitioned->bounds[partitioned->worker_count] = graph->vertex_count;
+}
+
+// Maps the memory shared with the workers.
+static bool __bfs_partitioned_map(struct bfs_partitioned * partitioned) {
+    size_t shared_bytes = (sizeof(struct bfs_partitioned_shared) + CACHE_LINE_BYTES - 1) & ~(size_t)(CACHE_LINE_BYTES - 1);
+    size_t queue_count = (size_t)partitioned->worker_count * partitioned->worker_count;
+
+    partitioned->mapping_length = shared_bytes + queue_count * sizeof(struct bfs_partitioned_queue);
+    partitioned->mapping = mmap(NULL, partitioned->mapping_length, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (partitioned->mapping == MAP_FAILED) {
+        partitioned->mapping = NULL;
+        return false;
+    }
+
+    // Anonymous mappings are zeroed: every ring starts empty and every
+    // barrier open for its first wait.
+    //
+    partitioned->shared = (struct bfs_partitioned_shared *)partitioned->mapping;
+    partitioned->queues = (struct bfs_partitioned_queue *)((char *)partitioned->mapping + shared_bytes);
+
+    return true;
+}
+
+static void __bfs_partitioned_unmap(struct bfs_partitioned * partitioned) {
+    munmap(partitioned->mapping, partitioned->mapping_length);
+}
+
+// Tells the workers to exit and waits for them. After a death the
+// survivors exit on their own, and are killed in case they are stuck.
+static void __bfs_partitioned_shutdown(struct bfs_partitioned * partitioned) {
+    struct bfs_partitioned_shared * shared = partitioned->shared;
+
+    if (!atomic_load(&shared->aborted)) {
+        shared->command = BFS_PARTITIONED_SHUTDOWN;
+        __bfs_partitioned_barrier_wait(partitioned, &shared->command_barrier, partitioned->worker_count + 1);
+    }
+
+    for (unsigned int w = 0; w < partitioned->worker_count; w++) {
+        if (partitioned->pids[w] == 0) {
+            continue;
+        }
+        if (atomic_load(&shared->aborted)) {
+            kill(partitioned->pids[w], SIGKILL);
+        }
+        waitpid(partitioned->pids[w], NULL, 0);
+    }
+}
+
+// Partitions a graph and starts one worker process per partition.
+struct bfs_partitioned * bfs_partitioned_create(const struct graph * graph, unsigned int workers) {
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    if (workers == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (online > 0) ? (unsigned int)online : 1;
+    }
+    if (workers > BFS_PARTITIONED_MAX_WORKERS) {
+        workers = BFS_PARTITIONED_MAX_WORKERS;
+    }
+
+    struct bfs_partitioned * partitioned = (struct bfs_partitioned *)calloc(1, sizeof(struct bfs_partitioned));
+    if (partitioned == NULL) {
+        return NULL;
+    }
+
+    partitioned->graph = graph;
+    partitioned->worker_count = workers;
+    partitioned->parent = getpid();
+    __bfs_partitioned_split(partitioned);
+
+    if (!__bfs_partitioned_map(partitioned)) {
+        free(partitioned);
+        return NULL;
+    }
+
+    // Buffered output would be written again by every worker's exit.
+    //
+    fflush(NULL);
+
+    unsigned int started = 0;
+    while (started < workers) {
+        pid_t pid = fork();
+
+        if (pid < 0) {
+            break;
+        } else if (pid == 0) {
+            __bfs_partitioned_worker_main(partitioned, started);
+        }
+
+        partitioned->pids[started] = pid;
+        started++;
+    }
+
+    // Workers that are short of company would wait at the barrier
+    // forever.
+    //
+    if (started < workers) {
+        for (unsigned int w = 0; w < started; w++) {
+            kill(partitioned->pids[w], SIGKILL);
+            waitpid(partitioned->pids[w], NULL, 0);
+        }
+        __bfs_partitioned_unmap(partitioned);
+        free(partitioned);
+        return NULL;
+    }
+
+    bool failed = !__bfs_partitioned_barrier_wait(partitioned, &partitioned->shared->command_barrier, workers + 1);
+    for (unsigned int w = 0; w < workers; w++) {
+        failed |= partitioned->shared->slots[w].failed;
+    }
+
+    if (failed) {
+        __bfs_partitioned_shutdown(partitioned);
+        __bfs_partitioned_unmap(partitioned);
+        free(partitioned);
+        return NULL;
+    }
+
+    return partitioned;
+}
+
+// Returns the number of worker processes.
+unsigned int bfs_partitioned_workers(const struct bfs_partitioned * partitioned) {
+    return partitioned == NULL ? 0 : partitioned->worker_count;
+}
+
+// Returns the process ID of a worker, -1 if there is no such worker or
+// it has been reaped.
+pid_t bfs_partitioned_worker_pid(const struct bfs_partitioned * partitioned, unsigned int worker) {
+    if (partitioned == NULL || worker >= partitioned->worker_count || partitioned->pids[worker] == 0) {
+        return -1;
+    }
+
+    return partitioned->pids[worker];
+}
+
+// Returns the number of vertices sent between workers so far.
+uint64_t bfs_partitioned_vertices_exchanged(const struct bfs_partitioned * partitioned) {
+    return partitioned == NULL ? 0 : partitioned->vertices_exchanged;
+}
+
+// Answers whether there is a path from source to target on the workers.
+bool bfs_partitioned_path_exists(struct bfs_partitioned * partitioned,
+                                 unsigned int source,
+                                 unsigned int target,
+                                 struct bfs_stats * stats) {
+
+    struct bfs_stats local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    if (partitioned == NULL || source >= partitioned->graph->vertex_count ||
+        target >= partitioned->graph->vertex_count || atomic_load(&partitioned->shared->aborted)) {
+        return false;
+    }
+
+    if (source == target) {
+        stats->distance = 0;
+        stats->vertices_visited = 1;
+        return true;
+    }
+
+    struct bfs_partitioned_shared * shared = partitioned->shared;
+    shared->command = BFS_PARTITIONED_SEARCH;
+    shared->source = source;
+    shared->target = target;
+    atomic_store(&shared->senders_done, 0);
+
+    unsigned int parties = partitioned->worker_count + 1;
+    if (!__bfs_partitioned_barrier_wait(partitioned, &shared->command_barrier, parties) ||
+        !__bfs_partitioned_barrier_wait(partitioned, &shared->command_barrier, parties)) {
+        return false;
+    }
+
+    for (unsigned int w = 0; w < partitioned->worker_count; w++) {
+        stats->edges_traversed += shared->slots[w].edges_traversed;
+        stats->vertices_visited += shared->slots[w].vertices_visited;
+        partitioned->vertices_exchanged += shared->slots[w].vertices_sent;
+    }
+    stats->peak_queue_size = shared->peak_frontier_size;
+    stats->distance = shared->distance;
+
+    return shared->found;
+}
+
+// Stops the worker processes and frees a partitioned search.
+void bfs_partitioned_delete(struct bfs_partitioned * partitioned) {
+
+    if (partitioned == NULL) {
+        return;
+    }
+
+    __bfs_partitioned_shutdown(partitioned);
+    __bfs_partitioned_unmap(partitioned);
+    free(partitioned);
+}
@@ -0,0 +1,112 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _BFS_PARTITIONED_H
+#define _BFS_PARTITIONED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "bfs.h"
+#include "graph.h"
+
+// Level-synchronous BFS over a graph split between worker processes, a
+// step towards searching graphs too large for one address space.
+//
+// Vertices are cut into contiguous ranges with about the same number of
+// out-edges, one per worker. Each worker is a fork()ed process that
+// copies its range's rows of the CSR into a partition of its own and
+// only reads that afterwards: it keeps a visited bitmap and frontier
+// for its own vertices, and sends every neighbor owned by another
+// worker to that worker over a single-producer single-consumer ring in
+// memory shared by all of them. At the end of each level the workers
+// meet at a barrier in the shared memory, drain their incoming rings into the
+// next frontier, and publish its size: the search ends when one of them
+// has claimed the target or every next frontier is empty.
+//
+// On one machine the full graph is still mapped copy-on-write in every
+// worker from the fork(); it is what a multi-node deployment would load
+// one partition of instead.
+//
+// A worker that blocks on a full ring drains its own incoming rings
+// meanwhile, so the workers cannot deadlock sending to each other.
+// Every process waiting on the others checks now and then that they are
+// still alive: once a worker or the parent has died, the search in
+// progress and every later one fail instead of waiting forever.
+
+#define BFS_PARTITIONED_MAX_WORKERS 16
+
+// Vertices each ring holds before its producer has to wait.
+#define BFS_PARTITIONED_QUEUE_CAPACITY 4096
+
+struct bfs_partitioned;
+
+// Partitions a graph and starts one worker process per partition.
+// \param graph   : Pointer to graph, must outlive the partitioned search.
+// \param workers : Number of worker processes, 0 for one per online CPU.
+// Returns a new partitioned search on success, NULL on failure.
+//
+struct bfs_partitioned * bfs_partitioned_create(const struct graph * graph, unsigned int workers);
+
+// Returns the number of worker processes.
+// \param partitioned : Pointer to partitioned search.
+//
+unsigned int bfs_partitioned_workers(const struct bfs_partitioned * partitioned);
+
+// Returns the process ID of a worker.
+// \param partitioned : Pointer to partitioned search.
+// \param worker      : Worker index, below bfs_partitioned_workers().
+// Returns the process ID on success, -1 if there is no such worker or it
+// has died and been reaped.
+//
+pid_t bfs_partitioned_worker_pid(const struct bfs_partitioned * partitioned, unsigned int worker);
+
+// Returns the number of vertices sent between workers over all the
+// searches so far.
+// \param partitioned : Pointer to partitioned search.
+//
+uint64_t bfs_partitioned_vertices_exchanged(const struct bfs_partitioned * partitioned);
+
+// Answers whether there is a path from source to target, like
+// bfs_path_exists(), on the worker processes. Searches must not overlap.
+// \param partitioned : Pointer to partitioned search.
+// \param source      : Vertex to start from.
+// \param target      : Vertex to look for.
+// \param stats       : Pointer to stats (provided by caller), or NULL.
+//                      stats->peak_queue_size is the largest frontier.
+// Returns TRUE if a path exists, FALSE otherwise (including bad input and
+// a dead worker).
+//
+bool bfs_partitioned_path_exists(struct bfs_partitioned * partitioned,
+                                 unsigned int source,
+                                 unsigned int target,
+                                 struct bfs_stats * stats);
+
+// Stops the worker processes and frees a partitioned search.
+// \param partitioned : Partitioned search to delete, may be NULL.
+//
+void bfs_partitioned_delete(struct bfs_partitioned * partitioned);
+
+#endif
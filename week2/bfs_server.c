@@ -0,0 +1,459 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bfs.h"
+#include "bfs_cache.h"
+#include "graph.h"
+#include "graph_landmarks.h"
+#include "graph_scc.h"
+#include "linked_list.h"
+#include "queue.h"
+
+// Long-running BFS query server: loads a graph once, then answers path
+// queries read one per line from stdin, or from clients of a Unix
+// domain socket (-u), one client at a time. Queries go through one
+// bfs_cache: repeated pairs (-c entries) and sources that keep coming
+// back (-m megabytes of distance arrays) are answered without a search,
+// everything else by a search in the cache's workspace. -c 0 -m 0
+// searches every query. Before any of that, the strongly connected
+// components of the graph, computed at load time, answer "no" for
+// pairs whose components cannot reach each other and "yes" to
+// reachable queries within one component (see graph_scc.h). With -l,
+// a landmark index (see graph_landmarks.h), kept next to the binary
+// cache, answers what its distance bounds settle. Path requests are not
+// cached: they search a workspace of their own, which records parents
+// (see bfs_workspace_path()).
+//
+// Vertex IDs are those of the file (0-based), whatever order -r put the
+// graph in. Requests and replies:
+//
+//   distance A B    ok D | ok unreachable
+//   reachable A B   ok yes | ok no
+//   path A B        ok A V1 V2 ... B | ok unreachable
+//   stats           ok queries N mean_us T hit_rate R pair_hits H
+//                   source_hits S source_fills F memory_bytes M scc_answers A
+//                   landmark_answers L
+//   ping            ok
+//   quit            closes the connection (ends the server on stdin)
+//   shutdown        ends the server
+//
+// Anything else gets "error <reason>".
+//
+// Usage: bfs_server -g graph.mtx|graph.csr [-n] [-j threads] [-r order]
+//                   [-c pair_entries] [-m source_megabytes] [-l landmarks]
+//                   [-u socket_path]
+
+#define MAX_LINE 256
+
+struct bfs_server_options {
+    const char * graph_path;
+    struct graph_load_options load;
+    size_t pair_entries;
+    size_t source_megabytes;
+    unsigned int landmarks;
+    const char * socket_path;
+};
+
+struct server {
+    const struct graph * graph;
+    struct bfs_cache * cache;
+    struct bfs_workspace * workspace;
+    const struct graph_scc * scc;
+    const struct graph_landmarks * landmarks;
+    uint64_t queries;
+    uint64_t scc_answers;
+    uint64_t landmark_answers;
+    uint64_t query_ns;
+};
+
+// What to do after a request.
+enum session_state {
+    SESSION_CONTINUE,
+    SESSION_QUIT,
+    SESSION_SHUTDOWN
+};
+
+// Parses "A B" into internal vertex IDs, checking both are in range.
+static bool parse_pair(const struct server * server, const char * args,
+                       unsigned int * source, unsigned int * target) {
+    unsigned long long a = 0, b = 0;
+    char extra = 0;
+
+    if (sscanf(args, "%llu %llu %c", &a, &b, &extra) != 2 ||
+        a >= server->graph->vertex_count || b >= server->graph->vertex_count) {
+        return false;
+    }
+
+    *source = graph_vertex_id(server->graph, (unsigned int)a);
+    *target = graph_vertex_id(server->graph, (unsigned int)b);
+    return true;
+}
+
+// Answers one request line.
+static enum session_state handle_line(struct server * server, char * line, FILE * out) {
+    char command[16];
+    int consumed = 0;
+    unsigned int source = 0, target = 0;
+
+    line[strcspn(line, "\r\n")] = '\0';
+
+    if (sscanf(line, "%15s%n", command, &consumed) != 1) {
+        fputs("error empty request\n", out);
+        return SESSION_CONTINUE;
+    }
+
+    if (strcmp(command, "distance") == 0 || strcmp(command, "reachable") == 0) {
+        if (!parse_pair(server, line + consumed, &source, &target)) {
+            fputs("error expected two vertex IDs below the vertex count\n", out);
+            return SESSION_CONTINUE;
+        }
+
+        struct bfs_stats stats;
+        uint64_t start = bench_now_ns();
+        enum graph_scc_answer answer = graph_scc_reachable(server->scc, source, target);
+        unsigned int lower = 0, upper = UINT32_MAX;
+        bool bounded = false;
+        bool found;
+
+        if (answer != GRAPH_SCC_UNREACHABLE && server->landmarks != NULL) {
+            bounded = !graph_landmarks_bounds(server->landmarks, source, target, &lower, &upper) ||
+                      lower == upper || (upper != UINT32_MAX && command[0] == 'r');
+        }
+
+        if (answer == GRAPH_SCC_UNREACHABLE || (answer == GRAPH_SCC_REACHABLE && command[0] == 'r')) {
+            found = (answer == GRAPH_SCC_REACHABLE);
+            server->scc_answers += 1;
+        } else if (bounded) {
+            found = (upper != UINT32_MAX);
+            stats.distance = upper;
+            server->landmark_answers += 1;
+        } else {
+            found = bfs_cache_path_exists(server->cache, source, target, &stats);
+        }
+        server->query_ns += bench_now_ns() - start;
+        server->queries += 1;
+
+        if (command[0] == 'r') {
+            fputs(found ? "ok yes\n" : "ok no\n", out);
+        } else if (found) {
+            fprintf(out, "ok %u\n", stats.distance);
+        } else {
+            fputs("ok unreachable\n", out);
+        }
+    } else if (strcmp(command, "path") == 0) {
+        if (!parse_pair(server, line + consumed, &source, &target)) {
+            fputs("error expected two vertex IDs below the vertex count\n", out);
+            return SESSION_CONTINUE;
+        }
+
+        uint64_t start = bench_now_ns();
+        const unsigned int * path = NULL;
+        size_t length = 0;
+
+        if (graph_scc_reachable(server->scc, source, target) == GRAPH_SCC_UNREACHABLE) {
+            server->scc_answers += 1;
+        } else {
+            path = bfs_workspace_path(server->workspace, server->graph, source, target, &length, NULL);
+        }
+        server->query_ns += bench_now_ns() - start;
+        server->queries += 1;
+
+        if (path == NULL) {
+            fputs("ok unreachable\n", out);
+        } else {
+            fputs("ok", out);
+            for (size_t i = 0; i < length; i++) {
+                fprintf(out, " %u", graph_original_id(server->graph, path[i]));
+            }
+            fputc('\n', out);
+        }
+    } else if (strcmp(command, "stats") == 0) {
+        struct bfs_cache_stats cache_stats;
+        bfs_cache_get_stats(server->cache, &cache_stats);
+        uint64_t hits = cache_stats.pair_hits + cache_stats.source_hits;
+
+        fprintf(out, "ok queries %llu mean_us %.3f hit_rate %.4f pair_hits %llu source_hits %llu "
+                     "source_fills %llu memory_bytes %zu scc_answers %llu landmark_answers %llu\n",
+                (unsigned long long)server->queries,
+                server->queries == 0 ? 0.0 : (double)server->query_ns / 1e3 / (double)server->queries,
+                cache_stats.lookups == 0 ? 0.0 : (double)hits / (double)cache_stats.lookups,
+                (unsigned long long)cache_stats.pair_hits, (unsigned long long)cache_stats.source_hits,
+                (unsigned long long)cache_stats.source_fills, cache_stats.memory_bytes,
+                (unsigned long long)server->scc_answers, (unsigned long long)server->landmark_answers);
+    } else if (strcmp(command, "ping") == 0) {
+        fputs("ok\n", out);
+    } else if (strcmp(command, "quit") == 0) {
+        return SESSION_QUIT;
+    } else if (strcmp(command, "shutdown") == 0) {
+        fputs("ok\n", out);
+        return SESSION_SHUTDOWN;
+    } else {
+        fputs("error unknown command\n", out);
+    }
+
+    return SESSION_CONTINUE;
+}
+
+// Answers requests from in until EOF or quit.
+// Returns FALSE if the server should shut down.
+static bool serve(struct server * server, FILE * in, FILE * out) {
+    char line[MAX_LINE];
+    enum session_state state = SESSION_CONTINUE;
+
+    while (state == SESSION_CONTINUE && fgets(line, sizeof(line), in) != NULL) {
+        // A line longer than the buffer is answered once, as an error.
+        //
+        if (strchr(line, '\n') == NULL && !feof(in)) {
+            int c;
+            while ((c = fgetc(in)) != EOF && c != '\n') {
+            }
+            fputs("error request too long\n", out);
+        } else {
+            state = handle_line(server, line, out);
+        }
+
+        fflush(out);
+    }
+
+    return state != SESSION_SHUTDOWN;
+}
+
+// Accepts clients on a Unix domain socket, one at a time, until one of
+// them asks for a shutdown.
+static bool serve_socket(struct server * server, const char * path) {
+    struct sockaddr_un address;
+
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "%s: socket path too long\n", path);
+        return false;
+    }
+
+    // A socket left behind by an earlier run is replaced, anything else
+    // at the path is left alone.
+    //
+    struct stat existing;
+    if (lstat(path, &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            fprintf(stderr, "%s: exists and is not a socket\n", path);
+            return false;
+        }
+        if (unlink(path) != 0) {
+            perror(path);
+            return false;
+        }
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        perror("socket");
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    if (bind(listener, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listener, 16) != 0) {
+        perror(path);
+        close(listener);
+        return false;
+    }
+
+    fprintf(stderr, "listening on %s\n", path);
+
+    bool running = true;
+    while (running) {
+        int client = accept(listener, NULL, NULL);
+
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("accept");
+            break;
+        }
+
+        int client_out = dup(client);
+        FILE * in = fdopen(client, "r");
+        FILE * out = client_out < 0 ? NULL : fdopen(client_out, "w");
+
+        if (in == NULL || out == NULL) {
+            perror("fdopen");
+            if (in != NULL) {
+                fclose(in);
+            } else {
+                close(client);
+            }
+            if (out != NULL) {
+                fclose(out);
+            } else if (client_out >= 0) {
+                close(client_out);
+            }
+            continue;
+        }
+
+        running = serve(server, in, out);
+        fclose(in);
+        fclose(out);
+    }
+
+    close(listener);
+    unlink(path);
+    return true;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s -g graph.mtx|graph.csr [-n] [-j threads] [-r order]\n"
+                    "       [-c pair_entries] [-m source_megabytes] [-l landmarks] [-u socket_path]\n",
+            program);
+}
+
+int main(int argc, char ** argv) {
+    struct bfs_server_options opts = {
+        .graph_path = NULL,
+        .load = {.use_cache = true, .threads = 0},
+        .pair_entries = 65536,
+        .source_megabytes = 64,
+        .landmarks = 0,
+        .socket_path = NULL
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:nj:r:c:m:l:u:h")) != -1) {
+        switch (opt) {
+        case 'g':
+            opts.graph_path = optarg;
+            break;
+        case 'n':
+            opts.load.use_cache = false;
+            break;
+        case 'j':
+            opts.load.threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'r':
+            if (!graph_order_parse(optarg, &opts.load.order)) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'c':
+            opts.pair_entries = strtoull(optarg, NULL, 10);
+            break;
+        case 'm':
+            opts.source_megabytes = strtoull(optarg, NULL, 10);
+            break;
+        case 'l':
+            opts.landmarks = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'u':
+            opts.socket_path = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (opts.graph_path == NULL) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // A client hanging up mid-reply must not kill the server.
+    //
+    signal(SIGPIPE, SIG_IGN);
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+    queue_register_malloc(&malloc);
+    queue_register_free(&free);
+
+    uint64_t load_start = bench_now_ns();
+    struct graph * graph = graph_load(opts.graph_path, &opts.load);
+
+    if (graph == NULL) {
+        return 1;
+    }
+
+    struct graph_scc * scc = graph_scc_compute(graph);
+    struct graph_landmarks * landmarks = NULL;
+
+    if (opts.landmarks != 0) {
+        landmarks = opts.load.use_cache ? graph_landmarks_load_or_build(opts.graph_path, graph, opts.landmarks) :
+                                          graph_landmarks_build(graph, opts.landmarks);
+    }
+
+    struct server server = {
+        .graph = graph,
+        .cache = bfs_cache_create(graph, opts.pair_entries, opts.source_megabytes << 20),
+        .workspace = bfs_workspace_create(graph->vertex_count),
+        .scc = scc,
+        .landmarks = landmarks,
+        .queries = 0,
+        .scc_answers = 0,
+        .landmark_answers = 0,
+        .query_ns = 0
+    };
+
+    if (server.cache == NULL || server.workspace == NULL || scc == NULL || (opts.landmarks != 0 && landmarks == NULL)) {
+        fprintf(stderr, "failed to build the query indexes\n");
+        bfs_cache_delete(server.cache);
+        bfs_workspace_delete(server.workspace);
+        graph_landmarks_delete(landmarks);
+        graph_scc_delete(scc);
+        graph_delete(graph);
+        return 1;
+    }
+
+    fprintf(stderr, "loaded %u vertices, %llu edges, %u components in %.3f s\n", graph->vertex_count,
+            (unsigned long long)graph->edge_count, scc->component_count,
+            (double)(bench_now_ns() - load_start) / 1e9);
+
+    bool ok = true;
+    if (opts.socket_path != NULL) {
+        ok = serve_socket(&server, opts.socket_path);
+    } else {
+        serve(&server, stdin, stdout);
+    }
+
+    bfs_cache_delete(server.cache);
+    bfs_workspace_delete(server.workspace);
+    graph_scc_delete(scc);
+    graph_landmarks_delete(landmarks);
+    graph_delete(graph);
+    linked_list_final_cleanup();
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,985 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// qsort() comparison function for vertex IDs.
+static int __graph_compare_vertices(const void * a, const void * b) {
+    unsigned int x = *(const unsigned int *)a;
+    unsigned int y = *(const unsigned int *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Allocates an empty graph with room for the given number of edges.
+static struct graph * __graph_allocate(unsigned int vertex_count, uint64_t edge_count) {
+    struct graph * graph = (struct graph *)calloc(1, sizeof(struct graph));
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    graph->vertex_count = vertex_count;
+    graph->edge_count = edge_count;
+    graph->offsets = (uint64_t *)calloc((size_t)vertex_count + 1, sizeof(uint64_t));
+    graph->neighbors = (unsigned int *)malloc((edge_count == 0 ? 1 : edge_count) * sizeof(unsigned int));
+
+    if (graph->offsets == NULL || graph->neighbors == NULL) {
+        graph_delete(graph);
+        return NULL;
+    }
+
+    return graph;
+}
+
+// Builds a graph from an edge list with a counting sort by source.
+struct graph * graph_create_from_edges(unsigned int vertex_count,
+                                       const struct graph_edge * edges,
+                                       uint64_t edge_count) {
+
+    struct graph * graph = __graph_allocate(vertex_count, edge_count);
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    for (uint64_t e = 0; e < edge_count; e++) {
+        graph->offsets[edges[e].source + 1] += 1;
+    }
+
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        graph->offsets[v + 1] += graph->offsets[v];
+    }
+
+    // Use offsets[v] as the insertion cursor for v, then shift back.
+    //
+    for (uint64_t e = 0; e < edge_count; e++) {
+        graph->neighbors[graph->offsets[edges[e].source]++] = edges[e].target;
+    }
+
+    for (unsigned int v = vertex_count; v > 0; v--) {
+        graph->offsets[v] = graph->offsets[v - 1];
+    }
+    graph->offsets[0] = 0;
+
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        uint64_t degree = graph_degree(graph, v);
+
+        if (degree > 1) {
+            qsort(&graph->neighbors[graph->offsets[v]], degree,
+                  sizeof(unsigned int), __graph_compare_vertices);
+        }
+    }
+
+    return graph;
+}
+
+// Builds the transpose of a graph with a counting sort by target.
+struct graph * graph_transpose(const struct graph * graph) {
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    struct graph * transpose = __graph_allocate(graph->vertex_count, graph->edge_count);
+    if (transpose == NULL) {
+        return NULL;
+    }
+
+    for (uint64_t e = 0; e < graph->edge_count; e++) {
+        transpose->offsets[graph->neighbors[e] + 1] += 1;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        transpose->offsets[v + 1] += transpose->offsets[v];
+    }
+
+    // Same cursor trick as graph_create_from_edges(). Sources are
+    // visited in order, so every list is filled in sorted order.
+    //
+    for (unsigned int u = 0; u < graph->vertex_count; u++) {
+        for (uint64_t e = graph->offsets[u]; e < graph->offsets[u + 1]; e++) {
+            transpose->neighbors[transpose->offsets[graph->neighbors[e]]++] = u;
+        }
+    }
+
+    for (unsigned int v = graph->vertex_count; v > 0; v--) {
+        transpose->offsets[v] = transpose->offsets[v - 1];
+    }
+    transpose->offsets[0] = 0;
+
+    return transpose;
+}
+
+static const char * graph_order_names[GRAPH_ORDER_COUNT] = {
+    "none",
+    "degree",
+    "rcm",
+    "hub"
+};
+
+// Returns the name of an order.
+const char * graph_order_name(enum graph_order order) {
+    return order < GRAPH_ORDER_COUNT ? graph_order_names[order] : "unknown";
+}
+
+// Looks up an order by name.
+bool graph_order_parse(const char * name, enum graph_order * order) {
+    for (int i = 0; i < GRAPH_ORDER_COUNT; i++) {
+        if (strcmp(name, graph_order_names[i]) == 0) {
+            *order = (enum graph_order)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// qsort() comparison function for sort keys.
+static int __graph_compare_keys(const void * a, const void * b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Returns a sort key that orders by degree (clamped to 32 bits), then
+// by vertex, so that every sort is deterministic.
+static uint64_t __graph_degree_key(uint64_t degree, unsigned int vertex) {
+    return ((degree > UINT32_MAX ? (uint64_t)UINT32_MAX : degree) << 32) | vertex;
+}
+
+// Returns the total (in + out) degree of every vertex, NULL on failure.
+static uint64_t * __graph_total_degrees(const struct graph * graph) {
+    uint64_t * degrees = (uint64_t *)malloc(((size_t)graph->vertex_count + 1) * sizeof(uint64_t));
+
+    if (degrees == NULL) {
+        return NULL;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        degrees[v] = graph_degree(graph, v);
+    }
+
+    for (uint64_t e = 0; e < graph->edge_count; e++) {
+        degrees[graph->neighbors[e]] += 1;
+    }
+
+    return degrees;
+}
+
+// Fills sequence (new vertex -> current vertex) by decreasing degree.
+static bool __graph_order_degree(const struct graph * graph,
+                                 const uint64_t * degrees,
+                                 unsigned int * sequence) {
+    uint64_t * keys = (uint64_t *)malloc(((size_t)graph->vertex_count + 1) * sizeof(uint64_t));
+
+    if (keys == NULL) {
+        return false;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        uint64_t degree = degrees[v] > UINT32_MAX ? UINT32_MAX : degrees[v];
+        keys[v] = __graph_degree_key(UINT32_MAX - degree, v);
+    }
+
+    qsort(keys, graph->vertex_count, sizeof(uint64_t), __graph_compare_keys);
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        sequence[v] = (unsigned int)keys[v];
+    }
+
+    free(keys);
+    return true;
+}
+
+// Fills sequence with hubs (degree above average) first, then the rest.
+static bool __graph_order_hub(const struct graph * graph,
+                              const uint64_t * degrees,
+                              unsigned int * sequence) {
+    unsigned int next = 0;
+
+    // degree > 2E / V, without the division.
+    //
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        if (degrees[v] * graph->vertex_count > 2 * graph->edge_count) {
+            sequence[next++] = v;
+        }
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        if (degrees[v] * graph->vertex_count <= 2 * graph->edge_count) {
+            sequence[next++] = v;
+        }
+    }
+
+    return true;
+}
+
+// Appends the unvisited neighbors of v in one direction to the keys.
+static void __graph_rcm_visit(const struct graph * graph,
+                              unsigned int v,
+                              const uint64_t * degrees,
+                              unsigned char * visited,
+                              uint64_t * keys,
+                              size_t * key_count) {
+    for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+        unsigned int w = graph->neighbors[e];
+
+        if (!visited[w]) {
+            visited[w] = 1;
+            keys[(*key_count)++] = __graph_degree_key(degrees[w], w);
+        }
+    }
+}
+
+// Fills sequence in reverse Cuthill-McKee order. The sequence array is
+// the BFS queue; it is reversed at the end.
+static bool __graph_order_rcm(const struct graph * graph,
+                              const uint64_t * degrees,
+                              unsigned int * sequence) {
+    size_t vertex_count = graph->vertex_count;
+    struct graph * transpose = graph->transpose;
+    uint64_t * starts = (uint64_t *)malloc((vertex_count + 1) * sizeof(uint64_t));
+    uint64_t * keys = (uint64_t *)malloc((vertex_count + 1) * sizeof(uint64_t));
+    unsigned char * visited = (unsigned char *)calloc(vertex_count + 1, 1);
+    bool ok = false;
+
+    // Edges are followed both ways, so in-neighbors are needed too.
+    //
+    if (transpose == NULL) {
+        transpose = graph_transpose(graph);
+    }
+
+    if (starts == NULL || keys == NULL || visited == NULL || transpose == NULL) {
+        goto out;
+    }
+
+    // Components are started from their lowest degree vertex.
+    //
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        starts[v] = __graph_degree_key(degrees[v], v);
+    }
+    qsort(starts, vertex_count, sizeof(uint64_t), __graph_compare_keys);
+
+    size_t head = 0, tail = 0;
+    for (size_t i = 0; i < vertex_count; i++) {
+        unsigned int start = (unsigned int)starts[i];
+
+        if (visited[start]) {
+            continue;
+        }
+
+        visited[start] = 1;
+        sequence[tail++] = start;
+
+        while (head < tail) {
+            unsigned int v = sequence[head++];
+            size_t key_count = 0;
+
+            __graph_rcm_visit(graph, v, degrees, visited, keys, &key_count);
+            __graph_rcm_visit(transpose, v, degrees, visited, keys, &key_count);
+            qsort(keys, key_count, sizeof(uint64_t), __graph_compare_keys);
+
+            for (size_t k = 0; k < key_count; k++) {
+                sequence[tail++] = (unsigned int)keys[k];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < vertex_count / 2; i++) {
+        unsigned int swap = sequence[i];
+        sequence[i] = sequence[vertex_count - 1 - i];
+        sequence[vertex_count - 1 - i] = swap;
+    }
+
+    ok = true;
+
+out:
+    if (transpose != graph->transpose) {
+        graph_delete(transpose);
+    }
+    free(starts);
+    free(keys);
+    free(visited);
+    return ok;
+}
+
+// Builds the graph with vertex sequence[i] of the input renamed to i.
+static struct graph * __graph_permute(const struct graph * graph, const unsigned int * sequence) {
+    size_t vertex_count = graph->vertex_count;
+    struct graph * result = __graph_allocate(graph->vertex_count, graph->edge_count);
+    unsigned int * rank = (unsigned int *)malloc((vertex_count + 1) * sizeof(unsigned int));
+
+    if (result != NULL) {
+        result->original_ids = (unsigned int *)malloc((vertex_count + 1) * sizeof(unsigned int));
+        result->vertex_ids = (unsigned int *)malloc((vertex_count + 1) * sizeof(unsigned int));
+    }
+
+    if (result == NULL || rank == NULL || result->original_ids == NULL || result->vertex_ids == NULL) {
+        graph_delete(result);
+        free(rank);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < vertex_count; i++) {
+        rank[sequence[i]] = (unsigned int)i;
+        result->offsets[i + 1] = result->offsets[i] + graph_degree(graph, sequence[i]);
+    }
+
+    for (size_t i = 0; i < vertex_count; i++) {
+        unsigned int v = sequence[i];
+        unsigned int * out = &result->neighbors[result->offsets[i]];
+        uint64_t degree = graph_degree(graph, v);
+
+        for (uint64_t e = 0; e < degree; e++) {
+            out[e] = rank[graph->neighbors[graph->offsets[v] + e]];
+        }
+
+        if (degree > 1) {
+            qsort(out, degree, sizeof(unsigned int), __graph_compare_vertices);
+        }
+
+        result->original_ids[i] = graph_original_id(graph, v);
+        result->vertex_ids[result->original_ids[i]] = (unsigned int)i;
+    }
+
+    free(rank);
+    return result;
+}
+
+// Relabels the vertices of a graph into the given order.
+struct graph * graph_reorder(const struct graph * graph, enum graph_order order) {
+
+    if (graph == NULL || order >= GRAPH_ORDER_COUNT) {
+        return NULL;
+    }
+
+    size_t vertex_count = graph->vertex_count;
+    unsigned int * sequence = (unsigned int *)malloc((vertex_count + 1) * sizeof(unsigned int));
+    uint64_t * degrees = __graph_total_degrees(graph);
+    struct graph * result = NULL;
+    bool ok = false;
+
+    if (sequence == NULL || degrees == NULL) {
+        goto out;
+    }
+
+    switch (order) {
+    case GRAPH_ORDER_NONE:
+        for (size_t i = 0; i < vertex_count; i++) {
+            sequence[i] = graph_vertex_id(graph, (unsigned int)i);
+        }
+        ok = true;
+        break;
+    case GRAPH_ORDER_DEGREE:
+        ok = __graph_order_degree(graph, degrees, sequence);
+        break;
+    case GRAPH_ORDER_RCM:
+        ok = __graph_order_rcm(graph, degrees, sequence);
+        break;
+    default:
+        ok = __graph_order_hub(graph, degrees, sequence);
+        break;
+    }
+
+    result = ok ? __graph_permute(graph, sequence) : NULL;
+    if (result == NULL) {
+        goto out;
+    }
+
+    result->order = order;
+
+    // Original and vertex IDs are the same again.
+    //
+    if (order == GRAPH_ORDER_NONE) {
+        free(result->original_ids);
+        free(result->vertex_ids);
+        result->original_ids = NULL;
+        result->vertex_ids = NULL;
+    }
+
+    if (graph->transpose != NULL) {
+        result->transpose = graph_transpose(result);
+
+        if (result->transpose == NULL) {
+            graph_delete(result);
+            result = NULL;
+        }
+    }
+
+out:
+    free(sequence);
+    free(degrees);
+    return result;
+}
+
+// Loads a Matrix Market coordinate file into CSR form.
+struct graph * graph_load_matrix_market(const char * path) {
+
+    FILE * in = fopen(path, "r");
+    char * line = NULL;
+    size_t line_capacity = 0;
+    struct graph_edge * edges = NULL;
+    struct graph * graph = NULL;
+    char object[32], format[32], field[32], symmetry[32];
+
+    if (in == NULL) {
+        perror(path);
+        return NULL;
+    }
+
+    if (getline(&line, &line_capacity, in) == -1 ||
+        sscanf(line, "%%%%MatrixMarket %31s %31s %31s %31s", object, format, field, symmetry) != 4 ||
+        strcasecmp(object, "matrix") != 0 || strcasecmp(format, "coordinate") != 0) {
+        fprintf(stderr, "%s: not a Matrix Market coordinate file\n", path);
+        goto out;
+    }
+
+    bool symmetric = strcasecmp(symmetry, "general") != 0;
+
+    // Skip comments, then read the size line.
+    //
+    unsigned long long rows = 0, cols = 0, entries = 0;
+    while (getline(&line, &line_capacity, in) != -1) {
+        if (line[0] != '%') {
+            break;
+        }
+    }
+
+    if (sscanf(line, "%llu %llu %llu", &rows, &cols, &entries) != 3 ||
+        rows > UINT32_MAX || cols > UINT32_MAX) {
+        fprintf(stderr, "%s: bad size line\n", path);
+        goto out;
+    }
+
+    unsigned int vertex_count = (unsigned int)(rows > cols ? rows : cols);
+    uint64_t capacity = symmetric ? 2 * entries : entries;
+    uint64_t edge_count = 0;
+
+    edges = (struct graph_edge *)malloc((capacity == 0 ? 1 : capacity) * sizeof(struct graph_edge));
+    if (edges == NULL) {
+        fprintf(stderr, "%s: out of memory\n", path);
+        goto out;
+    }
+
+    for (unsigned long long i = 0; i < entries; i++) {
+        char * end = NULL;
+
+        if (getline(&line, &line_capacity, in) == -1) {
+            fprintf(stderr, "%s: expected %llu entries, found %llu\n", path, entries, i);
+            goto out;
+        }
+
+        unsigned long long row = strtoull(line, &end, 10);
+        unsigned long long col = strtoull(end, NULL, 10);
+
+        if (row == 0 || col == 0 || row > rows || col > cols) {
+            fprintf(stderr, "%s: entry %llu out of range\n", path, i + 1);
+            goto out;
+        }
+
+        edges[edge_count].source = (unsigned int)(row - 1);
+        edges[edge_count].target = (unsigned int)(col - 1);
+        edge_count += 1;
+
+        if (symmetric && row != col) {
+            edges[edge_count].source = (unsigned int)(col - 1);
+            edges[edge_count].target = (unsigned int)(row - 1);
+            edge_count += 1;
+        }
+    }
+
+    graph = graph_create_from_edges(vertex_count, edges, edge_count);
+    if (graph == NULL) {
+        fprintf(stderr, "%s: out of memory\n", path);
+    }
+
+out:
+    free(edges);
+    free(line);
+    fclose(in);
+    return graph;
+}
+
+// Rounds up to the cache section alignment.
+static uint64_t __graph_cache_align(uint64_t offset) {
+    return (offset + GRAPH_CACHE_ALIGNMENT - 1) & ~(uint64_t)(GRAPH_CACHE_ALIGNMENT - 1);
+}
+
+// Writes a buffer completely at the given file offset.
+static bool __graph_write_at(int fd, const void * buf, uint64_t length, uint64_t offset) {
+    const char * p = (const char *)buf;
+
+    while (length > 0) {
+        ssize_t written = pwrite(fd, p, length, (off_t)offset);
+
+        if (written <= 0) {
+            return false;
+        }
+
+        p += written;
+        length -= (uint64_t)written;
+        offset += (uint64_t)written;
+    }
+
+    return true;
+}
+
+// Appends a section after the last one in the header.
+static void __graph_cache_add_section(struct graph_cache_header * header,
+                                      const void ** data,
+                                      int * count,
+                                      uint64_t type,
+                                      const void * buf,
+                                      uint64_t length) {
+    uint64_t offset = sizeof(*header);
+
+    if (*count != 0) {
+        offset = header->sections[*count - 1].offset + header->sections[*count - 1].length;
+    }
+
+    header->sections[*count].type = type;
+    header->sections[*count].offset = __graph_cache_align(offset);
+    header->sections[*count].length = length;
+    data[*count] = buf;
+    *count += 1;
+}
+
+// Writes a cache file, recording the source file it was built from.
+static bool __graph_save_binary(const struct graph * graph,
+                                const char * path,
+                                uint64_t source_size,
+                                uint64_t source_mtime_ns) {
+    struct graph_cache_header header;
+    const void * data[GRAPH_CACHE_MAX_SECTIONS];
+    int count = 0;
+    char tmp_path[4096];
+
+    memset(&header, 0, sizeof(header));
+    header.magic = GRAPH_CACHE_MAGIC;
+    header.version = GRAPH_CACHE_VERSION;
+    header.vertex_count = graph->vertex_count;
+    header.edge_count = graph->edge_count;
+    header.source_size = source_size;
+    header.source_mtime_ns = source_mtime_ns;
+    header.order = graph->order;
+
+    uint64_t offsets_length = ((uint64_t)graph->vertex_count + 1) * sizeof(uint64_t);
+    uint64_t neighbors_length = graph->edge_count * sizeof(unsigned int);
+    uint64_t ids_length = (uint64_t)graph->vertex_count * sizeof(unsigned int);
+
+    __graph_cache_add_section(&header, data, &count, GRAPH_CACHE_SECTION_OFFSETS,
+                              graph->offsets, offsets_length);
+    __graph_cache_add_section(&header, data, &count, GRAPH_CACHE_SECTION_NEIGHBORS,
+                              graph->neighbors, neighbors_length);
+
+    if (graph->transpose != NULL) {
+        __graph_cache_add_section(&header, data, &count, GRAPH_CACHE_SECTION_IN_OFFSETS,
+                                  graph->transpose->offsets, offsets_length);
+        __graph_cache_add_section(&header, data, &count, GRAPH_CACHE_SECTION_IN_NEIGHBORS,
+                                  graph->transpose->neighbors, neighbors_length);
+    }
+
+    if (graph->original_ids != NULL) {
+        __graph_cache_add_section(&header, data, &count, GRAPH_CACHE_SECTION_ORIGINAL_IDS,
+                                  graph->original_ids, ids_length);
+        __graph_cache_add_section(&header, data, &count, GRAPH_CACHE_SECTION_VERTEX_IDS,
+                                  graph->vertex_ids, ids_length);
+    }
+
+    // Write to a temporary name and rename, so that a concurrent or
+    // interrupted run never sees a partial cache.
+    //
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.%ld", path, (long)getpid());
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(tmp_path);
+        return false;
+    }
+
+    bool ok = __graph_write_at(fd, &header, sizeof(header), 0);
+    for (int i = 0; ok && i < count; i++) {
+        ok = __graph_write_at(fd, data[i], header.sections[i].length, header.sections[i].offset);
+    }
+
+    if (close(fd) != 0 || !ok || rename(tmp_path, path) != 0) {
+        perror(path);
+        unlink(tmp_path);
+        return false;
+    }
+
+    return true;
+}
+
+// Writes a graph to a binary CSR cache file.
+bool graph_save_binary(const struct graph * graph, const char * path) {
+
+    if (graph == NULL || path == NULL) {
+        return false;
+    }
+
+    return __graph_save_binary(graph, path, 0, 0);
+}
+
+// Returns the section of the given type, NULL if missing or out of bounds.
+static const struct graph_cache_section * __graph_cache_section(const struct graph_cache_header * header,
+                                                                uint64_t type,
+                                                                size_t file_length) {
+    for (int i = 0; i < GRAPH_CACHE_MAX_SECTIONS; i++) {
+        const struct graph_cache_section * section = &header->sections[i];
+
+        if (section->type == type) {
+            if (section->offset > file_length || section->length > file_length - section->offset) {
+                return NULL;
+            }
+            return section;
+        }
+    }
+
+    return NULL;
+}
+
+// Checks that CSR arrays taken from a cache file can be searched without
+// reading out of bounds: offsets start at 0, never decrease and end at
+// edge_count, and every neighbor is a vertex.
+static bool __graph_csr_valid(const uint64_t * offsets,
+                              const unsigned int * neighbors,
+                              unsigned int vertex_count,
+                              uint64_t edge_count) {
+
+    if (offsets[0] != 0 || offsets[vertex_count] != edge_count) {
+        return false;
+    }
+
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        if (offsets[v] > offsets[v + 1]) {
+            return false;
+        }
+    }
+
+    for (uint64_t e = 0; e < edge_count; e++) {
+        if (neighbors[e] >= vertex_count) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Returns TRUE if a section holds exactly count elements of size bytes.
+// Divides rather than multiplies, so that a crafted count cannot wrap
+// around to the length of a much smaller section.
+static bool __graph_cache_section_holds(const struct graph_cache_section * section, uint64_t count, size_t size) {
+    return section->length % size == 0 && section->length / size == count;
+}
+
+// Checks that an ID array from a cache file only holds vertices.
+static bool __graph_ids_valid(const unsigned int * ids, unsigned int vertex_count) {
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        if (ids[v] >= vertex_count) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Maps a cache file and validates its header and arrays. If source is
+// non-NULL the cache must have been built from a file of that size and
+// mtime.
+static struct graph * __graph_load_binary(const char * path, const struct stat * source) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct graph_cache_header)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t length = (size_t)st.st_size;
+    void * mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    const struct graph_cache_header * header = (const struct graph_cache_header *)mapping;
+    const struct graph_cache_section * offsets =
+        __graph_cache_section(header, GRAPH_CACHE_SECTION_OFFSETS, length);
+    const struct graph_cache_section * neighbors =
+        __graph_cache_section(header, GRAPH_CACHE_SECTION_NEIGHBORS, length);
+
+    bool valid = header->magic == GRAPH_CACHE_MAGIC &&
+                 header->version == GRAPH_CACHE_VERSION &&
+                 header->vertex_count <= UINT32_MAX &&
+                 offsets != NULL && neighbors != NULL &&
+                 offsets->offset % sizeof(uint64_t) == 0 &&
+                 neighbors->offset % sizeof(unsigned int) == 0 &&
+                 __graph_cache_section_holds(offsets, header->vertex_count + 1, sizeof(uint64_t)) &&
+                 __graph_cache_section_holds(neighbors, header->edge_count, sizeof(unsigned int)) &&
+                 header->order < GRAPH_ORDER_COUNT;
+
+    // A reordered graph is useless without its original IDs.
+    //
+    const struct graph_cache_section * original_ids =
+        __graph_cache_section(header, GRAPH_CACHE_SECTION_ORIGINAL_IDS, length);
+    const struct graph_cache_section * vertex_ids =
+        __graph_cache_section(header, GRAPH_CACHE_SECTION_VERTEX_IDS, length);
+
+    if (valid && header->order != GRAPH_ORDER_NONE) {
+        valid = original_ids != NULL && vertex_ids != NULL &&
+                original_ids->offset % sizeof(unsigned int) == 0 &&
+                vertex_ids->offset % sizeof(unsigned int) == 0 &&
+                __graph_cache_section_holds(original_ids, header->vertex_count, sizeof(unsigned int)) &&
+                __graph_cache_section_holds(vertex_ids, header->vertex_count, sizeof(unsigned int));
+    }
+
+    if (valid && source != NULL) {
+        valid = header->source_size == (uint64_t)source->st_size &&
+                header->source_mtime_ns == (uint64_t)source->st_mtim.tv_sec * 1000000000ull +
+                                           (uint64_t)source->st_mtim.tv_nsec;
+    }
+
+    // The cache is only keyed on the stat of its source, so a truncated
+    // or corrupted file can pass every check above. One pass over the
+    // arrays is still far cheaper than a parse. Read-ahead is asked for
+    // first: the check reads every page, and BFS later does too, in a
+    // random order.
+    //
+    if (valid) {
+        madvise(mapping, length, MADV_WILLNEED);
+        valid = __graph_csr_valid((const uint64_t *)((const char *)mapping + offsets->offset),
+                                  (const unsigned int *)((const char *)mapping + neighbors->offset),
+                                  (unsigned int)header->vertex_count, header->edge_count);
+    }
+
+    if (valid && header->order != GRAPH_ORDER_NONE) {
+        valid = __graph_ids_valid((const unsigned int *)((const char *)mapping + original_ids->offset),
+                                  (unsigned int)header->vertex_count) &&
+                __graph_ids_valid((const unsigned int *)((const char *)mapping + vertex_ids->offset),
+                                  (unsigned int)header->vertex_count);
+    }
+
+    struct graph * graph = valid ? (struct graph *)calloc(1, sizeof(struct graph)) : NULL;
+    if (graph == NULL) {
+        munmap(mapping, length);
+        return NULL;
+    }
+
+    graph->vertex_count = (unsigned int)header->vertex_count;
+    graph->edge_count = header->edge_count;
+    graph->offsets = (uint64_t *)((char *)mapping + offsets->offset);
+    graph->neighbors = (unsigned int *)((char *)mapping + neighbors->offset);
+    graph->mapping = mapping;
+    graph->mapping_length = length;
+    graph->order = (enum graph_order)header->order;
+
+    if (graph->order != GRAPH_ORDER_NONE) {
+        graph->original_ids = (unsigned int *)((char *)mapping + original_ids->offset);
+        graph->vertex_ids = (unsigned int *)((char *)mapping + vertex_ids->offset);
+    }
+
+    // The transpose is optional; a cache without it is still valid.
+    //
+    const struct graph_cache_section * in_offsets =
+        __graph_cache_section(header, GRAPH_CACHE_SECTION_IN_OFFSETS, length);
+    const struct graph_cache_section * in_neighbors =
+        __graph_cache_section(header, GRAPH_CACHE_SECTION_IN_NEIGHBORS, length);
+
+    if (in_offsets != NULL && in_neighbors != NULL &&
+        in_offsets->length == offsets->length && in_neighbors->length == neighbors->length &&
+        in_offsets->offset % sizeof(uint64_t) == 0 && in_neighbors->offset % sizeof(unsigned int) == 0 &&
+        __graph_csr_valid((const uint64_t *)((const char *)mapping + in_offsets->offset),
+                          (const unsigned int *)((const char *)mapping + in_neighbors->offset),
+                          graph->vertex_count, graph->edge_count)) {
+        graph->transpose = (struct graph *)calloc(1, sizeof(struct graph));
+
+        if (graph->transpose != NULL) {
+            graph->transpose->vertex_count = graph->vertex_count;
+            graph->transpose->edge_count = graph->edge_count;
+            graph->transpose->offsets = (uint64_t *)((char *)mapping + in_offsets->offset);
+            graph->transpose->neighbors = (unsigned int *)((char *)mapping + in_neighbors->offset);
+            graph->transpose->mapping = mapping;
+            graph->transpose->mapping_length = 0;
+        }
+    }
+
+    return graph;
+}
+
+// Maps a binary CSR cache file.
+struct graph * graph_load_binary(const char * path) {
+
+    if (path == NULL) {
+        return NULL;
+    }
+
+    struct graph * graph = __graph_load_binary(path, NULL);
+    if (graph == NULL) {
+        fprintf(stderr, "%s: not a valid binary graph file\n", path);
+    }
+
+    return graph;
+}
+
+// Parses a .mtx file with the loader selected by the options.
+static struct graph * __graph_parse(const char * path, const struct graph_load_options * options) {
+    if (options->streaming) {
+        return graph_load_matrix_market_streaming(path, options->threads, options->stream_buffer_size);
+    }
+
+    return graph_load_matrix_market_parallel(path, options->threads);
+}
+
+// Builds and attaches the transpose if the options ask for it and the
+// graph does not have one yet. Deletes the graph on failure.
+static struct graph * __graph_attach_transpose(struct graph * graph, const struct graph_load_options * options) {
+    if (graph == NULL || !options->transpose || graph->transpose != NULL) {
+        return graph;
+    }
+
+    graph->transpose = graph_transpose(graph);
+    if (graph->transpose == NULL) {
+        graph_delete(graph);
+        return NULL;
+    }
+
+    return graph;
+}
+
+// Relabels the graph into the order the options ask for, if it is not
+// in it already. Deletes the graph on failure.
+static struct graph * __graph_apply_order(struct graph * graph, const struct graph_load_options * options) {
+    if (graph == NULL || graph->order == options->order) {
+        return graph;
+    }
+
+    struct graph * reordered = graph_reorder(graph, options->order);
+    graph_delete(graph);
+
+    return reordered;
+}
+
+// Loads a .mtx file through its binary cache, or a binary cache directly.
+struct graph * graph_load(const char * path, const struct graph_load_options * options) {
+
+    const struct graph_load_options defaults = {.use_cache = true, .threads = 0};
+
+    if (path == NULL) {
+        return NULL;
+    }
+
+    if (options == NULL) {
+        options = &defaults;
+    }
+
+    size_t length = strlen(path);
+    if (length < 4 || strcmp(path + length - 4, ".mtx") != 0) {
+        return __graph_attach_transpose(__graph_apply_order(graph_load_binary(path), options), options);
+    }
+
+    if (!options->use_cache) {
+        return __graph_attach_transpose(__graph_apply_order(__graph_parse(path, options), options), options);
+    }
+
+    struct stat source;
+    char cache_path[4096];
+
+    if (stat(path, &source) != 0) {
+        perror(path);
+        return NULL;
+    }
+
+    snprintf(cache_path, sizeof(cache_path), "%s%s", path, GRAPH_CACHE_SUFFIX);
+    struct graph * graph = __graph_load_binary(cache_path, &source);
+
+    if (graph != NULL && graph->order == options->order &&
+        (!options->transpose || graph->transpose != NULL)) {
+        return graph;
+    }
+
+    // A cache in another order or without the requested transpose is
+    // rewritten. The mapping stays valid: rename() replaces the name,
+    // not the file.
+    //
+    if (graph == NULL) {
+        graph = __graph_parse(path, options);
+    }
+    graph = __graph_attach_transpose(__graph_apply_order(graph, options), options);
+
+    // Failing to write the cache only costs the next run a parse.
+    //
+    if (graph != NULL) {
+        __graph_save_binary(graph, cache_path, (uint64_t)source.st_size,
+                            (uint64_t)source.st_mtim.tv_sec * 1000000000ull +
+                            (uint64_t)source.st_mtim.tv_nsec);
+    }
+
+    return graph;
+}
+
+// Returns the size of the CSR arrays of a graph in bytes.
+uint64_t graph_bytes(const struct graph * graph) {
+    return ((uint64_t)graph->vertex_count + 1) * sizeof(uint64_t) + graph->edge_count * sizeof(unsigned int);
+}
+
+// Frees a graph, unmapping it if it came from a cache file.
+void graph_delete(struct graph * graph) {
+
+    if (graph == NULL) {
+        return;
+    }
+
+    graph_delete(graph->transpose);
+
+    if (graph->mapping != NULL) {
+        // A mapped transpose borrows its graph's mapping.
+        //
+        if (graph->mapping_length != 0) {
+            munmap(graph->mapping, graph->mapping_length);
+        }
+    } else {
+        free(graph->offsets);
+        free(graph->neighbors);
+        free(graph->original_ids);
+        free(graph->vertex_ids);
+    }
+
+    free(graph);
+}
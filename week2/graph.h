@@ -0,0 +1,298 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _GRAPH_H
+#define _GRAPH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Vertex orders graph_reorder() can relabel a graph into, to make a
+// traversal touch vertices that are close in memory one after another.
+//
+enum graph_order {
+    // The order of the file the graph was loaded from.
+    GRAPH_ORDER_NONE = 0,
+    // By decreasing total (in + out) degree, so that the hot vertices
+    // share cache lines.
+    GRAPH_ORDER_DEGREE = 1,
+    // Reverse Cuthill-McKee: BFS order over the undirected graph, from a
+    // low degree vertex of each component, neighbors by increasing
+    // degree, then reversed. Keeps neighbors close to each other.
+    GRAPH_ORDER_RCM = 2,
+    // Hub clustering: vertices of above average degree first, then the
+    // rest, each group keeping its original relative order.
+    GRAPH_ORDER_HUB = 3,
+    GRAPH_ORDER_COUNT
+};
+
+// Directed graph in compressed sparse row (CSR) form. The out-neighbors
+// of vertex v are neighbors[offsets[v]] .. neighbors[offsets[v + 1] - 1],
+// sorted in increasing order. Vertex IDs are unsigned ints, the same
+// type the queue holds.
+//
+// A graph loaded from a binary cache file points straight into a
+// read-only mapping of that file (mapping != NULL); its arrays must
+// not be modified.
+//
+// transpose, when not NULL, is the graph with every edge reversed: the
+// out-neighbors of v in the transpose are the in-neighbors of v. It is
+// owned by the graph. A transpose mapped from the same cache file shares
+// its graph's mapping and has mapping_length 0.
+//
+// A graph relabeled by graph_reorder() (order != GRAPH_ORDER_NONE) keeps
+// the vertex IDs of the file it was loaded from as original IDs:
+// original_ids[v] is the original ID of vertex v and vertex_ids[o] the
+// vertex with original ID o. Both are NULL for GRAPH_ORDER_NONE, where
+// vertex and original IDs are the same; see graph_original_id() and
+// graph_vertex_id().
+//
+struct graph {
+    unsigned int vertex_count;
+    uint64_t edge_count;
+    uint64_t * offsets;
+    unsigned int * neighbors;
+    void * mapping;
+    size_t mapping_length;
+    struct graph * transpose;
+    enum graph_order order;
+    unsigned int * original_ids;
+    unsigned int * vertex_ids;
+};
+
+// Binary CSR cache file layout. All sections start on a page boundary
+// so they can be used in place from an mmap() of the file. Integers are
+// in host byte order; a file written on a machine of the other
+// endianness fails the magic check.
+//
+#define GRAPH_CACHE_MAGIC 0x5253435352415750ull  /* "PWARSCSR" */
+#define GRAPH_CACHE_VERSION 2
+#define GRAPH_CACHE_MAX_SECTIONS 8
+#define GRAPH_CACHE_ALIGNMENT 4096
+
+// Appended to a .mtx path to name its cache file.
+#define GRAPH_CACHE_SUFFIX ".csr"
+
+// Default size of each of the read buffers used by the streaming loader.
+#define GRAPH_STREAM_BUFFER_SIZE (16u << 20)
+
+enum graph_cache_section_type {
+    GRAPH_CACHE_SECTION_UNUSED = 0,
+    GRAPH_CACHE_SECTION_OFFSETS = 1,
+    GRAPH_CACHE_SECTION_NEIGHBORS = 2,
+    // Optional, present when the graph was saved with its transpose.
+    GRAPH_CACHE_SECTION_IN_OFFSETS = 3,
+    GRAPH_CACHE_SECTION_IN_NEIGHBORS = 4,
+    // Present when the graph was reordered (order != GRAPH_ORDER_NONE).
+    GRAPH_CACHE_SECTION_ORIGINAL_IDS = 5,
+    GRAPH_CACHE_SECTION_VERTEX_IDS = 6
+};
+
+struct graph_cache_section {
+    uint64_t type;
+    uint64_t offset;
+    uint64_t length;
+};
+
+struct graph_cache_header {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t vertex_count;
+    uint64_t edge_count;
+    // Size and modification time of the .mtx file the cache was built
+    // from, zero when written directly (e.g. by graph_generator).
+    uint64_t source_size;
+    uint64_t source_mtime_ns;
+    // enum graph_order the graph was saved in.
+    uint64_t order;
+    struct graph_cache_section sections[GRAPH_CACHE_MAX_SECTIONS];
+};
+
+// A directed edge, used to build graphs from edge lists.
+//
+struct graph_edge {
+    unsigned int source;
+    unsigned int target;
+};
+
+// Builds a graph from an edge list. Duplicate edges and self loops are
+// kept as given.
+// \param vertex_count : Number of vertices, every endpoint must be below this.
+// \param edges        : Array of edges.
+// \param edge_count   : Number of edges.
+// Returns a new graph on success, NULL on failure.
+//
+struct graph * graph_create_from_edges(unsigned int vertex_count,
+                                       const struct graph_edge * edges,
+                                       uint64_t edge_count);
+
+// Loads a Matrix Market coordinate file. Entry (i, j) is an edge from
+// vertex i - 1 to vertex j - 1; symmetric matrices get both directions.
+// Values of real/integer matrices are ignored.
+// \param path : Path to a .mtx file.
+// Returns a new graph on success, NULL on failure (a message is printed
+// to stderr).
+//
+struct graph * graph_load_matrix_market(const char * path);
+
+// Loads a Matrix Market coordinate file like graph_load_matrix_market(),
+// parsing and building the CSR arrays on several threads.
+// \param path    : Path to a .mtx file.
+// \param threads : Number of threads, 0 for one per online CPU.
+// Returns a new graph on success, NULL on failure.
+//
+struct graph * graph_load_matrix_market_parallel(const char * path, unsigned int threads);
+
+// Loads a Matrix Market coordinate file like graph_load_matrix_market(),
+// without mapping it: a reader thread streams the file through a pair of
+// aligned buffers while the parser threads parse the previously read
+// one. Memory used for the file itself is bounded by the buffers, and
+// parsed pages are dropped from the page cache, which suits files
+// larger than memory. No line may be longer than a buffer.
+// \param path        : Path to a .mtx file.
+// \param threads     : Number of parser threads, 0 for one per online CPU.
+// \param buffer_size : Size of each read buffer in bytes, 0 for
+//                      GRAPH_STREAM_BUFFER_SIZE.
+// Returns a new graph on success, NULL on failure.
+//
+struct graph * graph_load_matrix_market_streaming(const char * path,
+                                                  unsigned int threads,
+                                                  size_t buffer_size);
+
+// Builds the transpose of a graph: every edge u -> v becomes v -> u.
+// Neighbor lists come out sorted without a sort, since sources are
+// visited in increasing order.
+// \param graph : Pointer to graph.
+// Returns a new graph on success, NULL on failure. It is not attached
+// to graph->transpose.
+//
+struct graph * graph_transpose(const struct graph * graph);
+
+// Relabels the vertices of a graph into the given order. Neighbor lists
+// of the result are sorted, original IDs carry over from the input (so
+// reordering twice still maps back to the file's IDs), and a transpose
+// is rebuilt if the input has one. GRAPH_ORDER_NONE restores the
+// original IDs.
+// \param graph : Pointer to graph.
+// \param order : Order to relabel into.
+// Returns a new graph on success, NULL on failure.
+//
+struct graph * graph_reorder(const struct graph * graph, enum graph_order order);
+
+// Returns the name of an order ("none", "degree", "rcm", "hub").
+// \param order : Order to name.
+//
+const char * graph_order_name(enum graph_order order);
+
+// Looks up an order by name.
+// \param name  : Name as returned by graph_order_name().
+// \param order : Set to the order found.
+// Returns TRUE on success, FALSE if the name is unknown.
+//
+bool graph_order_parse(const char * name, enum graph_order * order);
+
+// Writes a graph to a binary CSR cache file, with its transpose and
+// original IDs if it has them.
+// \param graph : Pointer to graph.
+// \param path  : Path of the file to write, replaced atomically.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool graph_save_binary(const struct graph * graph, const char * path);
+
+// Maps a binary CSR cache file. Nothing is copied, pages are read in as
+// the graph is touched.
+// \param path : Path to a file written by graph_save_binary().
+// Returns a new read-only graph on success, NULL on failure.
+//
+struct graph * graph_load_binary(const char * path);
+
+// Options for graph_load().
+//
+struct graph_load_options {
+    // FALSE to always parse .mtx files and write no cache.
+    bool use_cache;
+    // Threads used to parse .mtx files, 0 for one per online CPU.
+    unsigned int threads;
+    // TRUE to parse .mtx files with graph_load_matrix_market_streaming()
+    // instead of mapping them.
+    bool streaming;
+    // Read buffer size for streaming, 0 for GRAPH_STREAM_BUFFER_SIZE.
+    size_t stream_buffer_size;
+    // TRUE to make sure graph->transpose is set. It is built once and
+    // then kept in the cache file.
+    bool transpose;
+    // Order to relabel the graph into. It is computed once and then kept
+    // in the cache file; loading a cache saved in another order redoes
+    // it.
+    enum graph_order order;
+};
+
+// Loads a graph from any supported file. A .mtx file is parsed once and
+// converted to a binary cache next to it (path + ".csr"); later loads
+// map the cache instead, as long as the .mtx file has not changed since.
+// Any other file is treated as a binary cache.
+// \param path    : Path to a .mtx or binary cache file.
+// \param options : Pointer to options, or NULL for the defaults (use the
+//                  cache, parse with one thread per CPU).
+// Returns a new graph on success, NULL on failure.
+//
+struct graph * graph_load(const char * path, const struct graph_load_options * options);
+
+// Returns the size of the CSR arrays of a graph (not its transpose) in
+// bytes.
+// \param graph : Pointer to graph.
+//
+uint64_t graph_bytes(const struct graph * graph);
+
+// Frees a graph.
+// \param graph : Graph to free, may be NULL.
+//
+void graph_delete(struct graph * graph);
+
+// Returns the out-degree of a vertex.
+// \param graph  : Pointer to graph.
+// \param vertex : Vertex to query.
+//
+static inline uint64_t graph_degree(const struct graph * graph, unsigned int vertex) {
+    return graph->offsets[vertex + 1] - graph->offsets[vertex];
+}
+
+// Returns the original (file) ID of a vertex.
+// \param graph  : Pointer to graph.
+// \param vertex : Vertex to map.
+//
+static inline unsigned int graph_original_id(const struct graph * graph, unsigned int vertex) {
+    return graph->original_ids == NULL ? vertex : graph->original_ids[vertex];
+}
+
+// Returns the vertex with a given original (file) ID.
+// \param graph    : Pointer to graph.
+// \param original : Original ID to map.
+//
+static inline unsigned int graph_vertex_id(const struct graph * graph, unsigned int original) {
+    return graph->vertex_ids == NULL ? original : graph->vertex_ids[original];
+}
+
+#endif
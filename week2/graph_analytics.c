@@ -0,0 +1,511 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph_analytics.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "bfs.h"
+
+#define CACHE_LINE_BYTES 64
+
+// Vertices claimed at a time, as in bfs_parallel.c.
+#define GRAPH_ANALYTICS_CHUNK 256
+
+struct graph_analytics_job;
+
+// Per-thread state, padded to a cache line.
+struct graph_analytics_thread {
+    pthread_t thread;
+    struct graph_analytics_job * job;
+    unsigned int id;
+    unsigned int * next;
+    size_t next_count;
+    size_t next_capacity;
+    size_t next_offset;
+    uint64_t edges_traversed;
+    uint64_t count;
+    bool failed;
+} __attribute__((aligned(CACHE_LINE_BYTES)));
+
+// One job on a set of threads. Every thread runs run() once; the
+// threads are only let in once all of them exist, since the phases of a
+// job are separated by a barrier counting every one.
+struct graph_analytics_job {
+    const struct graph * graph;
+    void (*run)(struct graph_analytics_thread * t);
+    unsigned int thread_count;
+    struct graph_analytics_thread * threads;
+    pthread_barrier_t barrier;
+    pthread_mutex_t mutex;
+    pthread_cond_t started_cond;
+    bool started;
+    bool aborted;
+
+    // graph_analytics_wcc() and graph_analytics_k_hop() results. The
+    // arrays belong to the caller, so they are updated with the GCC
+    // __atomic builtins rather than declared _Atomic.
+    unsigned int * labels;
+    unsigned int * distances;
+
+    // graph_analytics_k_hop() frontier, read by every thread during a
+    // level and rewritten between levels.
+    const unsigned int * seeds;
+    size_t seed_count;
+    unsigned int hops;
+    unsigned int * frontier;
+    size_t frontier_size;
+    unsigned int depth;
+    bool done;
+    bool failed;
+    uint64_t reached;
+
+    _Atomic size_t cursor __attribute__((aligned(CACHE_LINE_BYTES)));
+};
+
+// Returns the first of the range of n items a thread handles.
+static size_t __graph_analytics_split(const struct graph_analytics_job * job, size_t n, unsigned int id) {
+    return n * id / job->thread_count;
+}
+
+// Claims the next chunk of n items, returns FALSE once there are none.
+static bool __graph_analytics_claim(struct graph_analytics_job * job, size_t n, size_t * begin, size_t * end) {
+    *begin = atomic_fetch_add_explicit(&job->cursor, GRAPH_ANALYTICS_CHUNK, memory_order_relaxed);
+
+    if (*begin >= n) {
+        return false;
+    }
+
+    *end = (*begin + GRAPH_ANALYTICS_CHUNK < n) ? *begin + GRAPH_ANALYTICS_CHUNK : n;
+    return true;
+}
+
+static void * __graph_analytics_thread_main(void * arg) {
+    struct graph_analytics_thread * t = (struct graph_analytics_thread *)arg;
+    struct graph_analytics_job * job = t->job;
+
+    pthread_mutex_lock(&job->mutex);
+    while (!job->started && !job->aborted) {
+        pthread_cond_wait(&job->started_cond, &job->mutex);
+    }
+    pthread_mutex_unlock(&job->mutex);
+
+    if (job->started) {
+        job->run(t);
+    }
+
+    return NULL;
+}
+
+// Runs a job on threads threads, the calling one included, and waits for
+// it. Returns FALSE if the threads could not be started.
+static bool __graph_analytics_run(struct graph_analytics_job * job, unsigned int threads) {
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1;
+    }
+    if (threads > GRAPH_ANALYTICS_MAX_THREADS) {
+        threads = GRAPH_ANALYTICS_MAX_THREADS;
+    }
+
+    job->threads = (struct graph_analytics_thread *)aligned_alloc(CACHE_LINE_BYTES,
+                                                                  threads * sizeof(struct graph_analytics_thread));
+    if (job->threads == NULL) {
+        return false;
+    }
+    memset(job->threads, 0, threads * sizeof(struct graph_analytics_thread));
+
+    job->thread_count = threads;
+    atomic_store(&job->cursor, 0);
+    pthread_mutex_init(&job->mutex, NULL);
+    pthread_cond_init(&job->started_cond, NULL);
+
+    for (unsigned int i = 0; i < threads; i++) {
+        job->threads[i].job = job;
+        job->threads[i].id = i;
+    }
+
+    unsigned int created = 1;
+    while (created < threads &&
+           pthread_create(&job->threads[created].thread, NULL, __graph_analytics_thread_main,
+                          &job->threads[created]) == 0) {
+        created++;
+    }
+
+    pthread_mutex_lock(&job->mutex);
+    if (created == threads) {
+        pthread_barrier_init(&job->barrier, NULL, threads);
+        job->started = true;
+    } else {
+        job->aborted = true;
+    }
+    pthread_cond_broadcast(&job->started_cond);
+    pthread_mutex_unlock(&job->mutex);
+
+    if (job->started) {
+        job->run(&job->threads[0]);
+    }
+
+    for (unsigned int i = 1; i < created; i++) {
+        pthread_join(job->threads[i].thread, NULL);
+    }
+
+    if (job->started) {
+        pthread_barrier_destroy(&job->barrier);
+    }
+    pthread_cond_destroy(&job->started_cond);
+    pthread_mutex_destroy(&job->mutex);
+
+    return job->started;
+}
+
+// Frees the threads of a finished job, adding up their counters.
+static void __graph_analytics_finish(struct graph_analytics_job * job, struct graph_analytics_stats * stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->threads = job->thread_count;
+
+    for (unsigned int i = 0; i < job->thread_count; i++) {
+        stats->edges_traversed += job->threads[i].edges_traversed;
+        stats->count += job->threads[i].count;
+        free(job->threads[i].next);
+    }
+
+    free(job->threads);
+}
+
+// Returns the root of a vertex in the union-find forest, halving the
+// path on the way. Only non-roots are rewritten, always to an ancestor,
+// which stays an ancestor whatever other threads link meanwhile.
+static inline unsigned int __graph_analytics_find(unsigned int * parents, unsigned int vertex) {
+    while (true) {
+        unsigned int parent = __atomic_load_n(&parents[vertex], __ATOMIC_RELAXED);
+        if (parent == vertex) {
+            return vertex;
+        }
+
+        unsigned int grandparent = __atomic_load_n(&parents[parent], __ATOMIC_RELAXED);
+        if (grandparent == parent) {
+            return parent;
+        }
+
+        __atomic_store_n(&parents[vertex], grandparent, __ATOMIC_RELAXED);
+        vertex = grandparent;
+    }
+}
+
+// Joins the trees of two vertices. The root with the larger ID is linked
+// under the other one, only if it is still a root, so IDs strictly
+// decrease towards the roots and no cycle can form.
+static inline void __graph_analytics_union(unsigned int * parents, unsigned int u, unsigned int v) {
+    while (true) {
+        unsigned int ru = __graph_analytics_find(parents, u);
+        unsigned int rv = __graph_analytics_find(parents, v);
+
+        if (ru == rv) {
+            return;
+        }
+
+        if (ru < rv) {
+            unsigned int swap = ru;
+            ru = rv;
+            rv = swap;
+        }
+
+        unsigned int expected = ru;
+        if (__atomic_compare_exchange_n(&parents[ru], &expected, rv, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return;
+        }
+
+        u = ru;
+        v = rv;
+    }
+}
+
+// Weakly connected components, on every thread.
+static void __graph_analytics_wcc_run(struct graph_analytics_thread * t) {
+    struct graph_analytics_job * job = t->job;
+    const struct graph * graph = job->graph;
+    unsigned int * labels = job->labels;
+    size_t first = __graph_analytics_split(job, graph->vertex_count, t->id);
+    size_t last = __graph_analytics_split(job, graph->vertex_count, t->id + 1);
+    size_t begin, end;
+
+    for (size_t v = first; v < last; v++) {
+        labels[v] = (unsigned int)v;
+    }
+    pthread_barrier_wait(&job->barrier);
+
+    // Vertices are claimed in chunks: a hub's edges are worth many
+    // ordinary vertices.
+    //
+    while (__graph_analytics_claim(job, graph->vertex_count, &begin, &end)) {
+        for (size_t v = begin; v < end; v++) {
+            for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+                __graph_analytics_union(labels, (unsigned int)v, graph->neighbors[e]);
+            }
+            t->edges_traversed += graph_degree(graph, (unsigned int)v);
+        }
+    }
+    pthread_barrier_wait(&job->barrier);
+
+    for (size_t v = first; v < last; v++) {
+        unsigned int root = __graph_analytics_find(labels, (unsigned int)v);
+        __atomic_store_n(&labels[v], root, __ATOMIC_RELAXED);
+        t->count += (root == v);
+    }
+}
+
+// Labels the weakly connected components of a graph.
+bool graph_analytics_wcc(const struct graph * graph,
+                         unsigned int threads,
+                         unsigned int * labels,
+                         struct graph_analytics_stats * stats) {
+    struct graph_analytics_stats local;
+    struct graph_analytics_job job;
+
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    if (graph == NULL || labels == NULL) {
+        return false;
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.graph = graph;
+    job.run = __graph_analytics_wcc_run;
+    job.labels = labels;
+
+    if (!__graph_analytics_run(&job, threads)) {
+        free(job.threads);
+        return false;
+    }
+
+    __graph_analytics_finish(&job, stats);
+    return true;
+}
+
+// Appends a vertex to a thread's queue for the next level.
+static inline bool __graph_analytics_push(struct graph_analytics_thread * t, unsigned int vertex) {
+    if (t->next_count == t->next_capacity) {
+        size_t capacity = t->next_capacity == 0 ? 1024 : t->next_capacity * 2;
+        unsigned int * next = realloc(t->next, capacity * sizeof(unsigned int));
+
+        if (next == NULL) {
+            return false;
+        }
+
+        t->next = next;
+        t->next_capacity = capacity;
+    }
+
+    t->next[t->next_count] = vertex;
+    t->next_count += 1;
+    return true;
+}
+
+// Expands one level of a k-hop search: claims chunks of the frontier and
+// the undiscovered neighbors of its vertices, by compare-and-swap on
+// their distance, so the distances array is the visited set too.
+static void __graph_analytics_k_hop_expand(struct graph_analytics_thread * t) {
+    struct graph_analytics_job * job = t->job;
+    const struct graph * graph = job->graph;
+    unsigned int * distances = job->distances;
+    unsigned int depth = job->depth + 1;
+    size_t begin, end;
+
+    t->next_count = 0;
+
+    while (!t->failed && __graph_analytics_claim(job, job->frontier_size, &begin, &end)) {
+        for (size_t i = begin; i < end && !t->failed; i++) {
+            unsigned int vertex = job->frontier[i];
+
+            for (uint64_t e = graph->offsets[vertex]; e < graph->offsets[vertex + 1]; e++) {
+                unsigned int neighbor = graph->neighbors[e];
+                unsigned int expected = BFS_UNREACHABLE;
+
+                if (__atomic_load_n(&distances[neighbor], __ATOMIC_RELAXED) != BFS_UNREACHABLE ||
+                    !__atomic_compare_exchange_n(&distances[neighbor], &expected, depth, false,
+                                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                    continue;
+                }
+
+                if (!__graph_analytics_push(t, neighbor)) {
+                    t->failed = true;
+                    break;
+                }
+            }
+            t->edges_traversed += graph_degree(graph, vertex);
+        }
+    }
+}
+
+// k-hop neighborhood search, on every thread.
+static void __graph_analytics_k_hop_run(struct graph_analytics_thread * t) {
+    struct graph_analytics_job * job = t->job;
+    const struct graph * graph = job->graph;
+    size_t first = __graph_analytics_split(job, graph->vertex_count, t->id);
+    size_t last = __graph_analytics_split(job, graph->vertex_count, t->id + 1);
+
+    for (size_t v = first; v < last; v++) {
+        job->distances[v] = BFS_UNREACHABLE;
+    }
+    pthread_barrier_wait(&job->barrier);
+
+    if (t->id == 0) {
+        for (size_t i = 0; i < job->seed_count; i++) {
+            if (job->distances[job->seeds[i]] != 0) {
+                job->distances[job->seeds[i]] = 0;
+                job->frontier[job->frontier_size++] = job->seeds[i];
+            }
+        }
+        job->reached = job->frontier_size;
+        job->done = job->frontier_size == 0 || job->hops == 0;
+    }
+    pthread_barrier_wait(&job->barrier);
+
+    while (!job->done) {
+        __graph_analytics_k_hop_expand(t);
+        pthread_barrier_wait(&job->barrier);
+
+        // Every thread is done reading the frontier: lay the queues out
+        // back to back over it, on one thread since it is a loop over
+        // threads.
+        //
+        if (t->id == 0) {
+            size_t total = 0;
+
+            for (unsigned int i = 0; i < job->thread_count; i++) {
+                job->threads[i].next_offset = total;
+                total += job->threads[i].next_count;
+                job->failed |= job->threads[i].failed;
+            }
+
+            job->depth += 1;
+            job->reached += total;
+            job->frontier_size = total;
+            job->done = total == 0 || job->depth == job->hops || job->failed;
+            atomic_store(&job->cursor, 0);
+        }
+        pthread_barrier_wait(&job->barrier);
+
+        if (job->done) {
+            return;
+        }
+
+        memcpy(job->frontier + t->next_offset, t->next, t->next_count * sizeof(unsigned int));
+        pthread_barrier_wait(&job->barrier);
+    }
+}
+
+// Computes the distance from a seed set to every vertex within hops.
+bool graph_analytics_k_hop(const struct graph * graph,
+                           unsigned int threads,
+                           const unsigned int * seeds,
+                           size_t seed_count,
+                           unsigned int hops,
+                           unsigned int * distances,
+                           struct graph_analytics_stats * stats) {
+    struct graph_analytics_stats local;
+    struct graph_analytics_job job;
+
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    if (graph == NULL || distances == NULL || (seeds == NULL && seed_count != 0)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < seed_count; i++) {
+        if (seeds[i] >= graph->vertex_count) {
+            return false;
+        }
+    }
+
+    memset(&job, 0, sizeof(job));
+    job.graph = graph;
+    job.run = __graph_analytics_k_hop_run;
+    job.distances = distances;
+    job.seeds = seeds;
+    job.seed_count = seed_count;
+    job.hops = hops;
+    job.frontier = (unsigned int *)malloc(((size_t)graph->vertex_count + 1) * sizeof(unsigned int));
+
+    if (job.frontier == NULL || !__graph_analytics_run(&job, threads)) {
+        free(job.frontier);
+        free(job.threads);
+        return false;
+    }
+
+    __graph_analytics_finish(&job, stats);
+    stats->count = job.reached;
+    stats->levels = job.depth;
+    free(job.frontier);
+
+    return !job.failed;
+}
+
+// Creates a file of count unsigned ints and maps it.
+unsigned int * graph_analytics_map_output(const char * path, size_t count) {
+
+    if (path == NULL || count == 0) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    size_t length = count * sizeof(unsigned int);
+    void * mapping = MAP_FAILED;
+
+    if (ftruncate(fd, (off_t)length) == 0) {
+        mapping = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    return (mapping == MAP_FAILED) ? NULL : (unsigned int *)mapping;
+}
+
+// Unmaps a file mapped by graph_analytics_map_output().
+bool graph_analytics_unmap_output(unsigned int * array, size_t count) {
+
+    if (array == NULL) {
+        return false;
+    }
+
+    return munmap(array, count * sizeof(unsigned int)) == 0;
+}
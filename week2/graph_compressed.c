@@ -0,0 +1,131 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph_compressed.h"
+
+#include <stdlib.h>
+
+// Returns the number of bytes a varint takes.
+static unsigned int __graph_compressed_varint_length(uint64_t value) {
+    unsigned int length = 1;
+
+    while (value >= 0x80) {
+        value >>= 7;
+        length += 1;
+    }
+
+    return length;
+}
+
+// Writes a varint, returns the byte after it.
+static unsigned char * __graph_compressed_write_varint(unsigned char * p, uint64_t value) {
+    while (value >= 0x80) {
+        *p++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+
+    *p++ = (unsigned char)value;
+    return p;
+}
+
+// Returns the value stored for the e-th neighbor of vertex: zigzag of
+// the difference from the vertex for the first, plain difference from
+// the previous neighbor after that.
+static uint64_t __graph_compressed_value(const struct graph * graph, unsigned int vertex, uint64_t e) {
+    if (e == graph->offsets[vertex]) {
+        int64_t difference = (int64_t)graph->neighbors[e] - (int64_t)vertex;
+        return ((uint64_t)difference << 1) ^ (uint64_t)(difference >> 63);
+    }
+
+    return graph->neighbors[e] - graph->neighbors[e - 1];
+}
+
+// Builds the compressed form of a graph in two passes: sizes, then data.
+struct graph_compressed * graph_compress(const struct graph * graph) {
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    struct graph_compressed * compressed =
+        (struct graph_compressed *)calloc(1, sizeof(struct graph_compressed));
+
+    if (compressed == NULL) {
+        return NULL;
+    }
+
+    compressed->vertex_count = graph->vertex_count;
+    compressed->edge_count = graph->edge_count;
+    compressed->offsets = (uint64_t *)malloc(((size_t)graph->vertex_count + 1) * sizeof(uint64_t));
+
+    if (compressed->offsets == NULL) {
+        graph_compressed_delete(compressed);
+        return NULL;
+    }
+
+    compressed->offsets[0] = 0;
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        uint64_t length = 0;
+
+        for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+            length += __graph_compressed_varint_length(__graph_compressed_value(graph, v, e));
+        }
+
+        compressed->offsets[v + 1] = compressed->offsets[v] + length;
+    }
+
+    compressed->data_length = compressed->offsets[graph->vertex_count];
+    compressed->data = (unsigned char *)malloc(compressed->data_length == 0 ? 1 : compressed->data_length);
+
+    if (compressed->data == NULL) {
+        graph_compressed_delete(compressed);
+        return NULL;
+    }
+
+    unsigned char * p = compressed->data;
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+            p = __graph_compressed_write_varint(p, __graph_compressed_value(graph, v, e));
+        }
+    }
+
+    return compressed;
+}
+
+// Returns the total size of a compressed graph in bytes.
+uint64_t graph_compressed_bytes(const struct graph_compressed * graph) {
+    return ((uint64_t)graph->vertex_count + 1) * sizeof(uint64_t) + graph->data_length;
+}
+
+// Frees a compressed graph.
+void graph_compressed_delete(struct graph_compressed * graph) {
+
+    if (graph == NULL) {
+        return;
+    }
+
+    free(graph->offsets);
+    free(graph->data);
+    free(graph);
+}
@@ -0,0 +1,130 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _GRAPH_COMPRESSED_H
+#define _GRAPH_COMPRESSED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.h"
+
+// Compressed CSR: every sorted neighbor list is stored as a sequence of
+// byte-aligned varints (7 bits per byte, high bit set on all but the
+// last byte). The first neighbor of v is stored as the zigzag encoded
+// difference from v, so that reordered graphs (see graph_reorder())
+// with neighbors close to their vertex take one byte; each following
+// one as the non-negative difference from the previous neighbor.
+//
+// offsets[v] .. offsets[v + 1] are the bytes of vertex v in data, so an
+// empty list takes no space and the degree is only known by decoding.
+// Lists are decoded on the fly with a graph_compressed_cursor.
+//
+struct graph_compressed {
+    unsigned int vertex_count;
+    uint64_t edge_count;
+    uint64_t * offsets;
+    unsigned char * data;
+    uint64_t data_length;
+};
+
+// Walks the neighbor list of one vertex, see graph_compressed_begin().
+//
+struct graph_compressed_cursor {
+    const unsigned char * p;
+    const unsigned char * end;
+    unsigned int previous;
+    bool first;
+};
+
+// Builds the compressed form of a graph.
+// \param graph : Pointer to graph.
+// Returns a new compressed graph on success, NULL on failure.
+//
+struct graph_compressed * graph_compress(const struct graph * graph);
+
+// Returns the total size of a compressed graph (offsets and data) in
+// bytes, to compare with graph_bytes().
+// \param graph : Pointer to compressed graph.
+//
+uint64_t graph_compressed_bytes(const struct graph_compressed * graph);
+
+// Frees a compressed graph.
+// \param graph : Compressed graph to free, may be NULL.
+//
+void graph_compressed_delete(struct graph_compressed * graph);
+
+// Starts decoding the neighbor list of a vertex.
+// \param graph  : Pointer to compressed graph.
+// \param vertex : Vertex whose out-neighbors to walk.
+// \param cursor : Pointer to cursor (provided by caller).
+//
+static inline void graph_compressed_begin(const struct graph_compressed * graph,
+                                          unsigned int vertex,
+                                          struct graph_compressed_cursor * cursor) {
+    cursor->p = graph->data + graph->offsets[vertex];
+    cursor->end = graph->data + graph->offsets[vertex + 1];
+    cursor->previous = vertex;
+    cursor->first = true;
+}
+
+// Decodes the next neighbor.
+// \param cursor   : Pointer to cursor.
+// \param neighbor : Set to the neighbor decoded.
+// Returns TRUE if there was one, FALSE at the end of the list.
+//
+static inline bool graph_compressed_next(struct graph_compressed_cursor * cursor,
+                                         unsigned int * neighbor) {
+    if (cursor->p == cursor->end) {
+        return false;
+    }
+
+    // Most differences fit in one byte, keep that path short.
+    //
+    uint64_t value = *cursor->p++;
+    if (value & 0x80) {
+        value &= 0x7f;
+        for (unsigned int shift = 7;; shift += 7) {
+            unsigned char byte = *cursor->p++;
+            value |= (uint64_t)(byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+    }
+
+    if (cursor->first) {
+        cursor->first = false;
+        cursor->previous += (unsigned int)((value >> 1) ^ (0 - (value & 1)));
+    } else {
+        cursor->previous += (unsigned int)value;
+    }
+
+    *neighbor = cursor->previous;
+    return true;
+}
+
+#endif
@@ -0,0 +1,444 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "graph.h"
+#include "rng.h"
+
+// Deterministic synthetic graph generator, so BFS benchmarks can run
+// without downloading the Wikipedia adjacency matrix. The same seed,
+// scale and edge factor always produce the same file.
+//
+// Graph types:
+//  rmat    : R-MAT / Kronecker graph with the Graph500 initiator
+//            (a, b, c, d) = (0.57, 0.19, 0.19, 0.05) and a seeded vertex
+//            relabeling, giving a skewed, small-world degree distribution
+//            much like a web link graph.
+//  uniform : Erdos-Renyi style graph with endpoints drawn uniformly.
+//  grid    : 2D grid with edges in both directions between horizontal and
+//            vertical neighbours, a high diameter worst case for BFS.
+//
+// The graph has 2^scale vertices and, for rmat and uniform, about
+// edge_factor * 2^scale directed edges. Self loops and duplicate edges
+// are dropped. Output is a Matrix Market "coordinate pattern general"
+// file with 1-based (source, target) entries, the same layout as
+// wikipedia-20070206.mtx, or, when the output name ends in ".csr", the
+// binary CSR cache format that graph_load() maps directly.
+//
+// -w and -W give the edges weights (see graph_weights.h): each edge
+// weighs 0 with the -w percent probability, otherwise a uniform weight
+// from 1 to -W (default 1, the 0/1 weights of a 0-1 BFS). The file
+// becomes "coordinate integer general" with the weight as the value of
+// each entry. The weights are drawn after the edges, so the graph
+// itself is the same with or without them. Matrix Market output only,
+// the binary format has no room for weights.
+//
+// Usage: graph_generator [-t rmat|uniform|grid] [-s scale] [-e edge_factor]
+//                        [-S seed] [-w zero_weight_percent] [-W max_weight]
+//                        -o output.mtx|output.csr
+
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
+enum graph_type {
+    GRAPH_RMAT,
+    GRAPH_UNIFORM,
+    GRAPH_GRID
+};
+
+struct generator_options {
+    enum graph_type type;
+    unsigned int scale;
+    unsigned int edge_factor;
+    uint64_t seed;
+    // Percent of edges weighing 0, -1 for an unweighted graph.
+    int zero_weight_percent;
+    // Largest weight of the other edges, 0 for an unweighted graph.
+    unsigned int max_weight;
+    const char * output;
+};
+
+// Edges are packed as (source << 32 | target) so that sorting them
+// orders by source, then target.
+struct edge_list {
+    uint64_t * edges;
+    size_t count;
+    size_t capacity;
+};
+
+static bool edge_list_add(struct edge_list * list, uint32_t source, uint32_t target) {
+    if (source == target) {
+        return true;
+    }
+
+    if (list->count == list->capacity) {
+        size_t new_capacity = list->capacity == 0 ? 1024 : list->capacity * 2;
+        uint64_t * edges = realloc(list->edges, new_capacity * sizeof(uint64_t));
+
+        if (edges == NULL) {
+            return false;
+        }
+
+        list->edges = edges;
+        list->capacity = new_capacity;
+    }
+
+    list->edges[list->count++] = ((uint64_t)source << 32) | target;
+    return true;
+}
+
+// Returns a seeded random permutation of 0 .. n - 1.
+static uint32_t * random_permutation(uint64_t n, struct rng * rng) {
+    uint32_t * perm = malloc(n * sizeof(uint32_t));
+
+    if (perm == NULL) {
+        return NULL;
+    }
+
+    for (uint64_t i = 0; i < n; i++) {
+        perm[i] = (uint32_t)i;
+    }
+
+    for (uint64_t i = n; i > 1; i--) {
+        uint64_t j = rng_bounded(rng, i);
+        uint32_t tmp = perm[i - 1];
+        perm[i - 1] = perm[j];
+        perm[j] = tmp;
+    }
+
+    return perm;
+}
+
+static bool generate_rmat(const struct generator_options * opts,
+                          struct rng * rng,
+                          struct edge_list * list) {
+    uint64_t n = 1ull << opts->scale;
+    uint64_t m = n * opts->edge_factor;
+
+    // Without relabeling, vertex 0 would be the highest degree hub and
+    // degree would correlate with ID.
+    //
+    uint32_t * perm = random_permutation(n, rng);
+    if (perm == NULL) {
+        return false;
+    }
+
+    for (uint64_t e = 0; e < m; e++) {
+        uint32_t source = 0;
+        uint32_t target = 0;
+
+        for (unsigned int bit = 0; bit < opts->scale; bit++) {
+            double r = rng_double(rng);
+
+            if (r < RMAT_A) {
+                // Top left quadrant.
+            } else if (r < RMAT_A + RMAT_B) {
+                target |= 1u << bit;
+            } else if (r < RMAT_A + RMAT_B + RMAT_C) {
+                source |= 1u << bit;
+            } else {
+                source |= 1u << bit;
+                target |= 1u << bit;
+            }
+        }
+
+        if (!edge_list_add(list, perm[source], perm[target])) {
+            free(perm);
+            return false;
+        }
+    }
+
+    free(perm);
+    return true;
+}
+
+static bool generate_uniform(const struct generator_options * opts,
+                             struct rng * rng,
+                             struct edge_list * list) {
+    uint64_t n = 1ull << opts->scale;
+    uint64_t m = n * opts->edge_factor;
+
+    for (uint64_t e = 0; e < m; e++) {
+        uint32_t source = (uint32_t)rng_bounded(rng, n);
+        uint32_t target = (uint32_t)rng_bounded(rng, n);
+
+        if (!edge_list_add(list, source, target)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool generate_grid(const struct generator_options * opts,
+                          struct edge_list * list) {
+    uint64_t width = 1ull << ((opts->scale + 1) / 2);
+    uint64_t height = (1ull << opts->scale) / width;
+
+    for (uint64_t y = 0; y < height; y++) {
+        for (uint64_t x = 0; x < width; x++) {
+            uint32_t v = (uint32_t)(y * width + x);
+            bool ok = true;
+
+            if (x + 1 < width) {
+                ok = ok && edge_list_add(list, v, v + 1) && edge_list_add(list, v + 1, v);
+            }
+            if (y + 1 < height) {
+                ok = ok && edge_list_add(list, v, (uint32_t)(v + width)) &&
+                     edge_list_add(list, (uint32_t)(v + width), v);
+            }
+
+            if (!ok) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static int compare_edges(const void * a, const void * b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Sorts the edges and removes duplicates.
+static void edge_list_sort_unique(struct edge_list * list) {
+    size_t unique = 0;
+
+    qsort(list->edges, list->count, sizeof(uint64_t), compare_edges);
+
+    for (size_t i = 0; i < list->count; i++) {
+        if (unique == 0 || list->edges[i] != list->edges[unique - 1]) {
+            list->edges[unique++] = list->edges[i];
+        }
+    }
+
+    list->count = unique;
+}
+
+// Appends the decimal representation of value to buf, returns the new end.
+static char * format_u32(char * buf, uint32_t value) {
+    char digits[10];
+    int length = 0;
+
+    do {
+        digits[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (length > 0) {
+        *buf++ = digits[--length];
+    }
+
+    return buf;
+}
+
+static bool write_matrix_market(const struct generator_options * opts,
+                                const struct edge_list * list) {
+    static const char * type_names[] = {"rmat", "uniform", "grid"};
+    uint64_t n = 1ull << opts->scale;
+    bool weighted = opts->max_weight != 0;
+    FILE * out = fopen(opts->output, "w");
+    char line[48];
+    struct rng rng;
+
+    if (out == NULL) {
+        perror(opts->output);
+        return false;
+    }
+
+    // A stream of its own, so that weights do not change the edges.
+    //
+    rng_seed(&rng, opts->seed ^ 0x9e3779b97f4a7c15ull);
+
+    fprintf(out, "%%%%MatrixMarket matrix coordinate %s general\n", weighted ? "integer" : "pattern");
+    fprintf(out, "%% generated by graph_generator -t %s -s %u -e %u -S %llu",
+            type_names[opts->type], opts->scale, opts->edge_factor,
+            (unsigned long long)opts->seed);
+    if (weighted) {
+        fprintf(out, " -w %d -W %u", opts->zero_weight_percent, opts->max_weight);
+    }
+    fprintf(out, "\n%llu %llu %zu\n", (unsigned long long)n, (unsigned long long)n, list->count);
+
+    for (size_t i = 0; i < list->count; i++) {
+        char * end = format_u32(line, (uint32_t)(list->edges[i] >> 32) + 1);
+        *end++ = ' ';
+        end = format_u32(end, (uint32_t)list->edges[i] + 1);
+        if (weighted) {
+            bool zero = rng_bounded(&rng, 100) < (uint64_t)opts->zero_weight_percent;
+            *end++ = ' ';
+            end = format_u32(end, zero ? 0 : 1 + (uint32_t)rng_bounded(&rng, opts->max_weight));
+        }
+        *end++ = '\n';
+        fwrite(line, 1, (size_t)(end - line), out);
+    }
+
+    if (fclose(out) != 0) {
+        perror(opts->output);
+        return false;
+    }
+
+    return true;
+}
+
+static bool write_binary(const struct generator_options * opts,
+                         const struct edge_list * list) {
+    struct graph_edge * edges = malloc((list->count == 0 ? 1 : list->count) * sizeof(struct graph_edge));
+
+    if (edges == NULL) {
+        fprintf(stderr, "Out of memory converting edges\n");
+        return false;
+    }
+
+    for (size_t i = 0; i < list->count; i++) {
+        edges[i].source = (unsigned int)(list->edges[i] >> 32);
+        edges[i].target = (unsigned int)list->edges[i];
+    }
+
+    struct graph * graph = graph_create_from_edges((unsigned int)(1ull << opts->scale), edges, list->count);
+    free(edges);
+
+    bool ok = graph != NULL && graph_save_binary(graph, opts->output);
+    graph_delete(graph);
+
+    return ok;
+}
+
+// Returns whether the output file should be in binary CSR form.
+static bool output_is_binary(const char * path) {
+    size_t length = strlen(path);
+
+    return length >= 4 && strcmp(path + length - 4, ".csr") == 0;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s [-t rmat|uniform|grid] [-s scale] [-e edge_factor] "
+                    "[-S seed] [-w zero_weight_percent] [-W max_weight] -o output.mtx|output.csr\n", program);
+}
+
+int main(int argc, char ** argv) {
+    struct generator_options opts = {
+        .type = GRAPH_RMAT,
+        .scale = 16,
+        .edge_factor = 16,
+        .seed = 1,
+        .zero_weight_percent = -1,
+        .max_weight = 0,
+        .output = NULL
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:s:e:S:w:W:o:h")) != -1) {
+        switch (opt) {
+        case 't':
+            if (strcmp(optarg, "rmat") == 0) {
+                opts.type = GRAPH_RMAT;
+            } else if (strcmp(optarg, "uniform") == 0) {
+                opts.type = GRAPH_UNIFORM;
+            } else if (strcmp(optarg, "grid") == 0) {
+                opts.type = GRAPH_GRID;
+            } else {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 's':
+            opts.scale = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'e':
+            opts.edge_factor = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'S':
+            opts.seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'w':
+            opts.zero_weight_percent = (int)strtoul(optarg, NULL, 10);
+            break;
+        case 'W':
+            opts.max_weight = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'o':
+            opts.output = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Either weight option turns weights on.
+    //
+    if (opts.zero_weight_percent >= 0 || opts.max_weight != 0) {
+        opts.zero_weight_percent = opts.zero_weight_percent < 0 ? 0 : opts.zero_weight_percent;
+        opts.max_weight = opts.max_weight == 0 ? 1 : opts.max_weight;
+    }
+
+    // Vertex IDs are unsigned int throughout the queue and BFS code.
+    //
+    if (opts.output == NULL || opts.scale == 0 || opts.scale > 31 || opts.edge_factor == 0 ||
+        opts.zero_weight_percent > 100 || (opts.max_weight != 0 && output_is_binary(opts.output))) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct rng rng;
+    struct edge_list list = {0};
+    bool ok = false;
+
+    rng_seed(&rng, opts.seed);
+
+    switch (opts.type) {
+    case GRAPH_RMAT:
+        ok = generate_rmat(&opts, &rng, &list);
+        break;
+    case GRAPH_UNIFORM:
+        ok = generate_uniform(&opts, &rng, &list);
+        break;
+    case GRAPH_GRID:
+        ok = generate_grid(&opts, &list);
+        break;
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Out of memory generating edges\n");
+        free(list.edges);
+        return 1;
+    }
+
+    edge_list_sort_unique(&list);
+    ok = output_is_binary(opts.output) ? write_binary(&opts, &list) : write_matrix_market(&opts, &list);
+    free(list.edges);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,379 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph_landmarks.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bfs.h"
+
+// Rounds up to a page boundary, as the sections of the file start on one.
+static uint64_t __graph_landmarks_align(uint64_t offset) {
+    return (offset + GRAPH_CACHE_ALIGNMENT - 1) & ~(uint64_t)(GRAPH_CACHE_ALIGNMENT - 1);
+}
+
+// Hashes the CSR arrays of a graph, so that an index is never used with
+// a graph it was not built for.
+static uint64_t __graph_landmarks_fingerprint(const struct graph * graph) {
+    uint64_t hash = 0xcbf29ce484222325ull ^ graph->vertex_count ^ (graph->edge_count << 32);
+
+    for (uint64_t v = 0; v <= graph->vertex_count; v++) {
+        hash = (hash ^ graph->offsets[v]) * 0x100000001b3ull;
+    }
+    for (uint64_t e = 0; e < graph->edge_count; e++) {
+        hash = (hash ^ graph->neighbors[e]) * 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+// Picks the count vertices of highest total degree, best first.
+static void __graph_landmarks_choose(const struct graph * graph,
+                                     unsigned int * landmarks,
+                                     uint64_t * degrees,
+                                     unsigned int count) {
+    memset(degrees, 0, (size_t)graph->vertex_count * sizeof(uint64_t));
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        degrees[v] += graph_degree(graph, v);
+        for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+            degrees[graph->neighbors[e]] += 1;
+        }
+    }
+
+    // Insertion into a short sorted list: count is small and most
+    // vertices fall off its end at the first comparison.
+    //
+    unsigned int chosen = 0;
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        if (chosen == count && degrees[v] <= degrees[landmarks[count - 1]]) {
+            continue;
+        }
+
+        unsigned int i = (chosen < count) ? chosen++ : count - 1;
+        while (i > 0 && degrees[landmarks[i - 1]] < degrees[v]) {
+            landmarks[i] = landmarks[i - 1];
+            i -= 1;
+        }
+        landmarks[i] = v;
+    }
+}
+
+// Fills one column of a distance array with a BFS from a landmark.
+// Returns FALSE if a distance does not fit in 16 bits.
+static bool __graph_landmarks_fill(struct bfs_workspace * workspace,
+                                   const struct graph * graph,
+                                   unsigned int landmark,
+                                   unsigned int * distances,
+                                   uint16_t * column,
+                                   unsigned int stride) {
+    bfs_workspace_distances(workspace, graph, landmark, distances, NULL);
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        if (distances[v] == BFS_UNREACHABLE) {
+            column[(size_t)v * stride] = GRAPH_LANDMARKS_UNREACHABLE;
+        } else if (distances[v] >= GRAPH_LANDMARKS_UNREACHABLE) {
+            return false;
+        } else {
+            column[(size_t)v * stride] = (uint16_t)distances[v];
+        }
+    }
+
+    return true;
+}
+
+// Builds the index with two BFS per landmark.
+struct graph_landmarks * graph_landmarks_build(const struct graph * graph, unsigned int count) {
+
+    if (graph == NULL || count == 0 || count > GRAPH_LANDMARKS_MAX || count > graph->vertex_count) {
+        return NULL;
+    }
+
+    size_t cells = (size_t)graph->vertex_count * count;
+    struct graph_landmarks * landmarks = (struct graph_landmarks *)calloc(1, sizeof(struct graph_landmarks));
+    struct bfs_workspace * workspace = bfs_workspace_create(graph->vertex_count);
+    unsigned int * distances = (unsigned int *)malloc(((size_t)graph->vertex_count + 1) * sizeof(uint64_t));
+    struct graph * transpose = graph->transpose;
+
+    if (transpose == NULL) {
+        transpose = graph_transpose(graph);
+    }
+
+    bool ok = landmarks != NULL && workspace != NULL && distances != NULL && transpose != NULL;
+
+    if (ok) {
+        landmarks->vertex_count = graph->vertex_count;
+        landmarks->count = count;
+        landmarks->landmarks = (unsigned int *)malloc(count * sizeof(unsigned int));
+        landmarks->from = (uint16_t *)malloc(cells * sizeof(uint16_t));
+        landmarks->to = (uint16_t *)malloc(cells * sizeof(uint16_t));
+        ok = landmarks->landmarks != NULL && landmarks->from != NULL && landmarks->to != NULL;
+    }
+
+    // distances doubles as the degree array while choosing, hence its
+    // 64-bit entries.
+    //
+    if (ok) {
+        __graph_landmarks_choose(graph, landmarks->landmarks, (uint64_t *)distances, count);
+    }
+
+    for (unsigned int l = 0; ok && l < count; l++) {
+        ok = __graph_landmarks_fill(workspace, graph, landmarks->landmarks[l], distances,
+                                    &landmarks->from[l], count) &&
+             __graph_landmarks_fill(workspace, transpose, landmarks->landmarks[l], distances,
+                                    &landmarks->to[l], count);
+    }
+
+    if (transpose != graph->transpose) {
+        graph_delete(transpose);
+    }
+    bfs_workspace_delete(workspace);
+    free(distances);
+
+    if (!ok) {
+        graph_landmarks_delete(landmarks);
+        return NULL;
+    }
+
+    return landmarks;
+}
+
+// Writes a buffer completely at the given file offset.
+static bool __graph_landmarks_write_at(int fd, const void * buf, uint64_t length, uint64_t offset) {
+    const char * p = (const char *)buf;
+
+    while (length > 0) {
+        ssize_t written = pwrite(fd, p, length, (off_t)offset);
+
+        if (written <= 0) {
+            return false;
+        }
+
+        p += written;
+        length -= (uint64_t)written;
+        offset += (uint64_t)written;
+    }
+
+    return true;
+}
+
+// Writes an index to a file.
+bool graph_landmarks_save(const struct graph_landmarks * landmarks,
+                          const struct graph * graph,
+                          const char * path) {
+    struct graph_landmarks_header header;
+    char tmp_path[4096];
+
+    if (landmarks == NULL || graph == NULL || path == NULL || landmarks->vertex_count != graph->vertex_count) {
+        return false;
+    }
+
+    uint64_t column_length = (uint64_t)landmarks->vertex_count * landmarks->count * sizeof(uint16_t);
+
+    memset(&header, 0, sizeof(header));
+    header.magic = GRAPH_LANDMARKS_MAGIC;
+    header.version = GRAPH_LANDMARKS_VERSION;
+    header.vertex_count = graph->vertex_count;
+    header.edge_count = graph->edge_count;
+    header.order = graph->order;
+    header.fingerprint = __graph_landmarks_fingerprint(graph);
+    header.count = landmarks->count;
+    header.landmarks_offset = __graph_landmarks_align(sizeof(header));
+    header.from_offset = __graph_landmarks_align(header.landmarks_offset + landmarks->count * sizeof(unsigned int));
+    header.to_offset = __graph_landmarks_align(header.from_offset + column_length);
+
+    // Same as the CSR cache: write to a temporary name and rename.
+    //
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.%ld", path, (long)getpid());
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(tmp_path);
+        return false;
+    }
+
+    bool ok = __graph_landmarks_write_at(fd, &header, sizeof(header), 0) &&
+              __graph_landmarks_write_at(fd, landmarks->landmarks, landmarks->count * sizeof(unsigned int),
+                                         header.landmarks_offset) &&
+              __graph_landmarks_write_at(fd, landmarks->from, column_length, header.from_offset) &&
+              __graph_landmarks_write_at(fd, landmarks->to, column_length, header.to_offset);
+
+    if (close(fd) != 0 || !ok || rename(tmp_path, path) != 0) {
+        perror(path);
+        unlink(tmp_path);
+        return false;
+    }
+
+    return true;
+}
+
+// Maps an index file, checking it was built for this graph.
+struct graph_landmarks * graph_landmarks_load(const char * path, const struct graph * graph) {
+
+    if (path == NULL || graph == NULL) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct graph_landmarks_header)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t length = (size_t)st.st_size;
+    void * mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    const struct graph_landmarks_header * header = (const struct graph_landmarks_header *)mapping;
+    uint64_t column_length = header->vertex_count * header->count * sizeof(uint16_t);
+
+    bool valid = header->magic == GRAPH_LANDMARKS_MAGIC &&
+                 header->version == GRAPH_LANDMARKS_VERSION &&
+                 header->vertex_count == graph->vertex_count &&
+                 header->edge_count == graph->edge_count &&
+                 header->order == graph->order &&
+                 header->count != 0 && header->count <= GRAPH_LANDMARKS_MAX &&
+                 header->landmarks_offset <= length &&
+                 header->count * sizeof(unsigned int) <= length - header->landmarks_offset &&
+                 header->from_offset <= length && column_length <= length - header->from_offset &&
+                 header->to_offset <= length && column_length <= length - header->to_offset &&
+                 header->fingerprint == __graph_landmarks_fingerprint(graph);
+
+    struct graph_landmarks * landmarks = valid ? (struct graph_landmarks *)calloc(1, sizeof(struct graph_landmarks)) : NULL;
+    if (landmarks == NULL) {
+        munmap(mapping, length);
+        return NULL;
+    }
+
+    landmarks->vertex_count = graph->vertex_count;
+    landmarks->count = (unsigned int)header->count;
+    landmarks->landmarks = (unsigned int *)((char *)mapping + header->landmarks_offset);
+    landmarks->from = (uint16_t *)((char *)mapping + header->from_offset);
+    landmarks->to = (uint16_t *)((char *)mapping + header->to_offset);
+    landmarks->mapping = mapping;
+    landmarks->mapping_length = length;
+
+    return landmarks;
+}
+
+// Returns where the index of a graph file is kept.
+void graph_landmarks_path(const char * graph_path, char * buf, size_t size) {
+    size_t length = strlen(graph_path);
+    bool mtx = length >= 4 && strcmp(graph_path + length - 4, ".mtx") == 0;
+
+    snprintf(buf, size, "%s%s%s", graph_path, mtx ? GRAPH_CACHE_SUFFIX : "", GRAPH_LANDMARKS_SUFFIX);
+}
+
+// Maps the index kept next to a graph file, or builds and writes it.
+struct graph_landmarks * graph_landmarks_load_or_build(const char * graph_path,
+                                                       const struct graph * graph,
+                                                       unsigned int count) {
+    char path[4096];
+
+    if (graph_path == NULL) {
+        return NULL;
+    }
+
+    graph_landmarks_path(graph_path, path, sizeof(path));
+    struct graph_landmarks * landmarks = graph_landmarks_load(path, graph);
+
+    if (landmarks != NULL && landmarks->count == count) {
+        return landmarks;
+    }
+
+    graph_landmarks_delete(landmarks);
+    landmarks = graph_landmarks_build(graph, count);
+
+    if (landmarks != NULL) {
+        graph_landmarks_save(landmarks, graph, path);
+    }
+
+    return landmarks;
+}
+
+// Returns the size of the distance arrays of an index in bytes.
+uint64_t graph_landmarks_bytes(const struct graph_landmarks * landmarks) {
+    return 2 * (uint64_t)landmarks->vertex_count * landmarks->count * sizeof(uint16_t);
+}
+
+// Frees an index, unmapping it if it came from a file.
+void graph_landmarks_delete(struct graph_landmarks * landmarks) {
+
+    if (landmarks == NULL) {
+        return;
+    }
+
+    if (landmarks->mapping != NULL) {
+        munmap(landmarks->mapping, landmarks->mapping_length);
+    } else {
+        free(landmarks->landmarks);
+        free(landmarks->from);
+        free(landmarks->to);
+    }
+
+    free(landmarks);
+}
+
+// Computes bounds on the distance from source to target.
+bool graph_landmarks_bounds(const struct graph_landmarks * landmarks,
+                            unsigned int source,
+                            unsigned int target,
+                            unsigned int * lower,
+                            unsigned int * upper) {
+    const uint16_t * to_s = &landmarks->to[(size_t)source * landmarks->count];
+    const uint16_t * from_t = &landmarks->from[(size_t)target * landmarks->count];
+
+    *lower = graph_landmarks_lower_bound(landmarks, source, from_t,
+                                         &landmarks->to[(size_t)target * landmarks->count]);
+    *upper = UINT32_MAX;
+
+    if (*lower == UINT32_MAX) {
+        *lower = 0;
+        return false;
+    }
+
+    for (unsigned int l = 0; l < landmarks->count; l++) {
+        if (to_s[l] != GRAPH_LANDMARKS_UNREACHABLE && from_t[l] != GRAPH_LANDMARKS_UNREACHABLE &&
+            (unsigned int)to_s[l] + from_t[l] < *upper) {
+            *upper = (unsigned int)to_s[l] + from_t[l];
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,198 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _GRAPH_LANDMARKS_H
+#define _GRAPH_LANDMARKS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.h"
+
+// Landmark distance index: the BFS distances from and to a few landmark
+// vertices (the highest degree ones), for every vertex. By the triangle
+// inequality, for any landmark l
+//
+//   d(s, t) <= d(s, l) + d(l, t)
+//   d(s, t) >= d(l, t) - d(l, s)
+//   d(s, t) >= d(s, l) - d(t, l)
+//
+// so a query gets lower and upper bounds from 2k lookups. Some queries
+// are answered by the bounds alone (they meet, or one side proves t
+// unreachable), the rest have their search depth bounded and their
+// search pruned, see bfs_landmarks_path_exists().
+//
+// Distances are 16 bits, vertex-major: the k distances of a vertex share
+// a cache line. The index is written next to the binary CSR cache
+// (graph_landmarks_path()) and mapped by later runs, as long as it was
+// built for the same graph in the same order.
+//
+#define GRAPH_LANDMARKS_MAGIC 0x4b52414d444e414cull  /* "LANDMARK" */
+#define GRAPH_LANDMARKS_VERSION 1
+#define GRAPH_LANDMARKS_MAX 64
+#define GRAPH_LANDMARKS_SUFFIX ".landmarks"
+#define GRAPH_LANDMARKS_UNREACHABLE UINT16_MAX
+
+struct graph_landmarks {
+    unsigned int vertex_count;
+    unsigned int count;
+    unsigned int * landmarks;
+    // from[v * count + l] is the distance from landmarks[l] to v, to[]
+    // the distance from v to landmarks[l].
+    uint16_t * from;
+    uint16_t * to;
+    void * mapping;
+    size_t mapping_length;
+};
+
+struct graph_landmarks_header {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t vertex_count;
+    uint64_t edge_count;
+    uint64_t order;
+    // Hash of the CSR arrays the index was built from.
+    uint64_t fingerprint;
+    uint64_t count;
+    uint64_t landmarks_offset;
+    uint64_t from_offset;
+    uint64_t to_offset;
+};
+
+// Builds the index with one BFS from each landmark over the graph and
+// one over its transpose (built for the occasion if graph->transpose is
+// not set).
+// \param graph : Pointer to graph.
+// \param count : Number of landmarks, 1 to GRAPH_LANDMARKS_MAX.
+// Returns a new index on success, NULL on failure (including a graph
+// with BFS depths that do not fit in 16 bits).
+//
+struct graph_landmarks * graph_landmarks_build(const struct graph * graph, unsigned int count);
+
+// Writes an index to a file.
+// \param landmarks : Pointer to index.
+// \param graph     : Pointer to the graph it was built for.
+// \param path      : Path of the file to write, replaced atomically.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool graph_landmarks_save(const struct graph_landmarks * landmarks,
+                          const struct graph * graph,
+                          const char * path);
+
+// Maps an index file, checking it was built for this graph.
+// \param path  : Path to a file written by graph_landmarks_save().
+// \param graph : Pointer to graph.
+// Returns a new read-only index on success, NULL if the file is
+// missing, invalid or for another graph.
+//
+struct graph_landmarks * graph_landmarks_load(const char * path, const struct graph * graph);
+
+// Returns where the index of a graph file is kept: next to its binary
+// CSR cache.
+// \param graph_path : Path to a .mtx or binary cache file, as given to
+//                     graph_load().
+// \param buf        : Buffer (provided by caller) for the path.
+// \param size       : Size of buf.
+//
+void graph_landmarks_path(const char * graph_path, char * buf, size_t size);
+
+// Maps the index kept next to a graph file if it has count landmarks,
+// otherwise builds it and writes it there.
+// \param graph_path : Path to the graph file, as given to graph_load().
+// \param graph      : Pointer to the graph loaded from it.
+// \param count      : Number of landmarks.
+// Returns the index on success, NULL on failure. Failing to write the
+// file is not a failure.
+//
+struct graph_landmarks * graph_landmarks_load_or_build(const char * graph_path,
+                                                       const struct graph * graph,
+                                                       unsigned int count);
+
+// Returns the size of the distance arrays of an index in bytes.
+// \param landmarks : Pointer to index.
+//
+uint64_t graph_landmarks_bytes(const struct graph_landmarks * landmarks);
+
+// Frees an index, unmapping it if it came from a file.
+// \param landmarks : Index to free, may be NULL.
+//
+void graph_landmarks_delete(struct graph_landmarks * landmarks);
+
+// Computes bounds on the distance from source to target.
+// \param landmarks : Pointer to index.
+// \param source    : Vertex to start from.
+// \param target    : Vertex to look for.
+// \param lower     : Set to a lower bound on the distance.
+// \param upper     : Set to an upper bound on the distance, UINT32_MAX
+//                    if no landmark connects them.
+// Returns FALSE if some landmark proves there is no path, TRUE
+// otherwise.
+//
+bool graph_landmarks_bounds(const struct graph_landmarks * landmarks,
+                            unsigned int source,
+                            unsigned int target,
+                            unsigned int * lower,
+                            unsigned int * upper);
+
+// Computes a lower bound on the distance from vertex to target, given
+// the rows of target (see graph_landmarks_bounds()).
+// \param landmarks : Pointer to index.
+// \param vertex    : Vertex to start from.
+// \param from_t    : &landmarks->from[target * landmarks->count].
+// \param to_t      : &landmarks->to[target * landmarks->count].
+// Returns the bound, UINT32_MAX if some landmark proves there is no
+// path.
+//
+static inline unsigned int graph_landmarks_lower_bound(const struct graph_landmarks * landmarks,
+                                                       unsigned int vertex,
+                                                       const uint16_t * from_t,
+                                                       const uint16_t * to_t) {
+    const uint16_t * from_v = &landmarks->from[(size_t)vertex * landmarks->count];
+    const uint16_t * to_v = &landmarks->to[(size_t)vertex * landmarks->count];
+    unsigned int lower = 0;
+
+    for (unsigned int l = 0; l < landmarks->count; l++) {
+        // l reaches v but not t, or t reaches l but v does not: v cannot
+        // reach t.
+        //
+        if ((from_v[l] != GRAPH_LANDMARKS_UNREACHABLE && from_t[l] == GRAPH_LANDMARKS_UNREACHABLE) ||
+            (to_t[l] != GRAPH_LANDMARKS_UNREACHABLE && to_v[l] == GRAPH_LANDMARKS_UNREACHABLE)) {
+            return UINT32_MAX;
+        }
+
+        if (from_v[l] != GRAPH_LANDMARKS_UNREACHABLE && from_t[l] > from_v[l] &&
+            (unsigned int)(from_t[l] - from_v[l]) > lower) {
+            lower = from_t[l] - from_v[l];
+        }
+        if (to_t[l] != GRAPH_LANDMARKS_UNREACHABLE && to_v[l] > to_t[l] &&
+            (unsigned int)(to_v[l] - to_t[l]) > lower) {
+            lower = to_v[l] - to_t[l];
+        }
+    }
+
+    return lower;
+}
+
+#endif
@@ -0,0 +1,873 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Parallel Matrix Market parser. The file is mapped, the header parsed
+// serially, and the entries split across threads at newline boundaries.
+// Each thread parses its chunk with a hand-written integer scanner into
+// a private edge buffer, then the CSR arrays are built with a parallel
+// counting sort by source vertex:
+//  1. every thread atomically adds its edges to a shared degree array,
+//  2. one thread turns degrees into offsets (a prefix sum over vertices),
+//  3. every thread claims slots with an atomic cursor per source vertex
+//     and scatters its targets,
+//  4. threads sort the neighbor lists of disjoint vertex ranges, which
+//     also makes the result independent of the scatter order.
+//
+// The streaming variant never maps the file. A reader thread fills
+// GRAPH_STREAM_BUFFERS aligned buffers with pread() in turn, while the
+// parser threads split the previously filled buffer between them, so
+// reading and parsing overlap and only the buffers (not the file) have
+// to fit in memory. Each buffer ends at a newline; the partial line
+// after it is carried over to the start of the next buffer. Parsed
+// ranges are dropped from the page cache as the buffers are recycled.
+// The CSR arrays are then built exactly as above.
+
+#define GRAPH_PARSE_MAX_THREADS 256
+#define GRAPH_STREAM_BUFFERS 2
+#define GRAPH_STREAM_MIN_BUFFER_SIZE 65536
+#define GRAPH_STREAM_ALIGNMENT 4096
+
+// One buffer of the streaming pipeline, owned by the reader while
+// empty and by the parsers while full.
+struct parse_slot {
+    char * data;
+    size_t length;
+    bool full;
+    bool last;
+    off_t file_offset;
+    size_t file_length;
+};
+
+// Reader state of the streaming pipeline.
+struct parse_stream {
+    int fd;
+    off_t offset;
+    off_t file_size;
+    size_t buffer_size;
+    struct parse_slot slots[GRAPH_STREAM_BUFFERS];
+    pthread_mutex_t mutex;
+    pthread_cond_t filled;
+    pthread_cond_t emptied;
+    // Set when the parsers could not all be started: the reader stops
+    // waiting for buffers nobody will empty.
+    bool stopped;
+    pthread_t reader;
+};
+
+// State shared by all parser threads.
+struct parse_shared {
+    const char * path;
+    const char * data;
+    bool symmetric;
+    unsigned long long rows;
+    unsigned long long cols;
+    unsigned int vertex_count;
+    unsigned int thread_count;
+    _Atomic uint64_t * cursors;
+    struct graph * graph;
+    struct parse_stream * stream;
+    // Workers wait for started before their first barrier, which only
+    // exists once all of them do, or return if aborted is set.
+    pthread_mutex_t mutex;
+    pthread_cond_t started_cond;
+    bool started;
+    bool aborted;
+    pthread_barrier_t barrier;
+    atomic_bool failed;
+};
+
+struct parse_worker {
+    pthread_t thread;
+    struct parse_shared * shared;
+    unsigned int id;
+    const char * begin;
+    const char * end;
+    struct graph_edge * edges;
+    uint64_t edge_count;
+    uint64_t edge_capacity;
+    uint64_t entries;
+};
+
+// Skips spaces and tabs, not newlines.
+static inline const char * __parse_skip_blanks(const char * p, const char * end) {
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+
+    return p;
+}
+
+// Parses an unsigned decimal integer. Returns NULL if there is none.
+static inline const char * __parse_unsigned(const char * p, const char * end, unsigned long long * value) {
+    unsigned long long v = 0;
+    const char * start = p;
+
+    while (p < end && (unsigned char)(*p - '0') < 10) {
+        v = v * 10 + (unsigned long long)(*p - '0');
+        p++;
+    }
+
+    *value = v;
+    return (p == start) ? NULL : p;
+}
+
+// Returns a pointer just past the next newline, or end.
+static inline const char * __parse_next_line(const char * p, const char * end) {
+    const char * newline = memchr(p, '\n', (size_t)(end - p));
+
+    return (newline == NULL) ? end : newline + 1;
+}
+
+static bool __parse_add_edge(struct parse_worker * w, unsigned int source, unsigned int target) {
+    if (w->edge_count == w->edge_capacity) {
+        uint64_t capacity = w->edge_capacity == 0 ? 4096 : w->edge_capacity * 2;
+        struct graph_edge * edges = realloc(w->edges, capacity * sizeof(struct graph_edge));
+
+        if (edges == NULL) {
+            return false;
+        }
+
+        w->edges = edges;
+        w->edge_capacity = capacity;
+    }
+
+    w->edges[w->edge_count].source = source;
+    w->edges[w->edge_count].target = target;
+    w->edge_count += 1;
+    return true;
+}
+
+// Parses every entry line in [p, end) into the worker's edge buffer.
+static bool __parse_range(struct parse_worker * w, const char * p, const char * end) {
+    struct parse_shared * shared = w->shared;
+
+    while (p < end) {
+        unsigned long long row, col;
+
+        p = __parse_skip_blanks(p, end);
+        if (p == end) {
+            break;
+        }
+        if (*p == '\n' || *p == '\r' || *p == '%') {
+            p = __parse_next_line(p, end);
+            continue;
+        }
+
+        p = __parse_unsigned(p, end, &row);
+        if (p == NULL) {
+            return false;
+        }
+        p = __parse_unsigned(__parse_skip_blanks(p, end), end, &col);
+        if (p == NULL || row == 0 || col == 0 || row > shared->rows || col > shared->cols) {
+            return false;
+        }
+
+        // Values of real and integer matrices are ignored.
+        //
+        p = __parse_next_line(p, end);
+        w->entries += 1;
+
+        if (!__parse_add_edge(w, (unsigned int)(row - 1), (unsigned int)(col - 1))) {
+            return false;
+        }
+        if (shared->symmetric && row != col &&
+            !__parse_add_edge(w, (unsigned int)(col - 1), (unsigned int)(row - 1))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// qsort() comparison function for vertex IDs.
+static int __parse_compare_vertices(const void * a, const void * b) {
+    unsigned int x = *(const unsigned int *)a;
+    unsigned int y = *(const unsigned int *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Reserves a first guess at the edge buffer size for a number of bytes
+// of entries. Lines are at least four bytes ("1 1\n"), but most are
+// longer, so this avoids most of the doubling without grossly
+// overallocating.
+static bool __parse_reserve(struct parse_worker * w, size_t bytes) {
+    w->edge_capacity = (uint64_t)bytes / 12 + 16;
+    w->edges = malloc(w->edge_capacity * sizeof(struct graph_edge));
+
+    return w->edges != NULL;
+}
+
+// Builds the CSR arrays from the edges parsed by every worker. Run by
+// all workers together.
+static void __parse_build(struct parse_worker * w) {
+    struct parse_shared * shared = w->shared;
+    struct parse_worker * workers = w - w->id;
+
+    // Degrees.
+    //
+    for (uint64_t e = 0; e < w->edge_count; e++) {
+        atomic_fetch_add_explicit(&shared->cursors[w->edges[e].source], 1, memory_order_relaxed);
+    }
+    pthread_barrier_wait(&shared->barrier);
+
+    // Offsets, on one thread: the prefix sum is a tiny fraction of the
+    // work next to parsing and scattering the edges.
+    //
+    if (w->id == 0 && !atomic_load(&shared->failed)) {
+        uint64_t total = 0;
+        for (unsigned int t = 0; t < shared->thread_count; t++) {
+            total += workers[t].edge_count;
+        }
+
+        shared->graph = (struct graph *)calloc(1, sizeof(struct graph));
+        if (shared->graph != NULL) {
+            shared->graph->vertex_count = shared->vertex_count;
+            shared->graph->edge_count = total;
+            shared->graph->offsets = malloc(((size_t)shared->vertex_count + 1) * sizeof(uint64_t));
+            shared->graph->neighbors = malloc((total == 0 ? 1 : total) * sizeof(unsigned int));
+        }
+
+        if (shared->graph == NULL || shared->graph->offsets == NULL || shared->graph->neighbors == NULL) {
+            atomic_store(&shared->failed, true);
+        } else {
+            uint64_t sum = 0;
+            for (unsigned int v = 0; v < shared->vertex_count; v++) {
+                uint64_t degree = atomic_load_explicit(&shared->cursors[v], memory_order_relaxed);
+                shared->graph->offsets[v] = sum;
+                atomic_store_explicit(&shared->cursors[v], sum, memory_order_relaxed);
+                sum += degree;
+            }
+            shared->graph->offsets[shared->vertex_count] = sum;
+        }
+    }
+    pthread_barrier_wait(&shared->barrier);
+
+    if (atomic_load(&shared->failed)) {
+        return;
+    }
+
+    // Scatter.
+    //
+    struct graph * graph = shared->graph;
+    for (uint64_t e = 0; e < w->edge_count; e++) {
+        uint64_t slot = atomic_fetch_add_explicit(&shared->cursors[w->edges[e].source], 1,
+                                                  memory_order_relaxed);
+        graph->neighbors[slot] = w->edges[e].target;
+    }
+    free(w->edges);
+    w->edges = NULL;
+    pthread_barrier_wait(&shared->barrier);
+
+    // Sort neighbor lists of this thread's share of the vertices.
+    //
+    unsigned int first = (unsigned int)(((uint64_t)shared->vertex_count * w->id) / shared->thread_count);
+    unsigned int last = (unsigned int)(((uint64_t)shared->vertex_count * (w->id + 1)) / shared->thread_count);
+    for (unsigned int v = first; v < last; v++) {
+        uint64_t degree = graph_degree(graph, v);
+
+        if (degree > 1) {
+            qsort(&graph->neighbors[graph->offsets[v]], degree, sizeof(unsigned int),
+                  __parse_compare_vertices);
+        }
+    }
+}
+
+// Parks a worker until all the threads exist. Returns FALSE if some could
+// not be created.
+static bool __parse_wait_started(struct parse_shared * shared) {
+    pthread_mutex_lock(&shared->mutex);
+    while (!shared->started && !shared->aborted) {
+        pthread_cond_wait(&shared->started_cond, &shared->mutex);
+    }
+    pthread_mutex_unlock(&shared->mutex);
+
+    return shared->started;
+}
+
+// Lets the workers in once all of them exist, or tells the ones created
+// to return and fails the load. Returns FALSE in the latter case.
+static bool __parse_start(struct parse_shared * shared, bool all_created) {
+    pthread_mutex_lock(&shared->mutex);
+    if (all_created) {
+        pthread_barrier_init(&shared->barrier, NULL, shared->thread_count);
+        shared->started = true;
+    } else {
+        shared->aborted = true;
+        atomic_store(&shared->failed, true);
+    }
+    pthread_cond_broadcast(&shared->started_cond);
+    pthread_mutex_unlock(&shared->mutex);
+
+    return shared->started;
+}
+
+static void * __parse_worker_main(void * arg) {
+    struct parse_worker * w = (struct parse_worker *)arg;
+
+    if (!__parse_wait_started(w->shared)) {
+        return NULL;
+    }
+
+    if (!__parse_reserve(w, (size_t)(w->end - w->begin)) ||
+        !__parse_range(w, w->begin, w->end)) {
+        atomic_store(&w->shared->failed, true);
+    }
+
+    __parse_build(w);
+    return NULL;
+}
+
+// Parses the banner, comments and size line. Returns the start of the
+// entries, NULL on error.
+static const char * __parse_header(struct parse_shared * shared,
+                                   const char * data,
+                                   const char * end,
+                                   unsigned long long * entries) {
+    char object[32], format[32], field[32], symmetry[32];
+    char banner[256];
+    const char * p = __parse_next_line(data, end);
+    size_t banner_length = (size_t)(p - data) < sizeof(banner) ? (size_t)(p - data) : sizeof(banner) - 1;
+
+    // The mapping is not NUL terminated, so scan a copy of the first line.
+    //
+    memcpy(banner, data, banner_length);
+    banner[banner_length] = '\0';
+
+    if (sscanf(banner, "%%%%MatrixMarket %31s %31s %31s %31s", object, format, field, symmetry) != 4 ||
+        strcasecmp(object, "matrix") != 0 || strcasecmp(format, "coordinate") != 0) {
+        fprintf(stderr, "%s: not a Matrix Market coordinate file\n", shared->path);
+        return NULL;
+    }
+
+    shared->symmetric = strcasecmp(symmetry, "general") != 0;
+
+    while (p < end && *p == '%') {
+        p = __parse_next_line(p, end);
+    }
+
+    p = __parse_unsigned(__parse_skip_blanks(p, end), end, &shared->rows);
+    if (p != NULL) {
+        p = __parse_unsigned(__parse_skip_blanks(p, end), end, &shared->cols);
+    }
+    if (p != NULL) {
+        p = __parse_unsigned(__parse_skip_blanks(p, end), end, entries);
+    }
+
+    if (p == NULL || shared->rows > UINT32_MAX || shared->cols > UINT32_MAX) {
+        fprintf(stderr, "%s: bad size line\n", shared->path);
+        return NULL;
+    }
+
+    shared->vertex_count = (unsigned int)(shared->rows > shared->cols ? shared->rows : shared->cols);
+    return __parse_next_line(p, end);
+}
+
+// Loads a Matrix Market coordinate file using several threads.
+struct graph * graph_load_matrix_market_parallel(const char * path, unsigned int threads) {
+
+    struct parse_shared shared;
+    struct parse_worker workers[GRAPH_PARSE_MAX_THREADS];
+    struct stat st;
+
+    if (path == NULL) {
+        return NULL;
+    }
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1;
+    }
+    if (threads > GRAPH_PARSE_MAX_THREADS) {
+        threads = GRAPH_PARSE_MAX_THREADS;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        perror(path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return NULL;
+    }
+
+    size_t length = (size_t)st.st_size;
+    const char * data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror(path);
+        return NULL;
+    }
+    madvise((void *)data, length, MADV_SEQUENTIAL);
+
+    memset(&shared, 0, sizeof(shared));
+    shared.path = path;
+    shared.data = data;
+    atomic_init(&shared.failed, false);
+
+    unsigned long long entries = 0;
+    const char * end = data + length;
+    const char * body = __parse_header(&shared, data, end, &entries);
+
+    if (body == NULL) {
+        munmap((void *)data, length);
+        return NULL;
+    }
+
+    // Small files are not worth the threads.
+    //
+    if ((size_t)(end - body) < (size_t)threads * 65536) {
+        threads = 1;
+    }
+
+    shared.thread_count = threads;
+    shared.cursors = calloc((size_t)shared.vertex_count + 1, sizeof(uint64_t));
+    if (shared.cursors == NULL) {
+        munmap((void *)data, length);
+        return NULL;
+    }
+
+    // Chunk boundaries are moved forward to just past a newline so that
+    // no line is split between threads.
+    //
+    const char * begin = body;
+    for (unsigned int t = 0; t < threads; t++) {
+        const char * chunk_end = (t + 1 == threads) ? end :
+                                 body + (size_t)(end - body) * (t + 1) / threads;
+
+        if (chunk_end < begin) {
+            chunk_end = begin;
+        } else if (chunk_end < end && chunk_end > body && chunk_end[-1] != '\n') {
+            chunk_end = __parse_next_line(chunk_end, end);
+        }
+
+        memset(&workers[t], 0, sizeof(workers[t]));
+        workers[t].shared = &shared;
+        workers[t].id = t;
+        workers[t].begin = begin;
+        workers[t].end = chunk_end;
+        begin = chunk_end;
+    }
+
+    pthread_mutex_init(&shared.mutex, NULL);
+    pthread_cond_init(&shared.started_cond, NULL);
+
+    unsigned int created = 1;
+    while (created < threads &&
+           pthread_create(&workers[created].thread, NULL, __parse_worker_main, &workers[created]) == 0) {
+        created++;
+    }
+
+    if (__parse_start(&shared, created == threads)) {
+        __parse_worker_main(&workers[0]);
+    }
+    for (unsigned int t = 1; t < created; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+
+    if (shared.started) {
+        pthread_barrier_destroy(&shared.barrier);
+    }
+    pthread_cond_destroy(&shared.started_cond);
+    pthread_mutex_destroy(&shared.mutex);
+
+    unsigned long long parsed = 0;
+    for (unsigned int t = 0; t < threads; t++) {
+        parsed += workers[t].entries;
+        free(workers[t].edges);
+    }
+
+    if (!shared.started) {
+        fprintf(stderr, "%s: could not start %u parser threads\n", path, threads);
+    } else if (!atomic_load(&shared.failed) && parsed != entries) {
+        fprintf(stderr, "%s: expected %llu entries, found %llu\n", path, entries, parsed);
+        atomic_store(&shared.failed, true);
+    } else if (atomic_load(&shared.failed)) {
+        fprintf(stderr, "%s: malformed entry or out of memory\n", path);
+    }
+
+    free((void *)shared.cursors);
+    munmap((void *)data, length);
+
+    if (atomic_load(&shared.failed)) {
+        graph_delete(shared.graph);
+        return NULL;
+    }
+
+    return shared.graph;
+}
+
+// Reads as much of [offset, offset + length) as the file holds.
+// Returns the number of bytes read, or -1 on error.
+static ssize_t __parse_pread_full(int fd, char * buffer, size_t length, off_t offset) {
+    size_t total = 0;
+
+    while (total < length) {
+        ssize_t n = pread(fd, buffer + total, length - total, offset + (off_t)total);
+
+        if (n < 0) {
+            return -1;
+        } else if (n == 0) {
+            break;
+        }
+
+        total += (size_t)n;
+    }
+
+    return (ssize_t)total;
+}
+
+// Fills the stream buffers in turn until the end of the file, or until
+// an error anywhere in the pipeline. The last buffer published is
+// always marked as such, so the parsers never wait forever.
+static void * __parse_reader_main(void * arg) {
+    struct parse_shared * shared = (struct parse_shared *)arg;
+    struct parse_stream * stream = shared->stream;
+    const char * carry = NULL;
+    size_t carry_length = 0;
+
+    for (uint64_t n = 0;; n++) {
+        struct parse_slot * slot = &stream->slots[n % GRAPH_STREAM_BUFFERS];
+
+        pthread_mutex_lock(&stream->mutex);
+        while (slot->full && !stream->stopped) {
+            pthread_cond_wait(&stream->emptied, &stream->mutex);
+        }
+        pthread_mutex_unlock(&stream->mutex);
+
+        // The parsers are done with whatever this buffer held before.
+        //
+        if (slot->file_length != 0) {
+            posix_fadvise(stream->fd, slot->file_offset, (off_t)slot->file_length, POSIX_FADV_DONTNEED);
+        }
+
+        // The partial line lives in the other buffer, which cannot be
+        // refilled before this one is published.
+        //
+        memcpy(slot->data, carry, carry_length);
+
+        size_t request = stream->buffer_size - carry_length;
+        ssize_t n_read = atomic_load(&shared->failed) ? -1 :
+                         __parse_pread_full(stream->fd, slot->data + carry_length, request, stream->offset);
+
+        if (n_read < 0) {
+            atomic_store(&shared->failed, true);
+            slot->length = 0;
+            slot->last = true;
+        } else {
+            size_t total = carry_length + (size_t)n_read;
+
+            slot->file_offset = stream->offset;
+            slot->file_length = (size_t)n_read;
+            stream->offset += n_read;
+            slot->last = (size_t)n_read < request || stream->offset >= stream->file_size;
+
+            if (slot->last) {
+                slot->length = total;
+            } else {
+                size_t length = total;
+                while (length > 0 && slot->data[length - 1] != '\n') {
+                    length--;
+                }
+
+                if (length == 0) {
+                    fprintf(stderr, "%s: line longer than the %zu byte stream buffer\n",
+                            shared->path, stream->buffer_size);
+                    atomic_store(&shared->failed, true);
+                    slot->last = true;
+                }
+
+                slot->length = length;
+                carry = slot->data + length;
+                carry_length = total - length;
+            }
+        }
+
+        pthread_mutex_lock(&stream->mutex);
+        slot->full = true;
+        pthread_cond_broadcast(&stream->filled);
+        pthread_mutex_unlock(&stream->mutex);
+
+        if (slot->last) {
+            return NULL;
+        }
+    }
+}
+
+// Returns the start of a worker's share of a buffer, moved forward to
+// just past a newline. Every worker computes the same boundaries.
+static size_t __parse_split(const char * data, size_t length, unsigned int t, unsigned int threads) {
+    if (t == 0) {
+        return 0;
+    } else if (t == threads) {
+        return length;
+    }
+
+    const char * split = data + length * t / threads;
+    if (split == data || split[-1] == '\n') {
+        return (size_t)(split - data);
+    }
+
+    return (size_t)(__parse_next_line(split, data + length) - data);
+}
+
+static void * __parse_stream_worker_main(void * arg) {
+    struct parse_worker * w = (struct parse_worker *)arg;
+    struct parse_shared * shared = w->shared;
+    struct parse_stream * stream = shared->stream;
+
+    if (!__parse_wait_started(shared)) {
+        return NULL;
+    }
+
+    for (uint64_t n = 0;; n++) {
+        struct parse_slot * slot = &stream->slots[n % GRAPH_STREAM_BUFFERS];
+
+        pthread_mutex_lock(&stream->mutex);
+        while (!slot->full) {
+            pthread_cond_wait(&stream->filled, &stream->mutex);
+        }
+        pthread_mutex_unlock(&stream->mutex);
+
+        // Read before the barrier: once past it, the buffer may be
+        // handed back to the reader and refilled.
+        //
+        bool last = slot->last;
+
+        if (!atomic_load(&shared->failed)) {
+            size_t begin = __parse_split(slot->data, slot->length, w->id, shared->thread_count);
+            size_t end = __parse_split(slot->data, slot->length, w->id + 1, shared->thread_count);
+
+            if (!__parse_range(w, slot->data + begin, slot->data + end)) {
+                atomic_store(&shared->failed, true);
+            }
+        }
+        pthread_barrier_wait(&shared->barrier);
+
+        if (w->id == 0) {
+            pthread_mutex_lock(&stream->mutex);
+            slot->full = false;
+            pthread_cond_broadcast(&stream->emptied);
+            pthread_mutex_unlock(&stream->mutex);
+        }
+
+        if (last) {
+            break;
+        }
+    }
+
+    __parse_build(w);
+    return NULL;
+}
+
+// Loads a Matrix Market coordinate file through a bounded read buffer
+// pipeline.
+struct graph * graph_load_matrix_market_streaming(const char * path,
+                                                  unsigned int threads,
+                                                  size_t buffer_size) {
+
+    struct parse_shared shared;
+    struct parse_stream stream;
+    struct parse_worker workers[GRAPH_PARSE_MAX_THREADS];
+    struct stat st;
+
+    if (path == NULL) {
+        return NULL;
+    }
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (unsigned int)online : 1;
+    }
+    if (threads > GRAPH_PARSE_MAX_THREADS) {
+        threads = GRAPH_PARSE_MAX_THREADS;
+    }
+
+    if (buffer_size == 0) {
+        buffer_size = GRAPH_STREAM_BUFFER_SIZE;
+    } else if (buffer_size < GRAPH_STREAM_MIN_BUFFER_SIZE) {
+        buffer_size = GRAPH_STREAM_MIN_BUFFER_SIZE;
+    }
+    buffer_size = (buffer_size + GRAPH_STREAM_ALIGNMENT - 1) & ~(size_t)(GRAPH_STREAM_ALIGNMENT - 1);
+
+    memset(&stream, 0, sizeof(stream));
+    stream.fd = open(path, O_RDONLY);
+    if (stream.fd < 0 || fstat(stream.fd, &st) != 0 || st.st_size == 0) {
+        perror(path);
+        if (stream.fd >= 0) {
+            close(stream.fd);
+        }
+        return NULL;
+    }
+    posix_fadvise(stream.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    memset(&shared, 0, sizeof(shared));
+    shared.path = path;
+    shared.stream = &stream;
+    atomic_init(&shared.failed, false);
+
+    stream.file_size = st.st_size;
+    stream.buffer_size = buffer_size;
+
+    bool status = true;
+    for (unsigned int i = 0; i < GRAPH_STREAM_BUFFERS; i++) {
+        if (posix_memalign((void **)&stream.slots[i].data, GRAPH_STREAM_ALIGNMENT, buffer_size) != 0) {
+            stream.slots[i].data = NULL;
+            status = false;
+        }
+    }
+
+    // The header is parsed from a first read into the first buffer, and
+    // must fit in it.
+    //
+    unsigned long long entries = 0;
+    const char * body = NULL;
+    ssize_t head_length = status ? __parse_pread_full(stream.fd, stream.slots[0].data, buffer_size, 0) : -1;
+
+    if (head_length > 0) {
+        const char * head_end = stream.slots[0].data + head_length;
+        body = __parse_header(&shared, stream.slots[0].data, head_end, &entries);
+
+        if (body != NULL && body != head_end && body[-1] != '\n') {
+            fprintf(stderr, "%s: header longer than the stream buffer\n", path);
+            body = NULL;
+        }
+    } else if (status) {
+        perror(path);
+    }
+
+    if (body != NULL) {
+        stream.offset = (off_t)(body - stream.slots[0].data);
+        shared.thread_count = threads;
+        shared.cursors = calloc((size_t)shared.vertex_count + 1, sizeof(uint64_t));
+    }
+
+    if (body == NULL || shared.cursors == NULL) {
+        for (unsigned int i = 0; i < GRAPH_STREAM_BUFFERS; i++) {
+            free(stream.slots[i].data);
+        }
+        close(stream.fd);
+        return NULL;
+    }
+
+    // Each worker starts with room for its share of one buffer.
+    //
+    size_t reserve = (size_t)(st.st_size - stream.offset) / threads;
+    if (reserve > buffer_size) {
+        reserve = buffer_size;
+    }
+
+    for (unsigned int t = 0; t < threads; t++) {
+        memset(&workers[t], 0, sizeof(workers[t]));
+        workers[t].shared = &shared;
+        workers[t].id = t;
+        if (!__parse_reserve(&workers[t], reserve)) {
+            atomic_store(&shared.failed, true);
+        }
+    }
+
+    pthread_mutex_init(&stream.mutex, NULL);
+    pthread_cond_init(&stream.filled, NULL);
+    pthread_cond_init(&stream.emptied, NULL);
+    pthread_mutex_init(&shared.mutex, NULL);
+    pthread_cond_init(&shared.started_cond, NULL);
+
+    // Without the reader the parsers would wait for buffers forever, so
+    // they are only created once it exists.
+    //
+    bool reader = pthread_create(&stream.reader, NULL, __parse_reader_main, &shared) == 0;
+    unsigned int created = 1;
+    while (reader && created < threads &&
+           pthread_create(&workers[created].thread, NULL, __parse_stream_worker_main, &workers[created]) == 0) {
+        created++;
+    }
+
+    if (__parse_start(&shared, reader && created == threads)) {
+        __parse_stream_worker_main(&workers[0]);
+    } else if (reader) {
+        // The load has failed: the reader publishes one last buffer as
+        // soon as it stops waiting, and exits.
+        //
+        pthread_mutex_lock(&stream.mutex);
+        stream.stopped = true;
+        pthread_cond_broadcast(&stream.emptied);
+        pthread_mutex_unlock(&stream.mutex);
+    }
+    for (unsigned int t = 1; t < created; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    if (reader) {
+        pthread_join(stream.reader, NULL);
+    }
+
+    if (shared.started) {
+        pthread_barrier_destroy(&shared.barrier);
+    }
+    pthread_cond_destroy(&shared.started_cond);
+    pthread_mutex_destroy(&shared.mutex);
+    pthread_cond_destroy(&stream.emptied);
+    pthread_cond_destroy(&stream.filled);
+    pthread_mutex_destroy(&stream.mutex);
+
+    unsigned long long parsed = 0;
+    for (unsigned int t = 0; t < threads; t++) {
+        parsed += workers[t].entries;
+        free(workers[t].edges);
+    }
+
+    if (!shared.started) {
+        fprintf(stderr, "%s: could not start the reader and %u parser threads\n", path, threads);
+    } else if (!atomic_load(&shared.failed) && parsed != entries) {
+        fprintf(stderr, "%s: expected %llu entries, found %llu\n", path, entries, parsed);
+        atomic_store(&shared.failed, true);
+    } else if (atomic_load(&shared.failed)) {
+        fprintf(stderr, "%s: malformed entry, read error or out of memory\n", path);
+    }
+
+    for (unsigned int i = 0; i < GRAPH_STREAM_BUFFERS; i++) {
+        free(stream.slots[i].data);
+    }
+    free((void *)shared.cursors);
+    close(stream.fd);
+
+    if (atomic_load(&shared.failed)) {
+        graph_delete(shared.graph);
+        return NULL;
+    }
+
+    return shared.graph;
+}
@@ -0,0 +1,248 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph_scc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define GRAPH_SCC_UNVISITED UINT32_MAX
+
+// Scratch arrays of Tarjan's algorithm. The DFS is driven from an
+// explicit stack of (vertex, next edge) frames instead of recursion.
+struct graph_scc_search {
+    unsigned int * index;
+    unsigned int * low;
+    unsigned int * frame_vertex;
+    uint64_t * frame_edge;
+    unsigned int * stack;
+    uint64_t * on_stack;
+};
+
+// Frees the scratch arrays.
+static void __graph_scc_search_free(struct graph_scc_search * search) {
+    free(search->index);
+    free(search->low);
+    free(search->frame_vertex);
+    free(search->frame_edge);
+    free(search->stack);
+    free(search->on_stack);
+}
+
+// Labels every vertex with its component, sinks of the condensation
+// first, and returns the number of components.
+static unsigned int __graph_scc_tarjan(const struct graph * graph,
+                                       struct graph_scc_search * search,
+                                       unsigned int * components) {
+    unsigned int counter = 0;
+    unsigned int component_count = 0;
+    size_t frames = 0;
+    size_t stacked = 0;
+
+    for (unsigned int root = 0; root < graph->vertex_count; root++) {
+        if (search->index[root] != GRAPH_SCC_UNVISITED) {
+            continue;
+        }
+
+        search->index[root] = search->low[root] = counter++;
+        search->stack[stacked++] = root;
+        search->on_stack[root >> 6] |= 1ull << (root & 63);
+        search->frame_vertex[frames] = root;
+        search->frame_edge[frames++] = graph->offsets[root];
+
+        while (frames != 0) {
+            unsigned int vertex = search->frame_vertex[frames - 1];
+            uint64_t e = search->frame_edge[frames - 1];
+
+            if (e < graph->offsets[vertex + 1]) {
+                unsigned int neighbor = graph->neighbors[e];
+                search->frame_edge[frames - 1] = e + 1;
+
+                if (search->index[neighbor] == GRAPH_SCC_UNVISITED) {
+                    search->index[neighbor] = search->low[neighbor] = counter++;
+                    search->stack[stacked++] = neighbor;
+                    search->on_stack[neighbor >> 6] |= 1ull << (neighbor & 63);
+                    search->frame_vertex[frames] = neighbor;
+                    search->frame_edge[frames++] = graph->offsets[neighbor];
+                } else if ((search->on_stack[neighbor >> 6] >> (neighbor & 63)) & 1) {
+                    if (search->index[neighbor] < search->low[vertex]) {
+                        search->low[vertex] = search->index[neighbor];
+                    }
+                }
+                continue;
+            }
+
+            // Every edge of vertex is done: it either roots a component,
+            // which is everything stacked above it, or passes its low
+            // link to the vertex it was reached from.
+            //
+            frames -= 1;
+
+            if (search->low[vertex] == search->index[vertex]) {
+                unsigned int member;
+                do {
+                    member = search->stack[--stacked];
+                    search->on_stack[member >> 6] &= ~(1ull << (member & 63));
+                    components[member] = component_count;
+                } while (member != vertex);
+                component_count += 1;
+            }
+
+            if (frames != 0) {
+                unsigned int parent = search->frame_vertex[frames - 1];
+                if (search->low[vertex] < search->low[parent]) {
+                    search->low[parent] = search->low[vertex];
+                }
+            }
+        }
+    }
+
+    return component_count;
+}
+
+// Computes the longest path level of every component, visiting the
+// vertices grouped by component in topological order. Also sets the
+// size of the largest component. Returns FALSE on allocation failure.
+static bool __graph_scc_levels(const struct graph * graph, struct graph_scc * scc) {
+    uint64_t * starts = (uint64_t *)calloc((size_t)scc->component_count + 1, sizeof(uint64_t));
+    unsigned int * members = (unsigned int *)malloc(((size_t)graph->vertex_count + 1) * sizeof(unsigned int));
+
+    if (starts == NULL || members == NULL) {
+        free(starts);
+        free(members);
+        return false;
+    }
+
+    // Counting sort of the vertices by component.
+    //
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        starts[scc->components[v] + 1] += 1;
+    }
+    for (unsigned int c = 0; c < scc->component_count; c++) {
+        uint64_t size = starts[c + 1];
+        if (size > scc->largest_component) {
+            scc->largest_component = (unsigned int)size;
+        }
+        starts[c + 1] += starts[c];
+    }
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        members[starts[scc->components[v]]++] = v;
+    }
+
+    // starts[c] is now the end of component c, i.e. the start of c + 1.
+    //
+    uint64_t first = 0;
+    for (unsigned int c = 0; c < scc->component_count; c++) {
+        for (uint64_t i = first; i < starts[c]; i++) {
+            unsigned int v = members[i];
+
+            for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+                unsigned int to = scc->components[graph->neighbors[e]];
+
+                if (to != c && scc->levels[to] <= scc->levels[c]) {
+                    scc->levels[to] = scc->levels[c] + 1;
+                }
+            }
+        }
+        first = starts[c];
+    }
+
+    free(starts);
+    free(members);
+    return true;
+}
+
+// Computes the strongly connected components of a graph.
+struct graph_scc * graph_scc_compute(const struct graph * graph) {
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    size_t vertices = (size_t)graph->vertex_count + 1;
+    struct graph_scc * scc = (struct graph_scc *)calloc(1, sizeof(struct graph_scc));
+    struct graph_scc_search search = {
+        .index = (unsigned int *)malloc(vertices * sizeof(unsigned int)),
+        .low = (unsigned int *)malloc(vertices * sizeof(unsigned int)),
+        .frame_vertex = (unsigned int *)malloc(vertices * sizeof(unsigned int)),
+        .frame_edge = (uint64_t *)malloc(vertices * sizeof(uint64_t)),
+        .stack = (unsigned int *)malloc(vertices * sizeof(unsigned int)),
+        .on_stack = (uint64_t *)calloc(vertices / 64 + 1, sizeof(uint64_t))
+    };
+
+    if (scc == NULL || search.index == NULL || search.low == NULL || search.frame_vertex == NULL ||
+        search.frame_edge == NULL || search.stack == NULL || search.on_stack == NULL) {
+        free(scc);
+        __graph_scc_search_free(&search);
+        return NULL;
+    }
+
+    scc->vertex_count = graph->vertex_count;
+    scc->components = (unsigned int *)malloc(vertices * sizeof(unsigned int));
+
+    if (scc->components == NULL) {
+        graph_scc_delete(scc);
+        __graph_scc_search_free(&search);
+        return NULL;
+    }
+
+    memset(search.index, 0xff, vertices * sizeof(unsigned int));
+    scc->component_count = __graph_scc_tarjan(graph, &search, scc->components);
+    __graph_scc_search_free(&search);
+
+    // Tarjan's algorithm completes a component only after everything it
+    // reaches, so reversing its numbering gives a topological order.
+    //
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        scc->components[v] = scc->component_count - 1 - scc->components[v];
+    }
+
+    scc->levels = (unsigned int *)calloc((size_t)scc->component_count + 1, sizeof(unsigned int));
+
+    if (scc->levels == NULL || !__graph_scc_levels(graph, scc)) {
+        graph_scc_delete(scc);
+        return NULL;
+    }
+
+    return scc;
+}
+
+// Returns the total size of the component index in bytes.
+uint64_t graph_scc_bytes(const struct graph_scc * scc) {
+    return sizeof(struct graph_scc) +
+           (uint64_t)scc->vertex_count * sizeof(unsigned int) +
+           (uint64_t)scc->component_count * sizeof(unsigned int);
+}
+
+// Frees the components of a graph.
+void graph_scc_delete(struct graph_scc * scc) {
+
+    if (scc == NULL) {
+        return;
+    }
+
+    free(scc->components);
+    free(scc->levels);
+    free(scc);
+}
@@ -0,0 +1,114 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _GRAPH_SCC_H
+#define _GRAPH_SCC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.h"
+
+// Strongly connected components of a graph and its condensation, the
+// DAG with one node per component. It lets most path queries with no
+// answer be refused without searching, where a BFS would have to
+// exhaust everything reachable from the source to say no.
+//
+// Components are numbered in a topological order of the condensation:
+// an edge u -> v always has components[u] <= components[v], so nothing
+// in component c reaches a component numbered below c. levels[c] is the
+// length of the longest path to c from a component with no in-edges,
+// which is a second topological order: nothing reaches a different
+// component at the same or a lower level. Between them they refuse
+// most unreachable pairs of a web graph.
+//
+struct graph_scc {
+    unsigned int vertex_count;
+    unsigned int component_count;
+    unsigned int largest_component;
+    unsigned int * components;
+    unsigned int * levels;
+};
+
+// What the condensation alone says about a path query.
+//
+enum graph_scc_answer {
+    GRAPH_SCC_UNREACHABLE,
+    GRAPH_SCC_REACHABLE,
+    GRAPH_SCC_UNKNOWN
+};
+
+// Computes the strongly connected components of a graph with an
+// iterative Tarjan's algorithm, in O(V + E) time and without recursion,
+// so path-like graphs of any depth are fine.
+// \param graph : Pointer to graph.
+// Returns the components on success, NULL on failure.
+//
+struct graph_scc * graph_scc_compute(const struct graph * graph);
+
+// Returns the total size of the component index in bytes.
+// \param scc : Pointer to components.
+//
+uint64_t graph_scc_bytes(const struct graph_scc * scc);
+
+// Frees the components of a graph.
+// \param scc : Components to free, may be NULL.
+//
+void graph_scc_delete(struct graph_scc * scc);
+
+// Returns whether a component can be on a path to another, by the two
+// topological orders. FALSE is definite, TRUE is a maybe.
+// \param scc  : Pointer to components.
+// \param from : Component of the start of the path.
+// \param to   : Component of the end of the path.
+//
+static inline bool graph_scc_may_reach(const struct graph_scc * scc,
+                                       unsigned int from,
+                                       unsigned int to) {
+    return from == to || (from < to && scc->levels[from] < scc->levels[to]);
+}
+
+// Answers a path query from the condensation alone, in O(1).
+// \param scc    : Pointer to components.
+// \param source : Vertex to start from.
+// \param target : Vertex to look for.
+// Returns GRAPH_SCC_REACHABLE if both are in one component,
+// GRAPH_SCC_UNREACHABLE if no path can exist, GRAPH_SCC_UNKNOWN if only
+// a search can tell.
+//
+static inline enum graph_scc_answer graph_scc_reachable(const struct graph_scc * scc,
+                                                        unsigned int source,
+                                                        unsigned int target) {
+    unsigned int from = scc->components[source];
+    unsigned int to = scc->components[target];
+
+    if (from == to) {
+        return GRAPH_SCC_REACHABLE;
+    }
+
+    return graph_scc_may_reach(scc, from, to) ? GRAPH_SCC_UNKNOWN : GRAPH_SCC_UNREACHABLE;
+}
+
+#endif
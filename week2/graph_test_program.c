@@ -0,0 +1,1714 @@
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bfs.h"
+#include "bfs_cache.h"
+#include "bfs_frontier.h"
+#include "bfs_multi_source.h"
+#include "bfs_parallel.h"
+#include "bfs_partitioned.h"
+#include "graph.h"
+#include "graph_analytics.h"
+#include "graph_landmarks.h"
+#include "graph_scc.h"
+#include "graph_weights.h"
+#include "linked_list.h"
+#include "queue.h"
+#include "radix_heap.h"
+#include "rng.h"
+
+// Functional tests for the graph loader and the BFS engines, in the
+// same style as linked_list_test_program.c.
+
+#define TEST(x) printf("Running test " #x "\n"); fflush(stdout);
+#define SUBTEST(x) printf("    Executing subtest " #x "\n"); fflush(stdout); \
+                   alarm(5);
+#define FAIL(cond, msg) if (cond) {\
+                        printf("    FAIL! "); \
+                        printf(#msg "\n"); \
+                        exit(-1);\
+                        }
+#define PASS(x) printf("PASS!\n"); alarm(0);
+
+#define TEST_GRAPH_PATH "graph_test_program.mtx"
+
+void gracefully_exit_on_suspected_infinite_loop(int signal_number) {
+    const char* err_msg = "        Likely stuck in infinite loop! Exiting.\n";
+    ssize_t retval      = write(STDOUT_FILENO, err_msg, strlen(err_msg));
+    (void)retval;
+    (void)signal_number;
+    exit(1);
+}
+
+// Returns a small directed test graph:
+//
+//   0 -> 1 -> 2 -> 3        5 -> 6
+//   0 -> 2    3 -> 1        7 (isolated)
+//   4 -> 0
+//
+struct graph * create_test_graph(void) {
+    const struct graph_edge edges[] = {
+        {0, 2}, {0, 1}, {1, 2}, {2, 3}, {3, 1}, {4, 0}, {5, 6}
+    };
+
+    return graph_create_from_edges(8, edges, sizeof(edges) / sizeof(edges[0]));
+}
+
+// Returns a sparse random directed graph, sparse enough that some pairs
+// are unreachable.
+//
+struct graph * create_random_graph(unsigned int vertex_count, uint64_t edge_count, uint64_t seed) {
+    struct graph_edge * edges = malloc(edge_count * sizeof(struct graph_edge));
+    struct rng rng;
+
+    rng_seed(&rng, seed);
+    for (uint64_t e = 0; e < edge_count; e++) {
+        edges[e].source = (unsigned int)rng_bounded(&rng, vertex_count);
+        edges[e].target = (unsigned int)rng_bounded(&rng, vertex_count);
+    }
+
+    struct graph * graph = graph_create_from_edges(vertex_count, edges, edge_count);
+    free(edges);
+    return graph;
+}
+
+void check_graph_construction(void) {
+    TEST(check_graph_construction)
+
+    SUBTEST(graph_create_from_edges)
+    struct graph * graph = create_test_graph();
+    FAIL(graph == NULL,
+         "graph_create_from_edges() returned NULL")
+    FAIL(graph->vertex_count != 8 || graph->edge_count != 7,
+         "Wrong vertex or edge count")
+
+    SUBTEST(graph_degrees)
+    FAIL(graph_degree(graph, 0) != 2 || graph_degree(graph, 4) != 1 ||
+         graph_degree(graph, 7) != 0,
+         "Wrong out-degrees")
+
+    SUBTEST(graph_neighbors_sorted)
+    FAIL(graph->neighbors[graph->offsets[0]] != 1 ||
+         graph->neighbors[graph->offsets[0] + 1] != 2,
+         "Neighbors of vertex 0 are not {1, 2} in order")
+
+    SUBTEST(graph_transpose)
+    struct graph * transpose = graph_transpose(graph);
+    FAIL(transpose == NULL || transpose->edge_count != graph->edge_count,
+         "graph_transpose() failed or lost edges")
+    FAIL(graph_degree(transpose, 1) != 2 ||
+         transpose->neighbors[transpose->offsets[1]] != 0 ||
+         transpose->neighbors[transpose->offsets[1] + 1] != 3,
+         "In-neighbors of vertex 1 are not {0, 3} in order")
+    FAIL(graph_degree(transpose, 4) != 0 || graph_degree(transpose, 0) != 1,
+         "Wrong in-degrees")
+    graph_delete(transpose);
+
+    graph_delete(graph);
+    PASS(check_graph_construction)
+}
+
+void check_matrix_market_loading(void) {
+    TEST(check_matrix_market_loading)
+
+    SUBTEST(load_general_pattern)
+    FILE * out = fopen(TEST_GRAPH_PATH, "w");
+    FAIL(out == NULL,
+         "Could not write test graph")
+    fprintf(out, "%%%%MatrixMarket matrix coordinate pattern general\n");
+    fprintf(out, "%% comment line\n");
+    fprintf(out, "4 4 3\n1 2\n2 3\n4 1\n");
+    fclose(out);
+
+    struct graph * graph = graph_load_matrix_market(TEST_GRAPH_PATH);
+    FAIL(graph == NULL,
+         "graph_load_matrix_market() failed on a general pattern file")
+    FAIL(graph->vertex_count != 4 || graph->edge_count != 3,
+         "Wrong vertex or edge count for general pattern file")
+    FAIL(graph->neighbors[graph->offsets[3]] != 0,
+         "Entry (4, 1) did not become edge 3 -> 0")
+    graph_delete(graph);
+
+    SUBTEST(load_symmetric_real)
+    out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate real symmetric\n");
+    fprintf(out, "3 3 2\n2 1 0.5\n3 3 1.0\n");
+    fclose(out);
+
+    graph = graph_load_matrix_market(TEST_GRAPH_PATH);
+    FAIL(graph == NULL,
+         "graph_load_matrix_market() failed on a symmetric real file")
+    FAIL(graph->edge_count != 3,
+         "Symmetric entries were not mirrored (diagonal only once)")
+    graph_delete(graph);
+
+    SUBTEST(load_rejects_bad_entries)
+    out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate pattern general\n");
+    fprintf(out, "2 2 1\n3 1\n");
+    fclose(out);
+
+    graph = graph_load_matrix_market(TEST_GRAPH_PATH);
+    FAIL(graph != NULL,
+         "graph_load_matrix_market() accepted an out of range entry")
+
+    SUBTEST(parallel_matches_serial)
+    out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate integer general\n");
+    fprintf(out, "%u %u %u\n", 1000u, 1000u, 20000u);
+    for (unsigned int i = 0; i < 20000; i++) {
+        fprintf(out, "%u %u %u\n", (i * 7919u) % 1000 + 1, (i * 104729u) % 997 + 1, i);
+    }
+    fclose(out);
+
+    graph = graph_load_matrix_market(TEST_GRAPH_PATH);
+    struct graph * parallel = graph_load_matrix_market_parallel(TEST_GRAPH_PATH, 4);
+    FAIL(graph == NULL || parallel == NULL,
+         "Failed to load the larger test graph")
+    FAIL(parallel->vertex_count != graph->vertex_count || parallel->edge_count != graph->edge_count,
+         "Parallel parser found a different number of vertices or edges")
+    FAIL(memcmp(parallel->offsets, graph->offsets, (graph->vertex_count + 1) * sizeof(uint64_t)) != 0 ||
+         memcmp(parallel->neighbors, graph->neighbors, graph->edge_count * sizeof(unsigned int)) != 0,
+         "Parallel parser built a different CSR than the serial one")
+    graph_delete(parallel);
+
+    SUBTEST(streaming_matches_serial)
+    // The smallest buffer splits the file into several buffers, so lines
+    // are carried over between them.
+    //
+    struct graph * streamed = graph_load_matrix_market_streaming(TEST_GRAPH_PATH, 3, 1);
+    FAIL(streamed == NULL,
+         "Failed to stream the larger test graph")
+    FAIL(streamed->vertex_count != graph->vertex_count || streamed->edge_count != graph->edge_count,
+         "Streaming parser found a different number of vertices or edges")
+    FAIL(memcmp(streamed->offsets, graph->offsets, (graph->vertex_count + 1) * sizeof(uint64_t)) != 0 ||
+         memcmp(streamed->neighbors, graph->neighbors, graph->edge_count * sizeof(unsigned int)) != 0,
+         "Streaming parser built a different CSR than the serial one")
+    graph_delete(streamed);
+    graph_delete(graph);
+
+    SUBTEST(parallel_rejects_short_file)
+    out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate pattern general\n");
+    fprintf(out, "3 3 3\n1 2\n2 3\n");
+    fclose(out);
+    graph = graph_load_matrix_market_parallel(TEST_GRAPH_PATH, 2);
+    FAIL(graph != NULL,
+         "Parallel parser accepted a file with missing entries")
+    graph = graph_load_matrix_market_streaming(TEST_GRAPH_PATH, 2, 0);
+    FAIL(graph != NULL,
+         "Streaming parser accepted a file with missing entries")
+
+    remove(TEST_GRAPH_PATH);
+    PASS(check_matrix_market_loading)
+}
+
+void check_binary_cache(void) {
+    TEST(check_binary_cache)
+
+    SUBTEST(save_and_map_binary)
+    struct graph * graph = create_test_graph();
+    bool status = graph_save_binary(graph, TEST_GRAPH_PATH ".csr");
+    FAIL(status != true,
+         "graph_save_binary() failed")
+
+    struct graph * mapped = graph_load_binary(TEST_GRAPH_PATH ".csr");
+    FAIL(mapped == NULL || mapped->mapping == NULL,
+         "graph_load_binary() did not map the file")
+    FAIL(mapped->vertex_count != graph->vertex_count || mapped->edge_count != graph->edge_count,
+         "Mapped graph has the wrong size")
+    FAIL(memcmp(mapped->offsets, graph->offsets, (graph->vertex_count + 1) * sizeof(uint64_t)) != 0 ||
+         memcmp(mapped->neighbors, graph->neighbors, graph->edge_count * sizeof(unsigned int)) != 0,
+         "Mapped graph differs from the saved one")
+    graph_delete(mapped);
+    graph_delete(graph);
+
+    SUBTEST(load_builds_and_reuses_cache)
+    FILE * out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate pattern general\n");
+    fprintf(out, "3 3 2\n1 2\n2 3\n");
+    fclose(out);
+    remove(TEST_GRAPH_PATH ".csr");
+
+    graph = graph_load(TEST_GRAPH_PATH, NULL);
+    FAIL(graph == NULL || graph->mapping != NULL,
+         "First graph_load() of a .mtx file did not parse it")
+    graph_delete(graph);
+
+    graph = graph_load(TEST_GRAPH_PATH, NULL);
+    FAIL(graph == NULL || graph->mapping == NULL,
+         "Second graph_load() of a .mtx file did not map the cache")
+    FAIL(graph->edge_count != 2 || graph->neighbors[graph->offsets[1]] != 2,
+         "Cached graph has the wrong edges")
+    FAIL(graph->transpose != NULL,
+         "Cache has a transpose nobody asked for")
+    graph_delete(graph);
+
+    SUBTEST(load_adds_transpose_to_cache)
+    struct graph_load_options options = {.use_cache = true, .threads = 0, .transpose = true};
+    graph = graph_load(TEST_GRAPH_PATH, &options);
+    FAIL(graph == NULL || graph->transpose == NULL,
+         "graph_load() did not build the requested transpose")
+    graph_delete(graph);
+
+    graph = graph_load(TEST_GRAPH_PATH, NULL);
+    FAIL(graph == NULL || graph->mapping == NULL || graph->transpose == NULL,
+         "Cache rewritten with the transpose was not mapped with it")
+    FAIL(graph->transpose->edge_count != 2 || graph_degree(graph->transpose, 0) != 0 ||
+         graph->transpose->neighbors[graph->transpose->offsets[2]] != 1,
+         "Cached transpose has the wrong edges")
+    graph_delete(graph);
+
+    SUBTEST(reject_corrupt_cache_arrays)
+    // A neighbor out of range, in a cache whose header still matches its
+    // source: graph_load() has to notice and parse the .mtx again.
+    //
+    struct graph_cache_header header;
+    FILE * cache = fopen(TEST_GRAPH_PATH ".csr", "r+b");
+    FAIL(cache == NULL || fread(&header, sizeof(header), 1, cache) != 1,
+         "Could not read the cache header")
+    unsigned int corrupt = 3;
+    for (int i = 0; i < GRAPH_CACHE_MAX_SECTIONS; i++) {
+        if (header.sections[i].type == GRAPH_CACHE_SECTION_NEIGHBORS) {
+            FAIL(fseek(cache, (long)header.sections[i].offset, SEEK_SET) != 0 ||
+                 fwrite(&corrupt, sizeof(corrupt), 1, cache) != 1,
+                 "Could not corrupt the cache")
+        }
+    }
+    fclose(cache);
+    graph = graph_load_binary(TEST_GRAPH_PATH ".csr");
+    FAIL(graph != NULL,
+         "graph_load_binary() accepted a neighbor out of range")
+    graph = graph_load(TEST_GRAPH_PATH, NULL);
+    FAIL(graph == NULL || graph->mapping != NULL || graph->neighbors[0] != 1,
+         "graph_load() did not parse again past a corrupt cache")
+    graph_delete(graph);
+
+    SUBTEST(reject_wrapping_cache_lengths)
+    // An edge count whose size in bytes wraps around to that of the real
+    // neighbor section, with offsets that still end at it.
+    //
+    graph = create_test_graph();
+    FAIL(!graph_save_binary(graph, TEST_GRAPH_PATH ".csr"),
+         "graph_save_binary() failed")
+    cache = fopen(TEST_GRAPH_PATH ".csr", "r+b");
+    FAIL(cache == NULL || fread(&header, sizeof(header), 1, cache) != 1,
+         "Could not read the cache header")
+    uint64_t wrapping = (UINT64_C(1) << 62) + graph->edge_count;
+    header.edge_count = wrapping;
+    bool written = fseek(cache, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, cache) == 1;
+    for (int i = 0; i < GRAPH_CACHE_MAX_SECTIONS; i++) {
+        if (header.sections[i].type == GRAPH_CACHE_SECTION_OFFSETS) {
+            long last = (long)(header.sections[i].offset + graph->vertex_count * sizeof(uint64_t));
+            written = written && fseek(cache, last, SEEK_SET) == 0 &&
+                      fwrite(&wrapping, sizeof(wrapping), 1, cache) == 1;
+        }
+    }
+    fclose(cache);
+    FAIL(!written,
+         "Could not corrupt the cache")
+    mapped = graph_load_binary(TEST_GRAPH_PATH ".csr");
+    FAIL(mapped != NULL,
+         "graph_load_binary() accepted an edge count whose size wraps")
+    graph_delete(graph);
+
+    SUBTEST(reject_bad_cache)
+    out = fopen(TEST_GRAPH_PATH ".csr", "w");
+    fprintf(out, "definitely not a graph");
+    fclose(out);
+    graph = graph_load_binary(TEST_GRAPH_PATH ".csr");
+    FAIL(graph != NULL,
+         "graph_load_binary() accepted a corrupt file")
+
+    remove(TEST_GRAPH_PATH);
+    remove(TEST_GRAPH_PATH ".csr");
+    PASS(check_binary_cache)
+}
+
+// bsearch() comparison function for vertex IDs.
+static int compare_vertices(const void * a, const void * b) {
+    unsigned int x = *(const unsigned int *)a;
+    unsigned int y = *(const unsigned int *)b;
+
+    return (x > y) - (x < y);
+}
+
+// Returns TRUE if the reordered graph has exactly the edges of the
+// original one, under the vertex ID mapping of labels.
+static bool same_edges_after_reorder(const struct graph * graph,
+                                     const struct graph * reordered,
+                                     const struct graph * labels) {
+    if (reordered->vertex_count != graph->vertex_count || reordered->edge_count != graph->edge_count) {
+        return false;
+    }
+
+    for (unsigned int v = 0; v < reordered->vertex_count; v++) {
+        unsigned int original = graph_original_id(labels, v);
+
+        if (graph_vertex_id(labels, original) != v ||
+            graph_degree(reordered, v) != graph_degree(graph, original)) {
+            return false;
+        }
+
+        for (uint64_t e = reordered->offsets[v]; e < reordered->offsets[v + 1]; e++) {
+            if (e > reordered->offsets[v] && reordered->neighbors[e - 1] > reordered->neighbors[e]) {
+                return false;
+            }
+        }
+
+        for (uint64_t e = graph->offsets[original]; e < graph->offsets[original + 1]; e++) {
+            unsigned int w = graph_vertex_id(labels, graph->neighbors[e]);
+
+            if (bsearch(&w, &reordered->neighbors[reordered->offsets[v]], graph_degree(reordered, v),
+                        sizeof(unsigned int), compare_vertices) == NULL) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void check_graph_reorder(void) {
+    TEST(check_graph_reorder)
+    struct graph * graph = create_random_graph(2000, 10000, 5);
+    const enum graph_order orders[] = {GRAPH_ORDER_DEGREE, GRAPH_ORDER_RCM, GRAPH_ORDER_HUB};
+
+    SUBTEST(graph_reorder_keeps_edges)
+    for (size_t i = 0; i < sizeof(orders) / sizeof(orders[0]); i++) {
+        struct graph * reordered = graph_reorder(graph, orders[i]);
+        FAIL(reordered == NULL || reordered->order != orders[i] || reordered->original_ids == NULL,
+             "graph_reorder() failed")
+        FAIL(!same_edges_after_reorder(graph, reordered, reordered),
+             "Reordered graph does not have the original edges")
+        graph_delete(reordered);
+    }
+
+    SUBTEST(graph_reorder_degree_order)
+    struct graph * reordered = graph_reorder(graph, GRAPH_ORDER_DEGREE);
+    struct graph * transpose = graph_transpose(reordered);
+    for (unsigned int v = 1; v < reordered->vertex_count; v++) {
+        FAIL(graph_degree(reordered, v - 1) + graph_degree(transpose, v - 1) <
+             graph_degree(reordered, v) + graph_degree(transpose, v),
+             "Degree order is not by decreasing degree")
+    }
+    graph_delete(transpose);
+
+    SUBTEST(graph_reorder_twice)
+    graph->transpose = graph_transpose(graph);
+    struct graph * twice = graph_reorder(reordered, GRAPH_ORDER_RCM);
+    FAIL(twice == NULL || !same_edges_after_reorder(graph, twice, twice),
+         "Reordering a reordered graph lost the original IDs")
+    struct graph * restored = graph_reorder(twice, GRAPH_ORDER_NONE);
+    FAIL(restored == NULL || restored->original_ids != NULL || restored->order != GRAPH_ORDER_NONE,
+         "GRAPH_ORDER_NONE did not drop the ID mapping")
+    FAIL(memcmp(restored->offsets, graph->offsets, (graph->vertex_count + 1) * sizeof(uint64_t)) != 0 ||
+         memcmp(restored->neighbors, graph->neighbors, graph->edge_count * sizeof(unsigned int)) != 0,
+         "GRAPH_ORDER_NONE did not restore the original graph")
+    graph_delete(restored);
+    graph_delete(twice);
+    graph_delete(reordered);
+
+    SUBTEST(graph_reorder_keeps_distances)
+    reordered = graph_reorder(graph, GRAPH_ORDER_RCM);
+    FAIL(reordered == NULL || reordered->transpose == NULL,
+         "graph_reorder() did not rebuild the transpose")
+    FAIL(!same_edges_after_reorder(graph->transpose, reordered->transpose, reordered),
+         "Rebuilt transpose does not have the original edges")
+    struct rng rng;
+    rng_seed(&rng, 6);
+    for (unsigned int q = 0; q < 100; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats expected, stats;
+
+        bfs_path_exists(graph, source, target, &expected);
+        bfs_path_exists(reordered, graph_vertex_id(reordered, source),
+                        graph_vertex_id(reordered, target), &stats);
+        FAIL(stats.distance != expected.distance,
+             "BFS distance changed after reordering")
+    }
+    graph_delete(reordered);
+    graph_delete(graph);
+
+    SUBTEST(load_keeps_order_in_cache)
+    FILE * out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate pattern general\n");
+    fprintf(out, "4 4 4\n1 2\n4 3\n4 1\n4 2\n");
+    fclose(out);
+    remove(TEST_GRAPH_PATH ".csr");
+
+    struct graph_load_options options = {.use_cache = true, .threads = 0, .order = GRAPH_ORDER_DEGREE};
+    graph = graph_load(TEST_GRAPH_PATH, &options);
+    FAIL(graph == NULL || graph->order != GRAPH_ORDER_DEGREE,
+         "graph_load() did not reorder the graph")
+    graph_delete(graph);
+
+    graph = graph_load(TEST_GRAPH_PATH, &options);
+    FAIL(graph == NULL || graph->mapping == NULL || graph->order != GRAPH_ORDER_DEGREE,
+         "Reordered cache was not mapped")
+    FAIL(graph_original_id(graph, 0) != 3 || graph_vertex_id(graph, 3) != 0,
+         "Cached original IDs are wrong")
+    unsigned int target = graph_vertex_id(graph, 2);
+    FAIL(graph_degree(graph, 0) != 3 ||
+         bsearch(&target, graph->neighbors, 3, sizeof(unsigned int), compare_vertices) == NULL,
+         "Cached reordered graph has the wrong edges")
+    graph_delete(graph);
+
+    graph = graph_load(TEST_GRAPH_PATH, NULL);
+    FAIL(graph == NULL || graph->order != GRAPH_ORDER_NONE || graph->original_ids != NULL,
+         "graph_load() did not restore the file order")
+    FAIL(graph->neighbors[graph->offsets[3]] != 0,
+         "Restored graph has the wrong edges")
+    graph_delete(graph);
+
+    remove(TEST_GRAPH_PATH);
+    remove(TEST_GRAPH_PATH ".csr");
+    PASS(check_graph_reorder)
+}
+
+void check_graph_compressed(void) {
+    TEST(check_graph_compressed)
+    struct graph * graph = create_random_graph(3000, 30000, 7);
+    struct bfs_stats stats;
+
+    SUBTEST(graph_compress_round_trip)
+    struct graph_compressed * compressed = graph_compress(graph);
+    FAIL(compressed == NULL || compressed->edge_count != graph->edge_count,
+         "graph_compress() failed")
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        struct graph_compressed_cursor cursor;
+        unsigned int neighbor = 0;
+        uint64_t e = graph->offsets[v];
+
+        graph_compressed_begin(compressed, v, &cursor);
+        while (graph_compressed_next(&cursor, &neighbor)) {
+            FAIL(e == graph->offsets[v + 1] || neighbor != graph->neighbors[e],
+                 "Decoded neighbor list differs from the graph")
+            e += 1;
+        }
+        FAIL(e != graph->offsets[v + 1],
+             "Decoded neighbor list is too short")
+    }
+
+    SUBTEST(graph_compress_is_smaller)
+    FAIL(compressed->data_length >= graph->edge_count * sizeof(unsigned int) / 2,
+         "Neighbor lists did not shrink to under 2 bytes per edge")
+
+    SUBTEST(graph_compress_large_differences)
+    // Multi-byte varints both ways from the vertex, and duplicates.
+    //
+    const unsigned int wide_vertices[] = {5, 4000000};
+    struct graph_edge edges[] = {{5, 0}, {5, 5}, {5, 5}, {5, 4000000}, {4000000, 200}, {4000000, 70000}};
+    struct graph * wide = graph_create_from_edges(4000001, edges, 6);
+    struct graph_compressed * wide_compressed = graph_compress(wide);
+    FAIL(wide == NULL || wide_compressed == NULL,
+         "graph_compress() failed on a wide graph")
+    for (size_t i = 0; i < 2; i++) {
+        struct graph_compressed_cursor cursor;
+        unsigned int v = wide_vertices[i];
+        unsigned int neighbor = 0;
+
+        graph_compressed_begin(wide_compressed, v, &cursor);
+        for (uint64_t e = wide->offsets[v]; e < wide->offsets[v + 1]; e++) {
+            FAIL(!graph_compressed_next(&cursor, &neighbor) || neighbor != wide->neighbors[e],
+                 "Wide neighbor list decoded wrong")
+        }
+        FAIL(graph_compressed_next(&cursor, &neighbor),
+             "Wide neighbor list did not end")
+    }
+    graph_compressed_delete(wide_compressed);
+    graph_delete(wide);
+
+    SUBTEST(bfs_compressed_matches_serial)
+    struct rng rng;
+    rng_seed(&rng, 8);
+    for (unsigned int q = 0; q < 200; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        bool status = bfs_compressed_path_exists(compressed, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance ||
+             stats.edges_traversed != serial.edges_traversed,
+             "Compressed BFS disagrees with serial BFS")
+    }
+    FAIL(bfs_compressed_path_exists(compressed, 0, graph->vertex_count, &stats) != false,
+         "Compressed BFS accepted an out of range target")
+
+    graph_compressed_delete(compressed);
+    graph_delete(graph);
+    PASS(check_graph_compressed)
+}
+
+void check_graph_scc(void) {
+    TEST(check_graph_scc)
+
+    SUBTEST(graph_scc_small_graph)
+    struct graph * graph = create_test_graph();
+    struct graph_scc * scc = graph_scc_compute(graph);
+    FAIL(scc == NULL,
+         "graph_scc_compute() failed")
+    FAIL(scc->component_count != 6 || scc->largest_component != 3,
+         "Expected 6 components, the largest {1, 2, 3}")
+    FAIL(scc->components[1] != scc->components[2] || scc->components[2] != scc->components[3] ||
+         scc->components[0] == scc->components[1] || scc->components[4] == scc->components[0],
+         "Wrong components")
+    FAIL(!(scc->components[4] < scc->components[0] && scc->components[0] < scc->components[1]) ||
+         !(scc->components[5] < scc->components[6]),
+         "Components are not numbered in topological order")
+    FAIL(scc->levels[scc->components[4]] != 0 || scc->levels[scc->components[0]] != 1 ||
+         scc->levels[scc->components[1]] != 2 || scc->levels[scc->components[7]] != 0,
+         "Wrong component levels")
+
+    SUBTEST(graph_scc_reachable)
+    FAIL(graph_scc_reachable(scc, 3, 2) != GRAPH_SCC_REACHABLE,
+         "3 -> 2 is within one component")
+    FAIL(graph_scc_reachable(scc, 3, 0) != GRAPH_SCC_UNREACHABLE ||
+         graph_scc_reachable(scc, 6, 5) != GRAPH_SCC_UNREACHABLE ||
+         graph_scc_reachable(scc, 7, 4) != GRAPH_SCC_UNREACHABLE,
+         "Unreachable pairs were not refused")
+    FAIL(graph_scc_reachable(scc, 4, 3) != GRAPH_SCC_UNKNOWN,
+         "4 -> 3 needs a search")
+    graph_scc_delete(scc);
+    graph_delete(graph);
+
+    SUBTEST(graph_scc_deep_graph)
+    // A path far deeper than any call stack, closed into one cycle and
+    // then left open.
+    //
+    unsigned int vertex_count = 1000000;
+    struct graph_edge * edges = malloc(vertex_count * sizeof(struct graph_edge));
+    for (unsigned int v = 0; v < vertex_count; v++) {
+        edges[v].source = v;
+        edges[v].target = (v + 1) % vertex_count;
+    }
+    graph = graph_create_from_edges(vertex_count, edges, vertex_count);
+    scc = graph_scc_compute(graph);
+    FAIL(scc == NULL || scc->component_count != 1 || scc->largest_component != vertex_count,
+         "A cycle is one component")
+    graph_scc_delete(scc);
+    graph_delete(graph);
+
+    graph = graph_create_from_edges(vertex_count, edges, vertex_count - 1);
+    scc = graph_scc_compute(graph);
+    FAIL(scc == NULL || scc->component_count != vertex_count ||
+         scc->levels[scc->components[vertex_count - 1]] != vertex_count - 1,
+         "A path is one component per vertex")
+    graph_scc_delete(scc);
+    graph_delete(graph);
+    free(edges);
+
+    SUBTEST(graph_scc_matches_serial)
+    graph = create_random_graph(3000, 4500, 15);
+    scc = graph_scc_compute(graph);
+    struct rng rng;
+    rng_seed(&rng, 16);
+    for (unsigned int q = 0; q < 2000; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial, stats;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        enum graph_scc_answer answer = graph_scc_reachable(scc, source, target);
+        FAIL((answer == GRAPH_SCC_UNREACHABLE && expected) ||
+             (answer == GRAPH_SCC_REACHABLE && !expected),
+             "Condensation answer disagrees with serial BFS")
+
+        bool status = bfs_scc_path_exists(scc, graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Pruned BFS disagrees with serial BFS")
+    }
+    graph_scc_delete(scc);
+    graph_delete(graph);
+    PASS(check_graph_scc)
+}
+
+void check_graph_landmarks(void) {
+    TEST(check_graph_landmarks)
+    unsigned int lower = 0, upper = 0;
+    bool status;
+
+    SUBTEST(graph_landmarks_small_graph)
+    // Total degrees: 1, 2 and 3 have 3, 0 has 3 too, so the first three
+    // are 0, 1 and 2 (the lowest IDs win ties).
+    //
+    struct graph * graph = create_test_graph();
+    struct graph_landmarks * landmarks = graph_landmarks_build(graph, 3);
+    FAIL(landmarks == NULL,
+         "graph_landmarks_build() failed")
+    FAIL(landmarks->count != 3 || landmarks->landmarks[0] != 0 ||
+         landmarks->landmarks[1] != 1 || landmarks->landmarks[2] != 2,
+         "Wrong landmarks chosen")
+    FAIL(landmarks->from[3 * 3 + 0] != 2 || landmarks->to[4 * 3 + 0] != 1 ||
+         landmarks->from[4 * 3 + 0] != GRAPH_LANDMARKS_UNREACHABLE,
+         "Wrong landmark distances")
+    FAIL(graph_landmarks_build(graph, 0) != NULL || graph_landmarks_build(graph, 9) != NULL,
+         "graph_landmarks_build() accepted a bad landmark count")
+
+    SUBTEST(graph_landmarks_bounds)
+    status = graph_landmarks_bounds(landmarks, 0, 3, &lower, &upper);
+    FAIL(status != true || lower != 2 || upper != 2,
+         "0 -> 3 should be settled at 2 by landmark 0")
+    status = graph_landmarks_bounds(landmarks, 4, 3, &lower, &upper);
+    FAIL(status != true || lower != 1 || upper != 3,
+         "4 -> 3 should be bounded by 1 (landmark 1) and 3 (landmark 0)")
+    status = graph_landmarks_bounds(landmarks, 3, 0, &lower, &upper);
+    FAIL(status != false,
+         "3 -> 0 should be proven unreachable")
+    graph_landmarks_delete(landmarks);
+    graph_delete(graph);
+
+    SUBTEST(graph_landmarks_matches_serial)
+    graph = create_random_graph(3000, 9000, 17);
+    landmarks = graph_landmarks_build(graph, 8);
+    FAIL(landmarks == NULL,
+         "graph_landmarks_build() failed")
+    struct rng rng;
+    rng_seed(&rng, 18);
+    for (unsigned int q = 0; q < 2000; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial, stats;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        status = graph_landmarks_bounds(landmarks, source, target, &lower, &upper);
+        FAIL((!status && expected) || (expected && (lower > serial.distance || upper < serial.distance)) ||
+             (!expected && upper != UINT32_MAX),
+             "Landmark bounds do not hold")
+
+        status = bfs_landmarks_path_exists(landmarks, graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Landmark BFS disagrees with serial BFS")
+    }
+
+    SUBTEST(graph_landmarks_save_and_load)
+    status = graph_landmarks_save(landmarks, graph, TEST_GRAPH_PATH ".csr.landmarks");
+    FAIL(status != true,
+         "graph_landmarks_save() failed")
+    struct graph_landmarks * mapped = graph_landmarks_load(TEST_GRAPH_PATH ".csr.landmarks", graph);
+    FAIL(mapped == NULL || mapped->count != landmarks->count ||
+         memcmp(mapped->landmarks, landmarks->landmarks, landmarks->count * sizeof(unsigned int)) != 0 ||
+         memcmp(mapped->from, landmarks->from, graph_landmarks_bytes(landmarks) / 2) != 0 ||
+         memcmp(mapped->to, landmarks->to, graph_landmarks_bytes(landmarks) / 2) != 0,
+         "Mapped index differs from the one saved")
+    graph_landmarks_delete(mapped);
+
+    struct graph * other = create_random_graph(3000, 9000, 19);
+    FAIL(graph_landmarks_load(TEST_GRAPH_PATH ".csr.landmarks", other) != NULL,
+         "Index loaded for a graph it was not built for")
+
+    SUBTEST(graph_landmarks_load_or_build)
+    // The sidecar of a .mtx file sits next to its cache; one for another
+    // graph is rebuilt and replaced.
+    //
+    char path[4096];
+    graph_landmarks_path(TEST_GRAPH_PATH, path, sizeof(path));
+    FAIL(strcmp(path, TEST_GRAPH_PATH ".csr.landmarks") != 0,
+         "Wrong index path")
+    mapped = graph_landmarks_load_or_build(TEST_GRAPH_PATH, other, 4);
+    FAIL(mapped == NULL || mapped->count != 4 || mapped->mapping != NULL,
+         "Index was not rebuilt for another graph")
+    graph_landmarks_delete(mapped);
+    mapped = graph_landmarks_load_or_build(TEST_GRAPH_PATH, other, 4);
+    FAIL(mapped == NULL || mapped->mapping == NULL,
+         "Rebuilt index was not saved")
+    graph_landmarks_delete(mapped);
+    remove(TEST_GRAPH_PATH ".csr.landmarks");
+
+    graph_delete(other);
+    graph_landmarks_delete(landmarks);
+    graph_delete(graph);
+    PASS(check_graph_landmarks)
+}
+
+void check_bfs_path_exists(void) {
+    TEST(check_bfs_path_exists)
+    struct graph * graph = create_test_graph();
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_reachable)
+    bool status = bfs_path_exists(graph, 4, 3, &stats);
+    FAIL(status != true,
+         "No path found from 4 to 3")
+    FAIL(stats.distance != 3,
+         "Distance from 4 to 3 is not 3")
+
+    SUBTEST(bfs_unreachable)
+    status = bfs_path_exists(graph, 1, 0, &stats);
+    FAIL(status != false,
+         "Found a path from 1 to 0")
+    FAIL(stats.distance != BFS_UNREACHABLE,
+         "Distance from 1 to 0 is not BFS_UNREACHABLE")
+
+    SUBTEST(bfs_other_component)
+    status = bfs_path_exists(graph, 0, 6, NULL);
+    FAIL(status != false,
+         "Found a path from 0 to 6")
+
+    SUBTEST(bfs_source_is_target)
+    status = bfs_path_exists(graph, 7, 7, &stats);
+    FAIL(status != true || stats.distance != 0,
+         "Vertex 7 does not reach itself at distance 0")
+
+    SUBTEST(bfs_out_of_range)
+    status = bfs_path_exists(graph, 0, 8, NULL);
+    FAIL(status != false,
+         "bfs_path_exists() accepted an out of range target")
+    status = bfs_path_exists(NULL, 0, 1, NULL);
+    FAIL(status != false,
+         "bfs_path_exists(NULL, ...) did not return false")
+
+    graph_delete(graph);
+    PASS(check_bfs_path_exists)
+}
+
+void check_bfs_workspace(void) {
+    TEST(check_bfs_workspace)
+    struct graph * graph = create_random_graph(3000, 6000, 11);
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_workspace_create)
+    struct bfs_workspace * workspace = bfs_workspace_create(graph->vertex_count);
+    FAIL(workspace == NULL,
+         "bfs_workspace_create() failed")
+
+    SUBTEST(bfs_workspace_matches_serial)
+    // Sparse enough that searches stop at all sorts of depths, so every
+    // query starts from whatever the previous one left behind.
+    //
+    struct rng rng;
+    rng_seed(&rng, 12);
+    for (unsigned int q = 0; q < 500; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        bool status = bfs_workspace_path_exists(workspace, graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance ||
+             stats.edges_traversed != serial.edges_traversed,
+             "Workspace BFS disagrees with serial BFS")
+    }
+
+    SUBTEST(bfs_workspace_distances)
+    unsigned int * distances = malloc(graph->vertex_count * sizeof(unsigned int));
+    for (unsigned int source = 0; source < 20; source++) {
+        FAIL(!bfs_workspace_distances(workspace, graph, source, distances, NULL),
+             "bfs_workspace_distances() failed")
+
+        for (unsigned int target = 0; target < graph->vertex_count; target += 37) {
+            struct bfs_stats serial;
+            bfs_path_exists(graph, source, target, &serial);
+            FAIL(distances[target] != serial.distance,
+                 "Workspace distances disagree with serial BFS")
+        }
+
+        // And a search straight after a sweep starts from a clean slate.
+        //
+        struct bfs_stats serial;
+        bool expected = bfs_path_exists(graph, source + 1, source, &serial);
+        bool status = bfs_workspace_path_exists(workspace, graph, source + 1, source, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Workspace BFS after a sweep disagrees with serial BFS")
+    }
+    free(distances);
+
+    SUBTEST(bfs_workspace_path)
+    // Alternating with existence searches, which share the queue.
+    //
+    for (unsigned int q = 0; q < 500; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+        size_t length = 0;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        const unsigned int * path = bfs_workspace_path(workspace, graph, source, target, &length, &stats);
+        FAIL((path != NULL) != expected || stats.distance != serial.distance,
+             "Workspace path disagrees with serial BFS")
+        FAIL(expected && (length != (size_t)serial.distance + 1 || path[0] != source ||
+                          path[length - 1] != target),
+             "Workspace path has the wrong length or end points")
+        for (size_t i = 0; expected && i + 1 < length; i++) {
+            bool edge = false;
+            for (uint64_t e = graph->offsets[path[i]]; e < graph->offsets[path[i] + 1]; e++) {
+                edge = edge || graph->neighbors[e] == path[i + 1];
+            }
+            FAIL(!edge,
+                 "Workspace path follows an edge that does not exist")
+        }
+
+        bool status = bfs_workspace_path_exists(workspace, graph, target, source, &stats);
+        expected = bfs_path_exists(graph, target, source, &serial);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Workspace BFS after a path search disagrees with serial BFS")
+    }
+
+    SUBTEST(bfs_workspace_too_small)
+    struct graph * small = create_test_graph();
+    struct bfs_workspace * small_workspace = bfs_workspace_create(small->vertex_count);
+    bool status = bfs_workspace_path_exists(small_workspace, small, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 3,
+         "Workspace BFS did not find 4 -> 3 at distance 3")
+    size_t length = 0;
+    const unsigned int expected_path[] = {4, 0, 2, 3};
+    const unsigned int * path = bfs_workspace_path(small_workspace, small, 4, 3, &length, NULL);
+    FAIL(path == NULL || length != 4 || memcmp(path, expected_path, sizeof(expected_path)) != 0,
+         "Workspace path from 4 to 3 is not 4 0 2 3")
+    path = bfs_workspace_path(small_workspace, small, 7, 7, &length, NULL);
+    FAIL(path == NULL || length != 1 || path[0] != 7,
+         "Workspace path from 7 to itself is not just 7")
+    path = bfs_workspace_path(small_workspace, small, 1, 0, &length, NULL);
+    FAIL(path != NULL || length != 0,
+         "Workspace path found a path from 1 to 0")
+    status = bfs_workspace_path_exists(small_workspace, graph, 0, 1, &stats);
+    FAIL(status != false,
+         "Workspace BFS searched a graph larger than the workspace")
+    bfs_workspace_delete(small_workspace);
+    graph_delete(small);
+
+    bfs_workspace_delete(workspace);
+    graph_delete(graph);
+    PASS(check_bfs_workspace)
+}
+
+void check_bfs_cache(void) {
+    TEST(check_bfs_cache)
+    struct graph * graph = create_random_graph(3000, 6000, 13);
+    struct bfs_cache_stats cache_stats;
+    struct bfs_stats stats;
+    bool status;
+
+    SUBTEST(bfs_cache_create)
+    size_t array_bytes = (graph->vertex_count + 1) * sizeof(unsigned int);
+    struct bfs_cache * cache = bfs_cache_create(graph, 4, 2 * array_bytes);
+    FAIL(cache == NULL,
+         "bfs_cache_create() failed")
+    FAIL(bfs_cache_create(NULL, 4, 0) != NULL,
+         "bfs_cache_create() accepted a NULL graph")
+
+    SUBTEST(bfs_cache_pair_hit)
+    struct bfs_stats serial;
+    bool expected = bfs_path_exists(graph, 1, 2, &serial);
+    status = bfs_cache_path_exists(cache, 1, 2, &stats);
+    FAIL(status != expected || stats.distance != serial.distance,
+         "Cached BFS disagrees with serial BFS on a miss")
+    status = bfs_cache_path_exists(cache, 1, 2, &stats);
+    bfs_cache_get_stats(cache, &cache_stats);
+    FAIL(status != expected || stats.distance != serial.distance || stats.edges_traversed != 0,
+         "Cached BFS searched again for a cached pair")
+    FAIL(cache_stats.lookups != 2 || cache_stats.pair_hits != 1 || cache_stats.pair_entries != 1,
+         "Cache stats do not show one pair hit")
+
+    SUBTEST(bfs_cache_pair_eviction)
+    // Four more pairs push (1, 2) out of a four entry cache.
+    //
+    for (unsigned int target = 3; target < 7; target++) {
+        bfs_cache_path_exists(cache, 100 + target, target, &stats);
+    }
+    bfs_cache_path_exists(cache, 1, 2, &stats);
+    bfs_cache_get_stats(cache, &cache_stats);
+    FAIL(cache_stats.pair_hits != 1 || cache_stats.pair_entries != 4,
+         "Least recently used pair was not evicted")
+
+    SUBTEST(bfs_cache_source_hit)
+    // Source 1 has now missed twice, so its second miss filled a
+    // distance array and other targets come from it.
+    //
+    FAIL(cache_stats.source_fills != 1 || cache_stats.source_entries != 1,
+         "Recurring source did not get a distance array")
+    size_t before = cache_stats.memory_bytes;
+    for (unsigned int target = 0; target < graph->vertex_count; target += 7) {
+        expected = bfs_path_exists(graph, 1, target, &serial);
+        status = bfs_cache_path_exists(cache, 1, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Source distance array disagrees with serial BFS")
+    }
+    bfs_cache_get_stats(cache, &cache_stats);
+    FAIL(cache_stats.source_hits == 0 || cache_stats.source_fills != 1 ||
+         cache_stats.memory_bytes != before,
+         "Source distance array was not reused")
+
+    SUBTEST(bfs_cache_memory_bound)
+    // Room for two arrays: a third recurring source evicts the oldest
+    // and reuses its memory.
+    //
+    for (unsigned int source = 10; source < 13; source++) {
+        bfs_cache_path_exists(cache, source, 0, &stats);
+        bfs_cache_path_exists(cache, source, 1, &stats);
+    }
+    bfs_cache_get_stats(cache, &cache_stats);
+    FAIL(cache_stats.source_fills != 4 || cache_stats.source_entries != 2 ||
+         cache_stats.memory_bytes != before + array_bytes,
+         "Source arrays exceeded the memory budget")
+
+    SUBTEST(bfs_cache_matches_serial)
+    struct rng rng;
+    rng_seed(&rng, 14);
+    for (unsigned int q = 0; q < 2000; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, 16);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+
+        expected = bfs_path_exists(graph, source, target, &serial);
+        status = bfs_cache_path_exists(cache, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Cached BFS disagrees with serial BFS")
+    }
+    status = bfs_cache_path_exists(cache, 0, graph->vertex_count, &stats);
+    FAIL(status != false,
+         "Cached BFS accepted a target out of range")
+    bfs_cache_delete(cache);
+
+    SUBTEST(bfs_cache_disabled)
+    cache = bfs_cache_create(graph, 0, 0);
+    expected = bfs_path_exists(graph, 1, 2, &serial);
+    for (unsigned int q = 0; q < 3; q++) {
+        status = bfs_cache_path_exists(cache, 1, 2, &stats);
+    }
+    bfs_cache_get_stats(cache, &cache_stats);
+    FAIL(status != expected || cache_stats.pair_hits + cache_stats.source_hits != 0 ||
+         cache_stats.pair_entries + cache_stats.source_entries != 0,
+         "Disabled cache kept results")
+    bfs_cache_delete(cache);
+
+    graph_delete(graph);
+    PASS(check_bfs_cache)
+}
+
+void check_bfs_parallel(void) {
+    TEST(check_bfs_parallel)
+    struct graph * graph = create_test_graph();
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_pool_create)
+    struct bfs_pool * pool = bfs_pool_create(3);
+    FAIL(pool == NULL || bfs_pool_threads(pool) != 3,
+         "bfs_pool_create(3) did not start 3 threads")
+
+    SUBTEST(bfs_parallel_small_graph)
+    bool status = bfs_parallel_path_exists(pool, graph, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 3,
+         "Parallel BFS did not find 4 -> 3 at distance 3")
+    status = bfs_parallel_path_exists(pool, graph, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "Parallel BFS found a path from 1 to 0")
+    status = bfs_parallel_path_exists(pool, graph, 7, 7, &stats);
+    FAIL(status != true || stats.distance != 0,
+         "Vertex 7 does not reach itself at distance 0")
+    status = bfs_parallel_path_exists(pool, graph, 0, 8, NULL);
+    FAIL(status != false,
+         "bfs_parallel_path_exists() accepted an out of range target")
+    graph_delete(graph);
+
+    SUBTEST(bfs_parallel_matches_serial)
+    graph = create_random_graph(5000, 6000, 1);
+    struct rng rng;
+    rng_seed(&rng, 2);
+    for (unsigned int q = 0; q < 200; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        status = bfs_parallel_path_exists(pool, graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Parallel BFS disagrees with serial BFS")
+    }
+    graph_delete(graph);
+
+    bfs_pool_delete(pool);
+    PASS(check_bfs_parallel)
+}
+
+void check_bfs_partitioned(void) {
+    TEST(check_bfs_partitioned)
+    struct graph * graph = create_test_graph();
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_partitioned_create)
+    struct bfs_partitioned * partitioned = bfs_partitioned_create(graph, 3);
+    FAIL(partitioned == NULL || bfs_partitioned_workers(partitioned) != 3,
+         "bfs_partitioned_create(3) did not start 3 workers")
+
+    SUBTEST(bfs_partitioned_small_graph)
+    bool status = bfs_partitioned_path_exists(partitioned, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 3,
+         "Partitioned BFS did not find 4 -> 3 at distance 3")
+    FAIL(bfs_partitioned_vertices_exchanged(partitioned) == 0,
+         "Partitioned BFS found 4 -> 3 without the workers exchanging vertices")
+    status = bfs_partitioned_path_exists(partitioned, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "Partitioned BFS found a path from 1 to 0")
+    status = bfs_partitioned_path_exists(partitioned, 7, 7, &stats);
+    FAIL(status != true || stats.distance != 0,
+         "Vertex 7 does not reach itself at distance 0")
+    status = bfs_partitioned_path_exists(partitioned, 0, 8, NULL);
+    FAIL(status != false,
+         "bfs_partitioned_path_exists() accepted an out of range target")
+    bfs_partitioned_delete(partitioned);
+
+    SUBTEST(bfs_partitioned_more_workers_than_vertices)
+    partitioned = bfs_partitioned_create(graph, BFS_PARTITIONED_MAX_WORKERS);
+    FAIL(partitioned == NULL || !bfs_partitioned_path_exists(partitioned, 4, 3, &stats) ||
+         stats.distance != 3 || bfs_partitioned_path_exists(partitioned, 5, 4, NULL),
+         "Partitioned BFS with empty partitions got 4 -> 3 or 5 -> 4 wrong")
+    bfs_partitioned_delete(partitioned);
+    graph_delete(graph);
+
+    SUBTEST(bfs_partitioned_matches_serial)
+    // Dense enough that a level sends more vertices than a ring holds.
+    //
+    graph = create_random_graph(40000, 400000, 4);
+    partitioned = bfs_partitioned_create(graph, 4);
+    FAIL(partitioned == NULL, "bfs_partitioned_create(4) failed")
+    struct rng rng;
+    rng_seed(&rng, 5);
+    for (unsigned int q = 0; q < 50; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        status = bfs_partitioned_path_exists(partitioned, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Partitioned BFS disagrees with serial BFS")
+    }
+    bfs_partitioned_delete(partitioned);
+    graph_delete(graph);
+
+    SUBTEST(bfs_partitioned_worker_dies)
+    graph = create_test_graph();
+    partitioned = bfs_partitioned_create(graph, 3);
+    FAIL(partitioned == NULL, "bfs_partitioned_create(3) failed")
+    kill(bfs_partitioned_worker_pid(partitioned, 1), SIGKILL);
+    FAIL(bfs_partitioned_path_exists(partitioned, 4, 3, NULL),
+         "Partitioned BFS answered with a dead worker")
+    FAIL(bfs_partitioned_worker_pid(partitioned, 1) != -1,
+         "Partitioned BFS did not reap its dead worker")
+    FAIL(bfs_partitioned_path_exists(partitioned, 7, 7, NULL),
+         "Partitioned BFS answered after a worker died")
+    bfs_partitioned_delete(partitioned);
+    graph_delete(graph);
+
+    PASS(check_bfs_partitioned)
+}
+
+void check_bfs_direction_optimizing(void) {
+    TEST(check_bfs_direction_optimizing)
+    struct graph * graph = create_test_graph();
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_direction_needs_transpose)
+    bool status = bfs_direction_optimizing_path_exists(graph, 4, 3, NULL);
+    FAIL(status != false,
+         "Direction-optimizing BFS ran without a transpose")
+
+    SUBTEST(bfs_direction_small_graph)
+    graph->transpose = graph_transpose(graph);
+    status = bfs_direction_optimizing_path_exists(graph, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 3,
+         "Direction-optimizing BFS did not find 4 -> 3 at distance 3")
+    status = bfs_direction_optimizing_path_exists(graph, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "Direction-optimizing BFS found a path from 1 to 0")
+    graph_delete(graph);
+
+    SUBTEST(bfs_direction_matches_serial)
+    // Dense enough that the middle levels go bottom-up.
+    //
+    graph = create_random_graph(3000, 30000, 3);
+    graph->transpose = graph_transpose(graph);
+    struct rng rng;
+    rng_seed(&rng, 4);
+    unsigned int bottom_up_levels = 0;
+    for (unsigned int q = 0; q < 200; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        status = bfs_direction_optimizing_path_exists(graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Direction-optimizing BFS disagrees with serial BFS")
+        bottom_up_levels += stats.bottom_up_levels;
+    }
+    FAIL(bottom_up_levels == 0,
+         "Direction-optimizing BFS never went bottom-up")
+    graph_delete(graph);
+
+    PASS(check_bfs_direction_optimizing)
+}
+
+void check_bfs_bidirectional(void) {
+    TEST(check_bfs_bidirectional)
+    struct graph * graph = create_test_graph();
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_bidirectional_small_graph)
+    bool status = bfs_bidirectional_path_exists(graph, 4, 3, NULL);
+    FAIL(status != false,
+         "Bidirectional BFS ran without a transpose")
+    graph->transpose = graph_transpose(graph);
+    status = bfs_bidirectional_path_exists(graph, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 3,
+         "Bidirectional BFS did not find 4 -> 3 at distance 3")
+    status = bfs_bidirectional_path_exists(graph, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "Bidirectional BFS found a path from 1 to 0")
+    status = bfs_bidirectional_path_exists(graph, 0, 1, &stats);
+    FAIL(status != true || stats.distance != 1,
+         "Bidirectional BFS did not find the edge 0 -> 1")
+    graph_delete(graph);
+
+    SUBTEST(bfs_bidirectional_matches_serial)
+    graph = create_random_graph(3000, 6000, 5);
+    graph->transpose = graph_transpose(graph);
+    struct rng rng;
+    rng_seed(&rng, 6);
+    for (unsigned int q = 0; q < 300; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        status = bfs_bidirectional_path_exists(graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Bidirectional BFS disagrees with serial BFS")
+    }
+    graph_delete(graph);
+
+    PASS(check_bfs_bidirectional)
+}
+
+void check_bfs_adaptive_frontier(void) {
+    TEST(check_bfs_adaptive_frontier)
+    unsigned int vertex = 0;
+
+    SUBTEST(bfs_frontier_stays_sparse)
+    struct bfs_frontier * frontier = bfs_frontier_create(6400);
+    FAIL(frontier == NULL,
+         "bfs_frontier_create() failed")
+    for (unsigned int v = 0; v < 6400 / BFS_FRONTIER_DENSE; v++) {
+        bfs_frontier_add(frontier, 6399 - v);
+    }
+    FAIL(frontier->mode != BFS_FRONTIER_MODE_SPARSE || bfs_frontier_size(frontier) != 200,
+         "Frontier at the threshold is not sparse")
+    FAIL(!bfs_frontier_pop(frontier, &vertex) || vertex != 6399,
+         "Sparse frontier did not pop in insertion order")
+    bfs_frontier_clear(frontier);
+    FAIL(bfs_frontier_size(frontier) != 0 || bfs_frontier_pop(frontier, &vertex),
+         "bfs_frontier_clear() left vertices behind")
+
+    SUBTEST(bfs_frontier_turns_dense)
+    for (unsigned int v = 0; v < 6400; v += 20) {
+        bfs_frontier_add(frontier, 6399 - v);
+    }
+    FAIL(frontier->mode != BFS_FRONTIER_MODE_DENSE,
+         "Frontier past the threshold did not turn dense")
+    bfs_frontier_adapt(frontier);
+    FAIL(bfs_frontier_size(frontier) != 320,
+         "bfs_frontier_adapt() miscounted a dense frontier")
+    unsigned int previous = 0;
+    size_t popped = 0;
+    while (bfs_frontier_pop(frontier, &vertex)) {
+        FAIL(popped != 0 && vertex <= previous,
+             "Dense frontier did not pop in increasing order")
+        FAIL(vertex % 20 != 19,
+             "Dense frontier popped a vertex never added")
+        previous = vertex;
+        popped += 1;
+    }
+    FAIL(popped != 320 || bfs_frontier_size(frontier) != 0,
+         "Dense frontier did not pop every vertex once")
+
+    SUBTEST(bfs_frontier_turns_sparse)
+    for (unsigned int v = 0; v < 50; v++) {
+        bfs_frontier_add(frontier, v * 7);
+    }
+    bfs_frontier_adapt(frontier);
+    FAIL(frontier->mode != BFS_FRONTIER_MODE_SPARSE || bfs_frontier_size(frontier) != 50,
+         "Shrunk frontier did not turn sparse")
+    FAIL(!bfs_frontier_pop(frontier, &vertex) || vertex != 0 ||
+         !bfs_frontier_pop(frontier, &vertex) || vertex != 7,
+         "Sparse frontier from a bitmap is not in increasing order")
+    bfs_frontier_delete(frontier);
+
+    SUBTEST(bfs_adaptive_small_graph)
+    struct graph * graph = create_test_graph();
+    struct bfs_stats stats;
+    bool status = bfs_adaptive_path_exists(graph, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 3,
+         "Adaptive BFS did not find 4 -> 3 at distance 3")
+    status = bfs_adaptive_path_exists(graph, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "Adaptive BFS found a path from 1 to 0")
+    graph_delete(graph);
+
+    SUBTEST(bfs_adaptive_matches_serial)
+    graph = create_random_graph(3000, 30000, 9);
+    struct rng rng;
+    rng_seed(&rng, 10);
+    unsigned int dense_levels = 0;
+    for (unsigned int q = 0; q < 200; q++) {
+        unsigned int source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        unsigned int target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        struct bfs_stats serial;
+
+        bool expected = bfs_path_exists(graph, source, target, &serial);
+        status = bfs_adaptive_path_exists(graph, source, target, &stats);
+        FAIL(status != expected || stats.distance != serial.distance,
+             "Adaptive BFS disagrees with serial BFS")
+        dense_levels += stats.dense_levels;
+    }
+    FAIL(dense_levels == 0,
+         "Adaptive BFS never used a dense frontier")
+    graph_delete(graph);
+
+    PASS(check_bfs_adaptive_frontier)
+}
+
+void check_bfs_multi_source(void) {
+    TEST(check_bfs_multi_source)
+    struct graph * graph = create_test_graph();
+
+    SUBTEST(bfs_multi_source_small_graph)
+    struct bfs_query small[] = {
+        {4, 3, 0}, {1, 0, 0}, {7, 7, 0}, {0, 6, 0}, {0, 8, 0}, {5, 6, 0}, {3, 2, 0}
+    };
+    const unsigned int expected_small[] = {3, BFS_UNREACHABLE, 0, BFS_UNREACHABLE, BFS_UNREACHABLE, 1, 2};
+    bool status = bfs_multi_source_batch(graph, small, sizeof(small) / sizeof(small[0]), NULL);
+    FAIL(status != true,
+         "bfs_multi_source_batch() failed")
+    for (size_t i = 0; i < sizeof(small) / sizeof(small[0]); i++) {
+        FAIL(small[i].distance != expected_small[i],
+             "Multi-source BFS answered a wrong distance on the small graph")
+    }
+    graph_delete(graph);
+
+    SUBTEST(bfs_multi_source_matches_serial)
+    // More queries than lanes, so that several sweeps run.
+    //
+    graph = create_random_graph(3000, 6000, 7);
+    struct bfs_query queries[3 * BFS_MULTI_SOURCE_LANES + 5];
+    size_t count = sizeof(queries) / sizeof(queries[0]);
+    struct rng rng;
+    rng_seed(&rng, 8);
+    for (size_t q = 0; q < count; q++) {
+        queries[q].source = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        queries[q].target = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+    }
+    status = bfs_multi_source_batch(graph, queries, count, NULL);
+    FAIL(status != true,
+         "bfs_multi_source_batch() failed")
+    for (size_t q = 0; q < count; q++) {
+        struct bfs_stats serial;
+        bfs_path_exists(graph, queries[q].source, queries[q].target, &serial);
+        FAIL(queries[q].distance != serial.distance,
+             "Multi-source BFS disagrees with serial BFS")
+    }
+    graph_delete(graph);
+
+    PASS(check_bfs_multi_source)
+}
+
+// Returns the root of v in a serial union-find forest, halving paths.
+//
+static unsigned int find_root(unsigned int * parents, unsigned int v) {
+    while (parents[v] != v) {
+        parents[v] = parents[parents[v]];
+        v = parents[v];
+    }
+
+    return v;
+}
+
+// Computes the weight of the lightest path from source to every vertex
+// by repeatedly settling the closest unsettled vertex, in O(V^2) time.
+//
+static void reference_distances(const struct graph * graph, const struct graph_weights * weights,
+                                unsigned int source, unsigned int * distances) {
+    bool * settled = calloc(graph->vertex_count, sizeof(bool));
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        distances[v] = BFS_UNREACHABLE;
+    }
+    distances[source] = 0;
+
+    for (;;) {
+        unsigned int closest = graph->vertex_count;
+        for (unsigned int v = 0; v < graph->vertex_count; v++) {
+            if (!settled[v] && distances[v] != BFS_UNREACHABLE &&
+                (closest == graph->vertex_count || distances[v] < distances[closest])) {
+                closest = v;
+            }
+        }
+        if (closest == graph->vertex_count) {
+            break;
+        }
+
+        settled[closest] = true;
+        for (uint64_t e = graph->offsets[closest]; e < graph->offsets[closest + 1]; e++) {
+            unsigned int distance = distances[closest] + weights->weights[e];
+            if (distance < distances[graph->neighbors[e]]) {
+                distances[graph->neighbors[e]] = distance;
+            }
+        }
+    }
+
+    free(settled);
+}
+
+void check_bfs_0_1(void) {
+    TEST(check_bfs_0_1)
+    struct bfs_stats stats;
+
+    SUBTEST(graph_weights_load)
+    // The test graph, with the detour 0 -> 1 -> 2 free, and an entry
+    // for an edge that is not in the graph.
+    //
+    FILE * out = fopen(TEST_GRAPH_PATH, "w");
+    FAIL(out == NULL,
+         "Could not write test graph")
+    fprintf(out, "%%%%MatrixMarket matrix coordinate integer general\n");
+    fprintf(out, "8 8 8\n1 3 1\n1 2 0\n2 3 0\n3 4 1\n4 2 1\n5 1 1\n6 7 0\n8 8 0\n");
+    fclose(out);
+    struct graph * graph = create_test_graph();
+    struct graph_weights * weights = graph_weights_load(TEST_GRAPH_PATH, graph);
+    FAIL(graph == NULL || weights == NULL,
+         "graph_weights_load() failed")
+    FAIL(weights->edge_count != 7 || weights->max_weight != 1 ||
+         weights->weights[graph->offsets[0]] != 0 || weights->weights[graph->offsets[0] + 1] != 1,
+         "Edges 0 -> 1 and 0 -> 2 do not weigh 0 and 1")
+
+    SUBTEST(bfs_0_1_small_graph)
+    bool status = bfs_0_1_path_exists(graph, weights, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 2,
+         "0-1 BFS did not find 4 -> 3 at weight 2 over the free detour")
+    status = bfs_0_1_path_exists(graph, weights, 4, 2, &stats);
+    FAIL(status != true || stats.distance != 1,
+         "0-1 BFS did not find 4 -> 2 at weight 1")
+    status = bfs_0_1_path_exists(graph, weights, 5, 6, &stats);
+    FAIL(status != true || stats.distance != 0,
+         "0-1 BFS did not find 5 -> 6 at weight 0")
+    status = bfs_0_1_path_exists(graph, weights, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "0-1 BFS found a path from 1 to 0")
+    status = bfs_0_1_path_exists(graph, weights, 0, 8, NULL);
+    FAIL(status != false,
+         "bfs_0_1_path_exists() accepted an out of range target")
+    weights->max_weight = 2;
+    status = bfs_0_1_path_exists(graph, weights, 4, 3, NULL);
+    FAIL(status != false,
+         "bfs_0_1_path_exists() accepted a weight above 1")
+    graph_weights_delete(weights);
+
+    SUBTEST(graph_weights_load_missing_edge)
+    out = fopen(TEST_GRAPH_PATH, "w");
+    fprintf(out, "%%%%MatrixMarket matrix coordinate integer general\n8 8 1\n1 3 1\n");
+    fclose(out);
+    weights = graph_weights_load(TEST_GRAPH_PATH, graph);
+    FAIL(weights != NULL,
+         "graph_weights_load() accepted a file missing edges of the graph")
+    remove(TEST_GRAPH_PATH);
+    graph_delete(graph);
+
+    SUBTEST(bfs_0_1_matches_reference)
+    graph = create_random_graph(400, 1600, 21);
+    weights = graph_weights_create(graph, 1);
+    struct rng rng;
+    rng_seed(&rng, 22);
+    for (uint64_t e = 0; e < weights->edge_count; e++) {
+        weights->weights[e] = (unsigned int)rng_bounded(&rng, 2);
+    }
+    unsigned int * distances = malloc(graph->vertex_count * sizeof(unsigned int));
+    for (unsigned int source = 0; source < 40; source++) {
+        reference_distances(graph, weights, source, distances);
+        for (unsigned int target = 0; target < graph->vertex_count; target += 7) {
+            status = bfs_0_1_path_exists(graph, weights, source, target, &stats);
+            FAIL(status != (distances[target] != BFS_UNREACHABLE) || stats.distance != distances[target],
+                 "0-1 BFS disagrees with the reference distances")
+        }
+    }
+    free(distances);
+    graph_weights_delete(weights);
+    graph_delete(graph);
+
+    PASS(check_bfs_0_1)
+}
+
+void check_radix_heap(void) {
+    TEST(check_radix_heap)
+    unsigned int item = 0, key = 0;
+
+    SUBTEST(radix_heap_small)
+    struct radix_heap * heap = radix_heap_create(8);
+    FAIL(heap == NULL || radix_heap_size(heap) != 0 || radix_heap_has_next(heap) ||
+         radix_heap_pop_min(heap, &item, &key),
+         "New radix heap is not empty")
+    FAIL(!radix_heap_push(heap, 3, 40) || !radix_heap_push(heap, 5, 7) || !radix_heap_push(heap, 1, 40) ||
+         !radix_heap_push(heap, 0, 1000000),
+         "radix_heap_push() failed")
+    FAIL(radix_heap_push(heap, 3, 2) || radix_heap_push(heap, 8, 2),
+         "radix_heap_push() accepted an item twice or out of range")
+    FAIL(!radix_heap_decrease_key(heap, 0, 9) || radix_heap_decrease_key(heap, 0, 9) ||
+         radix_heap_decrease_key(heap, 2, 1),
+         "radix_heap_decrease_key() did not lower exactly a queued item's key")
+    FAIL(!radix_heap_contains(heap, 0, &key) || key != 9 || radix_heap_contains(heap, 2, NULL) ||
+         radix_heap_size(heap) != 4,
+         "Radix heap does not hold 4 items with item 0 at key 9")
+    FAIL(!radix_heap_pop_min(heap, &item, &key) || item != 5 || key != 7,
+         "Radix heap did not pop item 5 at key 7 first")
+    FAIL(radix_heap_push(heap, 6, 6) || radix_heap_decrease_key(heap, 0, 6),
+         "Radix heap accepted a key below the last one popped")
+    FAIL(!radix_heap_pop_min(heap, &item, &key) || item != 0 || key != 9,
+         "Radix heap did not pop item 0 at its decreased key")
+    FAIL(!radix_heap_pop_min(heap, &item, &key) || key != 40 || (item != 1 && item != 3) ||
+         !radix_heap_pop_min(heap, &item, &key) || key != 40 || (item != 1 && item != 3),
+         "Radix heap did not pop items 1 and 3 at key 40")
+    FAIL(radix_heap_pop_min(heap, &item, &key) || radix_heap_size(heap) != 0 || radix_heap_push(heap, 5, 50),
+         "Radix heap not empty, or took back a popped item")
+    FAIL(!radix_heap_clear(heap) || !radix_heap_push(heap, 5, 0) || !radix_heap_pop_min(heap, &item, NULL) ||
+         item != 5,
+         "Radix heap did not take item 5 back at key 0 after radix_heap_clear()")
+    radix_heap_delete(heap);
+
+    SUBTEST(radix_heap_matches_sort)
+    // A monotone workload like Dijkstra's: keys pushed and lowered are
+    // the last popped key plus a random amount, and every pop must be
+    // the smallest key in a plain array of the same items.
+    //
+    const unsigned int count = 5000;
+    unsigned int * keys = malloc(count * sizeof(unsigned int));
+    bool * queued = calloc(count, sizeof(bool));
+    unsigned int pushed = 0, last = 0;
+    struct rng rng;
+    rng_seed(&rng, 31);
+    heap = radix_heap_create(count);
+    for (unsigned int step = 0; step < 4 * count; step++) {
+        uint64_t choice = rng_bounded(&rng, 4);
+        unsigned int offset = (unsigned int)rng_bounded(&rng, rng_bounded(&rng, 2) ? 16 : 1u << 20);
+
+        if (choice <= 1 && pushed < count) {
+            keys[pushed] = last + offset;
+            queued[pushed] = true;
+            FAIL(!radix_heap_push(heap, pushed, last + offset),
+                 "radix_heap_push() failed")
+            pushed += 1;
+        } else if (choice == 2 && pushed != 0) {
+            unsigned int target = (unsigned int)rng_bounded(&rng, pushed);
+            if (queued[target] && last + offset < keys[target]) {
+                keys[target] = last + offset;
+                FAIL(!radix_heap_decrease_key(heap, target, last + offset),
+                     "radix_heap_decrease_key() failed")
+            }
+        } else {
+            unsigned int smallest = UINT32_MAX;
+            for (unsigned int i = 0; i < pushed; i++) {
+                if (queued[i] && keys[i] < smallest) {
+                    smallest = keys[i];
+                }
+            }
+            bool status = radix_heap_pop_min(heap, &item, &key);
+            FAIL(status != (smallest != UINT32_MAX),
+                 "radix_heap_pop_min() disagrees about the heap being empty")
+            if (status) {
+                FAIL(key != smallest || !queued[item] || keys[item] != key,
+                     "radix_heap_pop_min() did not pop a smallest key")
+                queued[item] = false;
+                last = key;
+            }
+        }
+    }
+    radix_heap_delete(heap);
+    free(queued);
+    free(keys);
+
+    PASS(check_radix_heap)
+}
+
+void check_bfs_dijkstra(void) {
+    TEST(check_bfs_dijkstra)
+    struct bfs_stats stats;
+
+    SUBTEST(bfs_dijkstra_small_graph)
+    // The direct edge 0 -> 2 weighs more than the detour through 1.
+    //
+    struct graph * graph = create_test_graph();
+    struct graph_weights * weights = graph_weights_create(graph, 5);
+    weights->weights[graph->offsets[0]] = 1;
+    weights->weights[graph->offsets[0] + 1] = 9;
+    bool status = bfs_dijkstra_path_exists(graph, weights, 4, 3, &stats);
+    FAIL(status != true || stats.distance != 16,
+         "Dijkstra did not find 4 -> 3 at weight 16 through 1")
+    status = bfs_dijkstra_path_exists(graph, weights, 1, 0, &stats);
+    FAIL(status != false || stats.distance != BFS_UNREACHABLE,
+         "Dijkstra found a path from 1 to 0")
+    status = bfs_dijkstra_path_exists(graph, weights, 7, 7, &stats);
+    FAIL(status != true || stats.distance != 0,
+         "Vertex 7 does not reach itself at weight 0")
+    graph_weights_delete(weights);
+    graph_delete(graph);
+
+    SUBTEST(bfs_dijkstra_matches_reference)
+    graph = create_random_graph(400, 1600, 41);
+    weights = graph_weights_create(graph, 1);
+    struct rng rng;
+    rng_seed(&rng, 42);
+    for (uint64_t e = 0; e < weights->edge_count; e++) {
+        weights->weights[e] = (unsigned int)rng_bounded(&rng, e % 2 ? 4 : 100000);
+    }
+    unsigned int * distances = malloc(graph->vertex_count * sizeof(unsigned int));
+    for (unsigned int source = 0; source < 40; source++) {
+        reference_distances(graph, weights, source, distances);
+        for (unsigned int target = 0; target < graph->vertex_count; target += 7) {
+            status = bfs_dijkstra_path_exists(graph, weights, source, target, &stats);
+            FAIL(status != (distances[target] != BFS_UNREACHABLE) || stats.distance != distances[target],
+                 "Dijkstra disagrees with the reference distances")
+        }
+    }
+    free(distances);
+    graph_weights_delete(weights);
+    graph_delete(graph);
+
+    PASS(check_bfs_dijkstra)
+}
+
+void check_graph_analytics(void) {
+    TEST(check_graph_analytics)
+    struct graph * graph = create_test_graph();
+    struct graph_analytics_stats stats;
+    unsigned int labels[8];
+
+    SUBTEST(graph_analytics_wcc_small_graph)
+    const unsigned int expected_labels[] = {0, 0, 0, 0, 0, 5, 5, 7};
+    bool status = graph_analytics_wcc(graph, 3, labels, &stats);
+    FAIL(status != true || stats.count != 3 || stats.threads != 3,
+         "WCC did not find 3 components with 3 threads")
+    FAIL(memcmp(labels, expected_labels, sizeof(labels)) != 0,
+         "WCC labels are not the smallest vertex of each component")
+
+    SUBTEST(graph_analytics_k_hop_small_graph)
+    const unsigned int seeds[] = {4, 4};
+    const unsigned int expected_distances[] = {
+        1, 2, 2, BFS_UNREACHABLE, 0, BFS_UNREACHABLE, BFS_UNREACHABLE, BFS_UNREACHABLE
+    };
+    status = graph_analytics_k_hop(graph, 2, seeds, 2, 2, labels, &stats);
+    FAIL(status != true || stats.count != 4 || stats.levels != 2,
+         "k-hop from 4 did not reach 4 vertices in 2 levels")
+    FAIL(memcmp(labels, expected_distances, sizeof(labels)) != 0,
+         "k-hop distances from 4 are wrong")
+    const unsigned int bad_seed[] = {8};
+    status = graph_analytics_k_hop(graph, 2, bad_seed, 1, 2, labels, NULL);
+    FAIL(status != false,
+         "graph_analytics_k_hop() accepted an out of range seed")
+    graph_delete(graph);
+
+    SUBTEST(graph_analytics_wcc_matches_serial)
+    graph = create_random_graph(20000, 12000, 11);
+    unsigned int * parallel = malloc((graph->vertex_count + 1) * sizeof(unsigned int));
+    unsigned int * serial = malloc(graph->vertex_count * sizeof(unsigned int));
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        serial[v] = v;
+    }
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        for (uint64_t e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+            unsigned int a = find_root(serial, v);
+            unsigned int b = find_root(serial, graph->neighbors[e]);
+            serial[a > b ? a : b] = a > b ? b : a;
+        }
+    }
+    uint64_t components = 0;
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        serial[v] = find_root(serial, v);
+        components += (serial[v] == v);
+    }
+    status = graph_analytics_wcc(graph, 4, parallel, &stats);
+    FAIL(status != true || stats.count != components,
+         "WCC found a different number of components than serial union-find")
+    FAIL(memcmp(parallel, serial, graph->vertex_count * sizeof(unsigned int)) != 0,
+         "WCC labels disagree with serial union-find")
+
+    SUBTEST(graph_analytics_k_hop_matches_serial)
+    struct bfs_workspace * workspace = bfs_workspace_create(graph->vertex_count);
+    unsigned int random_seeds[5];
+    struct rng rng;
+    rng_seed(&rng, 12);
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        serial[v] = BFS_UNREACHABLE;
+    }
+    for (size_t s = 0; s < 5; s++) {
+        random_seeds[s] = (unsigned int)rng_bounded(&rng, graph->vertex_count);
+        bfs_workspace_distances(workspace, graph, random_seeds[s], parallel, NULL);
+        for (unsigned int v = 0; v < graph->vertex_count; v++) {
+            if (parallel[v] <= 4 && parallel[v] < serial[v]) {
+                serial[v] = parallel[v];
+            }
+        }
+    }
+    status = graph_analytics_k_hop(graph, 4, random_seeds, 5, 4, parallel, &stats);
+    FAIL(status != true,
+         "graph_analytics_k_hop() failed")
+    FAIL(memcmp(parallel, serial, graph->vertex_count * sizeof(unsigned int)) != 0,
+         "k-hop distances disagree with serial BFS")
+    bfs_workspace_delete(workspace);
+
+    SUBTEST(graph_analytics_map_output)
+    unsigned int * mapped = graph_analytics_map_output(TEST_GRAPH_PATH, graph->vertex_count);
+    FAIL(mapped == NULL,
+         "graph_analytics_map_output() failed")
+    status = graph_analytics_k_hop(graph, 2, random_seeds, 5, 4, mapped, NULL);
+    FAIL(status != true || !graph_analytics_unmap_output(mapped, graph->vertex_count),
+         "k-hop into a mapped file failed")
+    FILE * in = fopen(TEST_GRAPH_PATH, "rb");
+    size_t entries = fread(parallel, sizeof(unsigned int), graph->vertex_count + 1, in);
+    fclose(in);
+    remove(TEST_GRAPH_PATH);
+    FAIL(entries != graph->vertex_count ||
+         memcmp(parallel, serial, graph->vertex_count * sizeof(unsigned int)) != 0,
+         "Mapped output file does not hold the distances")
+    free(parallel);
+    free(serial);
+    graph_delete(graph);
+
+    PASS(check_graph_analytics)
+}
+
+int main(void) {
+    signal(SIGALRM, gracefully_exit_on_suspected_infinite_loop);
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+    queue_register_malloc(&malloc);
+    queue_register_free(&free);
+
+    check_graph_construction();
+    check_matrix_market_loading();
+    check_binary_cache();
+    check_graph_reorder();
+    check_graph_compressed();
+    check_graph_scc();
+    check_graph_landmarks();
+    check_bfs_path_exists();
+    check_bfs_workspace();
+    check_bfs_cache();
+    check_bfs_parallel();
+    check_bfs_partitioned();
+    check_bfs_direction_optimizing();
+    check_bfs_bidirectional();
+    check_bfs_adaptive_frontier();
+    check_bfs_multi_source();
+    check_bfs_0_1();
+    check_radix_heap();
+    check_bfs_dijkstra();
+    check_graph_analytics();
+
+    linked_list_final_cleanup();
+
+    return 0;
+}
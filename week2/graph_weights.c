@@ -0,0 +1,232 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "graph_weights.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// Allocates weights for a graph, every entry set to weight.
+static struct graph_weights * __graph_weights_alloc(const struct graph * graph, unsigned int weight) {
+    struct graph_weights * weights = (struct graph_weights *)calloc(1, sizeof(struct graph_weights));
+
+    if (weights == NULL) {
+        return NULL;
+    }
+
+    weights->edge_count = graph->edge_count;
+    weights->max_weight = weight;
+    weights->weights = (unsigned int *)malloc((graph->edge_count == 0 ? 1 : graph->edge_count) *
+                                              sizeof(unsigned int));
+
+    if (weights->weights == NULL) {
+        free(weights);
+        return NULL;
+    }
+
+    for (uint64_t e = 0; e < graph->edge_count; e++) {
+        weights->weights[e] = weight;
+    }
+
+    return weights;
+}
+
+// Returns the index of the first edge from source to target, UINT64_MAX
+// if there is none. Neighbor lists are sorted, so parallel edges follow
+// it.
+static uint64_t __graph_weights_find_edge(const struct graph * graph, unsigned int source, unsigned int target) {
+    uint64_t low = graph->offsets[source];
+    uint64_t high = graph->offsets[source + 1];
+
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+
+        if (graph->neighbors[middle] < target) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return (low < graph->offsets[source + 1] && graph->neighbors[low] == target) ? low : UINT64_MAX;
+}
+
+// Weighs the first unweighed edge from source to target, if there is
+// one.
+static void __graph_weights_set(struct graph_weights * weights, const struct graph * graph,
+                                unsigned int source, unsigned int target, unsigned int weight) {
+    uint64_t e = __graph_weights_find_edge(graph, source, target);
+
+    if (e == UINT64_MAX) {
+        return;
+    }
+
+    for (; e < graph->offsets[source + 1] && graph->neighbors[e] == target; e++) {
+        if (weights->weights[e] == UINT32_MAX) {
+            weights->weights[e] = weight;
+            return;
+        }
+    }
+}
+
+// Gives every edge of a graph the same weight.
+struct graph_weights * graph_weights_create(const struct graph * graph, unsigned int weight) {
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    return __graph_weights_alloc(graph, weight);
+}
+
+// Reads edge weights from the values of a Matrix Market file.
+struct graph_weights * graph_weights_load(const char * path, const struct graph * graph) {
+
+    if (path == NULL || graph == NULL) {
+        return NULL;
+    }
+
+    FILE * in = fopen(path, "r");
+    char * line = NULL;
+    size_t line_capacity = 0;
+    struct graph_weights * weights = NULL;
+    char object[32], format[32], field[32], symmetry[32];
+    bool ok = false;
+
+    if (in == NULL) {
+        perror(path);
+        return NULL;
+    }
+
+    if (getline(&line, &line_capacity, in) == -1 ||
+        sscanf(line, "%%%%MatrixMarket %31s %31s %31s %31s", object, format, field, symmetry) != 4 ||
+        strcasecmp(object, "matrix") != 0 || strcasecmp(format, "coordinate") != 0) {
+        fprintf(stderr, "%s: not a Matrix Market coordinate file\n", path);
+        goto out;
+    }
+
+    bool symmetric = strcasecmp(symmetry, "general") != 0;
+    bool pattern = strcasecmp(field, "pattern") == 0;
+
+    if (!pattern && strcasecmp(field, "integer") != 0) {
+        fprintf(stderr, "%s: weights must be integers, not %s\n", path, field);
+        goto out;
+    }
+
+    unsigned long long rows = 0, cols = 0, entries = 0;
+    while (getline(&line, &line_capacity, in) != -1) {
+        if (line[0] != '%') {
+            break;
+        }
+    }
+
+    if (sscanf(line, "%llu %llu %llu", &rows, &cols, &entries) != 3 ||
+        rows > graph->vertex_count || cols > graph->vertex_count) {
+        fprintf(stderr, "%s: bad size line for a graph of %u vertices\n", path, graph->vertex_count);
+        goto out;
+    }
+
+    // Edges not weighed yet hold UINT32_MAX, so that the missing ones
+    // can be found afterwards.
+    //
+    weights = __graph_weights_alloc(graph, UINT32_MAX);
+    if (weights == NULL) {
+        fprintf(stderr, "%s: out of memory\n", path);
+        goto out;
+    }
+
+    for (unsigned long long i = 0; i < entries; i++) {
+        char * end = NULL;
+
+        if (getline(&line, &line_capacity, in) == -1) {
+            fprintf(stderr, "%s: expected %llu entries, found %llu\n", path, entries, i);
+            goto out;
+        }
+
+        unsigned long long row = strtoull(line, &end, 10);
+        unsigned long long col = strtoull(end, &end, 10);
+        unsigned long long weight = pattern ? 1 : strtoull(end, NULL, 10);
+
+        if (row == 0 || col == 0 || row > rows || col > cols || weight >= UINT32_MAX) {
+            fprintf(stderr, "%s: entry %llu out of range\n", path, i + 1);
+            goto out;
+        }
+
+        unsigned int source = graph_vertex_id(graph, (unsigned int)(row - 1));
+        unsigned int target = graph_vertex_id(graph, (unsigned int)(col - 1));
+
+        __graph_weights_set(weights, graph, source, target, (unsigned int)weight);
+        if (symmetric && source != target) {
+            __graph_weights_set(weights, graph, target, source, (unsigned int)weight);
+        }
+    }
+
+    weights->max_weight = 0;
+    for (uint64_t e = 0; e < weights->edge_count; e++) {
+        if (weights->weights[e] == UINT32_MAX) {
+            fprintf(stderr, "%s: no weight for edge %llu of the graph\n", path, (unsigned long long)e);
+            goto out;
+        }
+
+        if (weights->weights[e] > weights->max_weight) {
+            weights->max_weight = weights->weights[e];
+        }
+    }
+
+    ok = true;
+
+out:
+    free(line);
+    fclose(in);
+
+    if (!ok) {
+        graph_weights_delete(weights);
+        return NULL;
+    }
+
+    return weights;
+}
+
+// Returns the size of the weights in bytes.
+uint64_t graph_weights_bytes(const struct graph_weights * weights) {
+
+    if (weights == NULL) {
+        return 0;
+    }
+
+    return sizeof(struct graph_weights) + weights->edge_count * sizeof(unsigned int);
+}
+
+// Frees edge weights.
+void graph_weights_delete(struct graph_weights * weights) {
+
+    if (weights == NULL) {
+        return;
+    }
+
+    free(weights->weights);
+    free(weights);
+}
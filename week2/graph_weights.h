@@ -0,0 +1,82 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _GRAPH_WEIGHTS_H
+#define _GRAPH_WEIGHTS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph.h"
+
+// Edge weights for a graph, kept beside it rather than in struct graph:
+// the loaders, the binary cache and the reordering all stay unweighted,
+// and only the searches that need weights pay for them. weights[e] is
+// the weight of the edge stored at neighbors[e], so the array follows
+// whatever order the graph is in.
+//
+// Weights come from the values of a Matrix Market "integer" file (see
+// graph_generator -w), matched to the CSR edges of the graph loaded
+// from the same file.
+//
+struct graph_weights {
+    uint64_t edge_count;
+    unsigned int max_weight;
+    unsigned int * weights;
+};
+
+// Gives every edge of a graph the same weight.
+// \param graph  : Pointer to graph.
+// \param weight : Weight of every edge.
+// Returns new weights on success, NULL on failure.
+//
+struct graph_weights * graph_weights_create(const struct graph * graph, unsigned int weight);
+
+// Reads the weights of a graph's edges from a Matrix Market coordinate
+// file: entry (i, j, w) weighs the edge from vertex i - 1 to vertex
+// j - 1, in the graph's original IDs (and, in a symmetric file, the
+// edge back). Entries of a pattern file weigh 1. Like the loader, which
+// keeps duplicate entries as parallel edges, each entry weighs one edge:
+// parallel edges take the weights of their entries in turn. Entries
+// left with no edge to weigh are ignored.
+// \param path  : Path to a .mtx file, normally the one graph was loaded
+//                from.
+// \param graph : Pointer to graph.
+// Returns new weights on success, NULL on failure, including an edge of
+// the graph with no entry (a message is printed to stderr).
+//
+struct graph_weights * graph_weights_load(const char * path, const struct graph * graph);
+
+// Returns the size of the weights in bytes.
+// \param weights : Pointer to weights.
+//
+uint64_t graph_weights_bytes(const struct graph_weights * weights);
+
+// Frees edge weights.
+// \param weights : Weights to free, may be NULL.
+//
+void graph_weights_delete(struct graph_weights * weights);
+
+#endif
@@ -0,0 +1,384 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "linked_list.h"
+#include "perf_counters.h"
+#include "rng.h"
+
+// Pointer-chasing benchmark: builds lists with identical logical content
+// (0 .. size - 1, in order) but with nodes placed in memory in different
+// ways, then measures iteration and find throughput for each placement.
+//
+//  sequential  : plain linked_list_insert_end() on a fresh node pool.
+//  interleaved : the same inserts randomly interleaved with inserts into
+//                and removals from decoy lists, so live nodes are mixed
+//                with short-lived ones and recycled free_nodes.
+//  fragmented  : the node pool is churned first (nodes allocated into
+//                random buckets and released bucket by bucket, several
+//                times), then the list is built from the scrambled pool.
+//
+// Besides timings and hardware counters, each record carries two layout
+// counters computed by walking the list: the fraction of nodes whose
+// successor starts within one cache line, and the mean distance in bytes
+// between consecutive nodes.
+//
+// Usage: layout_benchmark [-s size,...] [-r repetitions] [-S seed] [-f text|json] [-o file]
+
+#define MAX_SIZES 16
+#define FIND_QUERIES 16
+#define DECOY_LISTS 8
+#define CHURN_BUCKETS 256
+#define CHURN_ROUNDS 4
+#define CACHE_LINE_BYTES 64
+
+struct layout_options {
+    size_t sizes[MAX_SIZES];
+    size_t size_count;
+    size_t repetitions;
+    uint64_t seed;
+    enum bench_format format;
+    FILE * out;
+};
+
+enum layout_strategy {
+    LAYOUT_SEQUENTIAL,
+    LAYOUT_INTERLEAVED,
+    LAYOUT_FRAGMENTED,
+    LAYOUT_MAX
+};
+
+static const char * layout_names[LAYOUT_MAX] = {
+    "sequential",
+    "interleaved",
+    "fragmented"
+};
+
+static struct linked_list * build_sequential(size_t size) {
+    struct linked_list * ll = linked_list_create();
+
+    for (size_t i = 0; i < size; i++) {
+        linked_list_insert_end(ll, (unsigned int)i);
+    }
+
+    return ll;
+}
+
+static struct linked_list * build_interleaved(size_t size, struct rng * rng) {
+    struct linked_list * decoys[DECOY_LISTS];
+    struct linked_list * ll = linked_list_create();
+
+    for (size_t d = 0; d < DECOY_LISTS; d++) {
+        decoys[d] = linked_list_create();
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        linked_list_insert_end(ll, (unsigned int)i);
+
+        // Between every real insert, a random amount of decoy traffic.
+        //
+        uint64_t ops = rng_bounded(rng, 4);
+        for (uint64_t op = 0; op < ops; op++) {
+            struct linked_list * decoy = decoys[rng_bounded(rng, DECOY_LISTS)];
+
+            if (rng_bounded(rng, 2) == 0 || linked_list_size(decoy) == 0) {
+                linked_list_insert_front(decoy, (unsigned int)i);
+            } else {
+                linked_list_remove(decoy, 0);
+            }
+        }
+    }
+
+    for (size_t d = 0; d < DECOY_LISTS; d++) {
+        linked_list_delete(decoys[d]);
+    }
+
+    return ll;
+}
+
+// Scrambles the order of the free list by allocating size nodes into
+// random buckets and releasing the buckets one at a time.
+static void churn_pool(size_t size, struct rng * rng) {
+    struct linked_list * buckets[CHURN_BUCKETS];
+
+    for (size_t round = 0; round < CHURN_ROUNDS; round++) {
+        for (size_t b = 0; b < CHURN_BUCKETS; b++) {
+            buckets[b] = linked_list_create();
+        }
+
+        for (size_t i = 0; i < size; i++) {
+            linked_list_insert_front(buckets[rng_bounded(rng, CHURN_BUCKETS)], (unsigned int)i);
+        }
+
+        // Release in a random bucket order.
+        //
+        for (size_t b = CHURN_BUCKETS; b > 1; b--) {
+            size_t j = rng_bounded(rng, b);
+            struct linked_list * tmp = buckets[b - 1];
+            buckets[b - 1] = buckets[j];
+            buckets[j] = tmp;
+        }
+        for (size_t b = 0; b < CHURN_BUCKETS; b++) {
+            linked_list_delete(buckets[b]);
+        }
+    }
+}
+
+static struct linked_list * build_list(enum layout_strategy strategy,
+                                       size_t size,
+                                       struct rng * rng) {
+    switch (strategy) {
+    case LAYOUT_INTERLEAVED:
+        return build_interleaved(size, rng);
+    case LAYOUT_FRAGMENTED:
+        churn_pool(size, rng);
+        return build_sequential(size);
+    default:
+        return build_sequential(size);
+    }
+}
+
+// Walks the list and computes the layout counters.
+static void layout_statistics(struct linked_list * ll,
+                              double * near_fraction,
+                              double * mean_stride) {
+    size_t near = 0;
+    size_t pairs = 0;
+    double total_stride = 0.0;
+
+    for (struct node * n = ll->head; n != NULL && n->next != NULL; n = n->next) {
+        intptr_t stride = (intptr_t)n->next - (intptr_t)n;
+        intptr_t distance = stride < 0 ? -stride : stride;
+
+        near += (distance <= CACHE_LINE_BYTES);
+        total_stride += (double)distance;
+        pairs += 1;
+    }
+
+    *near_fraction = (pairs == 0) ? 0.0 : (double)near / (double)pairs;
+    *mean_stride = (pairs == 0) ? 0.0 : total_stride / (double)pairs;
+}
+
+// Times one operation over all repetitions and emits its record.
+static void report(const struct layout_options * opts,
+                   struct perf_counters * pc,
+                   struct bench_samples * samples,
+                   uint64_t * counter_totals,
+                   size_t operations,
+                   const char * operation,
+                   size_t size,
+                   double near_fraction,
+                   double mean_stride) {
+    struct bench_record record;
+    bench_record_init(&record, "layout", operation, size);
+    bench_samples_summarize(samples, &record.summary);
+
+    memcpy(pc->values, counter_totals, sizeof(pc->values));
+    perf_counters_add_to_record(pc, &record, operations);
+    bench_record_add_counter(&record, "near_successor_fraction", near_fraction);
+    bench_record_add_counter(&record, "mean_stride_bytes", mean_stride);
+    bench_record_emit(opts->out, opts->format, &record);
+    bench_samples_reset(samples);
+}
+
+static void benchmark_layout(const struct layout_options * opts,
+                             struct perf_counters * pc,
+                             struct bench_samples * samples,
+                             enum layout_strategy strategy,
+                             size_t size) {
+    struct rng rng;
+    uint64_t counter_totals[PERF_COUNTER_MAX];
+    char operation[64];
+    volatile unsigned int sink = 0;
+
+    // Start every placement from an empty node pool so that they do
+    // not inherit each other's free list.
+    //
+    linked_list_final_cleanup();
+    rng_seed(&rng, opts->seed);
+
+    struct linked_list * ll = build_list(strategy, size, &rng);
+    double near_fraction = 0.0;
+    double mean_stride = 0.0;
+    layout_statistics(ll, &near_fraction, &mean_stride);
+
+    // Iteration, per node visited.
+    //
+    memset(counter_totals, 0, sizeof(counter_totals));
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        struct iterator * iter = linked_list_create_iterator(ll, 0);
+        unsigned int sum = 0;
+
+        perf_counters_start(pc);
+        uint64_t start = bench_now_ns();
+        do {
+            sum += iter->data;
+        } while (linked_list_iterate(iter));
+        uint64_t elapsed = bench_now_ns() - start;
+        perf_counters_stop(pc);
+
+        for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+            counter_totals[id] += pc->values[id];
+        }
+        bench_samples_add(samples, (double)elapsed / (double)size);
+        sink += sum;
+        linked_list_delete_iterator(iter);
+    }
+    snprintf(operation, sizeof(operation), "linked_list_iterate.%s", layout_names[strategy]);
+    report(opts, pc, samples, counter_totals, size * opts->repetitions,
+           operation, size, near_fraction, mean_stride);
+
+    // Find, per node scanned.
+    //
+    size_t scanned = 0;
+    for (size_t q = 0; q < FIND_QUERIES; q++) {
+        scanned += ((q * size) / FIND_QUERIES) + 1;
+    }
+
+    memset(counter_totals, 0, sizeof(counter_totals));
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        size_t found = 0;
+
+        perf_counters_start(pc);
+        uint64_t start = bench_now_ns();
+        for (size_t q = 0; q < FIND_QUERIES; q++) {
+            found += linked_list_find(ll, (unsigned int)((q * size) / FIND_QUERIES));
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+        perf_counters_stop(pc);
+
+        for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+            counter_totals[id] += pc->values[id];
+        }
+        bench_samples_add(samples, (double)elapsed / (double)scanned);
+        sink += (unsigned int)found;
+    }
+    snprintf(operation, sizeof(operation), "linked_list_find.%s", layout_names[strategy]);
+    report(opts, pc, samples, counter_totals, scanned * opts->repetitions,
+           operation, size, near_fraction, mean_stride);
+
+    (void)sink;
+    linked_list_delete(ll);
+}
+
+// Parses a comma separated list of sizes.
+static bool parse_sizes(const char * arg, struct layout_options * opts) {
+    char * end = NULL;
+    opts->size_count = 0;
+
+    while (*arg != '\0' && opts->size_count < MAX_SIZES) {
+        unsigned long long value = strtoull(arg, &end, 10);
+
+        if (end == arg || value == 0) {
+            return false;
+        }
+
+        opts->sizes[opts->size_count] = (size_t)value;
+        opts->size_count += 1;
+        arg = (*end == ',') ? end + 1 : end;
+    }
+
+    return opts->size_count != 0;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s [-s size,size,...] [-r repetitions] [-S seed] "
+                    "[-f text|json] [-o file]\n", program);
+}
+
+int main(int argc, char ** argv) {
+    struct layout_options opts = {
+        .sizes = {10000, 1000000},
+        .size_count = 2,
+        .repetitions = 10,
+        .seed = 1,
+        .format = BENCH_FORMAT_TEXT,
+        .out = stdout
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:r:S:f:o:h")) != -1) {
+        switch (opt) {
+        case 's':
+            if (!parse_sizes(optarg, &opts)) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'r':
+            opts.repetitions = strtoull(optarg, NULL, 10);
+            break;
+        case 'S':
+            opts.seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'f':
+            opts.format = (strcmp(optarg, "json") == 0) ? BENCH_FORMAT_JSON : BENCH_FORMAT_TEXT;
+            break;
+        case 'o':
+            opts.out = fopen(optarg, "w");
+            if (opts.out == NULL) {
+                perror(optarg);
+                return 2;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (opts.repetitions == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+
+    struct perf_counters pc;
+    struct bench_samples samples;
+    perf_counters_open(&pc);
+    bench_samples_init(&samples, opts.repetitions);
+
+    for (size_t i = 0; i < opts.size_count; i++) {
+        for (int strategy = 0; strategy < LAYOUT_MAX; strategy++) {
+            benchmark_layout(&opts, &pc, &samples, (enum layout_strategy)strategy, opts.sizes[i]);
+        }
+    }
+
+    perf_counters_close(&pc);
+    bench_samples_free(&samples);
+    linked_list_final_cleanup();
+
+    if (opts.out != stdout) {
+        fclose(opts.out);
+    }
+
+    return 0;
+}
@@ -35,79 +35,46 @@ static struct control_list c_list = {.head = NULL};
 // Returns a struct node pointer from a free list of pointers
 static struct node * __linked_list_create_node() {
     if (f_list.head == NULL){
+        // Every free_node is handed out, so allocate another block of them
+        // and remember the block in the control list for final cleanup.
         struct free_node *f = (struct free_node *)malloc_fptr(NUMBER_OF_NODES_TO_ALLOC * sizeof(struct free_node));
         struct control_node *c = (struct control_node *)malloc_fptr(sizeof(struct control_node));
-        c->f = f;
-        c->next = NULL;
-        c_list.head = c;
-
-        struct free_node *curr = NULL;
-
-        for (int i = 0; i<NUMBER_OF_NODES_TO_ALLOC; i++) {
-            if (i == 0) {
-                f_list.head = &f[i];
-                curr = f_list.head;
-                curr->node_ptr = NULL;
-                continue;
-            }
-
-            curr->next = &f[i];
-            curr = curr->next;
-            curr->node_ptr = NULL;
-        }
-
-        f_list.size += NUMBER_OF_NODES_TO_ALLOC;
-        f_list.allocated += 1;
-        struct free_node *next_node = f_list.head->next;
-        struct free_node *to_return = f_list.head;
 
-        if (to_return->node_ptr == NULL) {
-            to_return->node_ptr = (struct node*)malloc_fptr(sizeof(struct node));
-        }
-        
-        f_list.head = next_node;
-        if(f_list.removed == NULL) {
-            f_list.removed = to_return;
+        if (f == NULL || c == NULL) {
+            free_fptr(f);
+            free_fptr(c);
+            return NULL;
         }
-        return to_return->node_ptr;
-
-    } else if (f_list.allocated == f_list.size) {
-
-        struct free_node *f = (struct free_node *)malloc_fptr(NUMBER_OF_NODES_TO_ALLOC * sizeof(struct free_node));
-        f_list.size += NUMBER_OF_NODES_TO_ALLOC;
 
-        struct control_node *c = (struct control_node *)malloc_fptr(sizeof(struct control_node));
-        struct control_node *curr_head = c_list.head;
         c->f = f;
-        c->next = curr_head;
+        c->next = c_list.head;
         c_list.head = c;
 
         for (int i = 0; i<NUMBER_OF_NODES_TO_ALLOC; i++) {
-            
-            struct free_node *new_head = &f[i];
-            new_head->next = f_list.head;
-            new_head->node_ptr = NULL;
-            f_list.head = new_head;
+            f[i].node_ptr = NULL;
+            f[i].next = (i + 1 < NUMBER_OF_NODES_TO_ALLOC) ? &f[i + 1] : NULL;
         }
+
+        f_list.head = &f[0];
+        f_list.size += NUMBER_OF_NODES_TO_ALLOC;
     }
 
-    f_list.allocated += 1;
-    struct free_node *next_node = f_list.head->next;
     struct free_node *to_return = f_list.head;
 
     if (to_return->node_ptr == NULL) {
         to_return->node_ptr = (struct node*)malloc_fptr(sizeof(struct node));
-    }
 
-    if (f_list.removed != NULL){
-        struct free_node *curr_first = f_list.removed;
-        to_return->next = curr_first;
-        f_list.removed = to_return;
-    } else {
-        f_list.removed = to_return;
+        if (to_return->node_ptr == NULL) {
+            return NULL;
+        }
     }
-    
-    f_list.head = next_node;
+
+    f_list.head = to_return->next;
+    f_list.allocated += 1;
+
+    to_return->next = f_list.removed;
+    f_list.removed = to_return;
+
     return to_return->node_ptr;
 }
 
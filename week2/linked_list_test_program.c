@@ -477,6 +477,173 @@ void check_insertion_functionality(void) {
 #endif
 }
 
+void check_queue_visited_functionality(void) {
+#ifdef TEST_QUEUE
+    TEST(check_queue_visited_functionality)
+    unsigned int data = 0;
+
+    SUBTEST(queue_push_if_new)
+    struct queue * queue = queue_create_with_visited(130);
+    FAIL(queue == NULL,
+         "Failed to create new queue with a visited bitmap.")
+    bool status = queue_push_if_new(queue, 7);
+    FAIL(status == false,
+         "queue_push_if_new() did not push a new value")
+    status = queue_push_if_new(queue, 7);
+    FAIL(status == true,
+         "queue_push_if_new() pushed a value twice")
+    status = queue_push_if_new(queue, 130);
+    FAIL(status == true,
+         "queue_push_if_new() pushed an out of range value")
+    FAIL(queue_size(queue) != 1 || !queue_visited(queue, 7) || queue_visited(queue, 8),
+         "Queue size or visited bits wrong after queue_push_if_new()")
+
+    SUBTEST(queue_push_if_new_bulk)
+    // Duplicates, an already visited value, three bitmap words and an
+    // out of range value.
+    //
+    const unsigned int values[] = {3, 7, 7, 63, 64, 100, 129, 129, 130, 2};
+    size_t pushed = queue_push_if_new_bulk(queue, values, sizeof(values) / sizeof(values[0]));
+    FAIL(pushed != 6,
+         "queue_push_if_new_bulk() did not push exactly the new values")
+    const unsigned int expected[] = {7, 3, 63, 64, 100, 129, 2};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        status = queue_pop(queue, &data);
+        FAIL(status == false || data != expected[i],
+             "queue_push_if_new_bulk() pushed the wrong values or order")
+    }
+    FAIL(queue_has_next(queue),
+         "queue_push_if_new_bulk() pushed too many values")
+
+    SUBTEST(queue_push_if_new_word)
+    pushed = queue_push_if_new_word(queue, 2, ~0ull);
+    FAIL(pushed != 1,
+         "queue_push_if_new_word() pushed past the end of the value space")
+    status = queue_pop(queue, &data);
+    FAIL(status == false || data != 128,
+         "queue_push_if_new_word() pushed the wrong value")
+    pushed = queue_push_if_new_word(queue, 3, 1);
+    FAIL(pushed != SIZE_MAX,
+         "queue_push_if_new_word() accepted an out of range word")
+
+    SUBTEST(queue_clear_visited)
+    status = queue_clear_visited(queue);
+    FAIL(status == false || queue_visited(queue, 7) || queue_visited(queue, 128),
+         "queue_clear_visited() did not clear the bitmap")
+    status = queue_push_if_new(queue, 7);
+    FAIL(status == false,
+         "queue_push_if_new() did not push after queue_clear_visited()")
+
+    SUBTEST(queue_mark_visited)
+    status = queue_mark_visited(queue, 9);
+    FAIL(status == false || !queue_visited(queue, 9) || queue_size(queue) != 1,
+         "queue_mark_visited() did not mark without pushing")
+    FAIL(queue_mark_visited(queue, 9) || queue_mark_visited(queue, 7) || queue_mark_visited(queue, 130),
+         "queue_mark_visited() marked a visited or out of range value")
+    status = queue_push_if_new(queue, 9);
+    FAIL(status == true,
+         "queue_push_if_new() pushed a marked value")
+    status = queue_delete(queue);
+    FAIL(status == false,
+         "Failed to delete queue");
+
+    SUBTEST(plain_queue_has_no_visited)
+    queue = queue_create();
+    status = queue_push_if_new(queue, 1);
+    FAIL(status == true || queue_size(queue) != 0,
+         "queue_push_if_new() pushed onto a queue without a bitmap")
+    FAIL(queue_push_if_new_bulk(queue, values, 1) != SIZE_MAX || queue_clear_visited(queue),
+         "Visited operations did not fail on a queue without a bitmap")
+    queue_delete(queue);
+
+    SUBTEST(queue_create_with_visited_malloc_failure)
+    instrumented_malloc_fail_next = true;
+    queue = queue_create_with_visited(64);
+    FAIL(queue != NULL,
+         "queue_create_with_visited() did not fail when malloc() failed")
+
+    PASS(check_queue_visited_functionality)
+#endif
+}
+
+void check_deque_functionality(void) {
+#ifdef TEST_QUEUE
+    TEST(check_deque_functionality)
+    unsigned int data = 0;
+
+    SUBTEST(deque_null_and_empty)
+    FAIL(deque_push_back(NULL, 1) || deque_push_front(NULL, 1) || deque_pop_front(NULL, &data) ||
+         deque_pop_back(NULL, &data) || deque_size(NULL) != SIZE_MAX || deque_delete(NULL),
+         "Deque functions did not fail on a NULL deque")
+    struct deque * deque = deque_create();
+    FAIL(deque == NULL,
+         "Failed to create new deque.")
+    FAIL(deque_size(deque) != 0 || deque_pop_front(deque, &data) || deque_pop_back(deque, &data) ||
+         deque_peek_front(deque, &data) || deque_peek_back(deque, &data),
+         "Empty deque has a size or popped a value")
+
+    SUBTEST(deque_both_ends)
+    // 3 2 1 | 4 5 6 after pushing 1 to 3 at the front and 4 to 6 at the
+    // back.
+    //
+    for (unsigned int i = 1; i <= 3; i++) {
+        FAIL(!deque_push_front(deque, i) || !deque_push_back(deque, i + 3),
+             "Failed to push onto deque.")
+    }
+    FAIL(!deque_peek_front(deque, &data) || data != 3 || !deque_peek_back(deque, &data) || data != 6,
+         "Deque peeks did not return 3 and 6")
+    const unsigned int expected[] = {3, 6, 2, 5, 1, 4};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        bool status = (i % 2 == 0) ? deque_pop_front(deque, &data) : deque_pop_back(deque, &data);
+        FAIL(status == false || data != expected[i],
+             "Deque popped the wrong value from alternating ends")
+    }
+    FAIL(deque_size(deque) != 0,
+         "Deque not empty after popping every value")
+
+    SUBTEST(deque_grows_while_wrapped)
+    // Pushing at the front wraps the ring at once, so growing has to
+    // unwrap it.
+    //
+    for (unsigned int i = 0; i < 1000; i++) {
+        bool status = (i % 3 == 0) ? deque_push_back(deque, i) : deque_push_front(deque, i);
+        FAIL(status == false,
+             "Failed to push onto a growing deque.")
+    }
+    FAIL(deque_size(deque) != 1000,
+         "Deque size is not 1000")
+    for (unsigned int i = 999; i < 1000; i--) {
+        if (i % 3 != 0) {
+            FAIL(!deque_pop_front(deque, &data) || data != i,
+                 "Deque front did not pop in reverse push order")
+        }
+    }
+    for (unsigned int i = 999; i < 1000; i--) {
+        if (i % 3 == 0) {
+            FAIL(!deque_pop_back(deque, &data) || data != i,
+                 "Deque back did not pop in reverse push order")
+        }
+    }
+    FAIL(deque_size(deque) != 0,
+         "Deque not empty after popping every value")
+
+    SUBTEST(deque_clear)
+    deque_push_back(deque, 1);
+    FAIL(!deque_clear(deque) || deque_size(deque) != 0 || deque_pop_front(deque, &data),
+         "deque_clear() did not empty the deque")
+    FAIL(deque_delete(deque) == false,
+         "Failed to delete deque")
+
+    SUBTEST(deque_malloc_failure)
+    instrumented_malloc_fail_next = true;
+    deque = deque_create();
+    FAIL(deque != NULL,
+         "deque_create() did not fail when malloc() failed")
+
+    PASS(check_deque_functionality)
+#endif
+}
+
 void check_linked_list_find_functionality(void) {
 #ifdef TEST_LINKED_LIST
     TEST(check_linked_list_find_functionality)
@@ -554,6 +721,47 @@ void check_linked_list_additional_delete_tests(void) {
     FAIL(status == false,
          "Failed to delete non-empty linked_list.")
 
+    SUBTEST(node_pool_refills)
+    // Enough live nodes that the pool has to allocate more than two
+    // blocks, every one of which final cleanup has to free.
+    //
+    size_t count = 2 * NUMBER_OF_NODES_TO_ALLOC + 1;
+    ll = linked_list_create();
+    for (size_t i = 0; i < count; i++) {
+        status = linked_list_insert_end(ll, i);
+        FAIL(status == false,
+             "linked_list_insert_end() failed past the first node block.")
+    }
+    FAIL(linked_list_size(ll) != count,
+         "Linked list size does not match the number of nodes inserted.")
+
+    struct iterator * iter = linked_list_create_iterator(ll, 0);
+    FAIL(iter == NULL,
+         "linked_list_create_iterator() failed.")
+    size_t visited = 1;
+    FAIL(iter->data != 0,
+         "Iterator does not start at the first node.")
+    while (linked_list_iterate(iter)) {
+        FAIL(iter->data != visited,
+             "Iterator returned nodes out of order.")
+        visited++;
+    }
+    FAIL(visited != count,
+         "Iterator did not visit every node.")
+    linked_list_delete_iterator(iter);
+
+    for (size_t i = 0; i < count; i++) {
+        status = linked_list_remove(ll, 0);
+        FAIL(status == false,
+             "linked_list_remove() failed.")
+    }
+    FAIL(linked_list_size(ll) != 0,
+         "Linked list not empty after removing every node.")
+    status = linked_list_delete(ll);
+    FAIL(status == false,
+         "Failed to delete emptied linked_list.")
+    linked_list_final_cleanup();
+
     PASS(linked_list_additional_delete_tests)
 #endif 
 }
@@ -573,6 +781,8 @@ int main(void) {
     check_null_handling();
     check_empty_list_and_queue_properties();
     check_insertion_functionality();
+    check_queue_visited_functionality();
+    check_deque_functionality();
     check_linked_list_find_functionality();
 
     check_linked_list_additional_delete_tests();
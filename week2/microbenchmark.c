@@ -0,0 +1,304 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "linked_list.h"
+#include "perf_counters.h"
+#include "queue.h"
+
+// Microbenchmarks for the linked_list and queue APIs. Each operation is
+// timed over a whole list of the requested size, repeated a number of
+// times, and reported as ns/op percentiles over those repetitions.
+//
+// Usage: microbenchmark [-s size,size,...] [-r repetitions] [-f text|json] [-o file]
+
+#define MAX_SIZES 16
+#define FIND_QUERIES 64
+
+struct microbenchmark_options {
+    size_t sizes[MAX_SIZES];
+    size_t size_count;
+    size_t repetitions;
+    enum bench_format format;
+    FILE * out;
+};
+
+// Accumulates timings and hardware counters for one operation.
+struct measurement {
+    struct bench_samples samples;
+    struct perf_counters pc;
+    uint64_t counter_totals[PERF_COUNTER_MAX];
+    size_t operations;
+    uint64_t start_ns;
+};
+
+static void measurement_begin(struct measurement * m) {
+    perf_counters_start(&m->pc);
+    m->start_ns = bench_now_ns();
+}
+
+static void measurement_end(struct measurement * m, size_t operations) {
+    uint64_t elapsed = bench_now_ns() - m->start_ns;
+    perf_counters_stop(&m->pc);
+
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        m->counter_totals[id] += m->pc.values[id];
+    }
+
+    m->operations += operations;
+    bench_samples_add(&m->samples, (double)elapsed / (double)operations);
+}
+
+// Summarizes and emits one operation, then resets the measurement.
+static void measurement_report(struct measurement * m,
+                               const struct microbenchmark_options * opts,
+                               const char * operation,
+                               size_t size) {
+    struct bench_record record;
+    bench_record_init(&record, "microbenchmark", operation, size);
+    bench_samples_summarize(&m->samples, &record.summary);
+
+    memcpy(m->pc.values, m->counter_totals, sizeof(m->counter_totals));
+    perf_counters_add_to_record(&m->pc, &record, m->operations);
+    bench_record_emit(opts->out, opts->format, &record);
+
+    bench_samples_reset(&m->samples);
+    memset(m->counter_totals, 0, sizeof(m->counter_totals));
+    m->operations = 0;
+}
+
+static struct linked_list * build_list(size_t size) {
+    struct linked_list * ll = linked_list_create();
+
+    for (size_t i = 0; i < size; i++) {
+        linked_list_insert_end(ll, (unsigned int)i);
+    }
+
+    return ll;
+}
+
+static void benchmark_linked_list(struct measurement * m,
+                                  const struct microbenchmark_options * opts,
+                                  size_t size) {
+    // Insertion at the front.
+    //
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        struct linked_list * ll = linked_list_create();
+        measurement_begin(m);
+        for (size_t i = 0; i < size; i++) {
+            linked_list_insert_front(ll, (unsigned int)i);
+        }
+        measurement_end(m, size);
+        linked_list_delete(ll);
+    }
+    measurement_report(m, opts, "linked_list_insert_front", size);
+
+    // Insertion at the end.
+    //
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        struct linked_list * ll = linked_list_create();
+        measurement_begin(m);
+        for (size_t i = 0; i < size; i++) {
+            linked_list_insert_end(ll, (unsigned int)i);
+        }
+        measurement_end(m, size);
+        linked_list_delete(ll);
+    }
+    measurement_report(m, opts, "linked_list_insert_end", size);
+
+    // Full iteration, reported per node visited.
+    //
+    struct linked_list * ll = build_list(size);
+    volatile unsigned int sink = 0;
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        struct iterator * iter = linked_list_create_iterator(ll, 0);
+        unsigned int sum = 0;
+        measurement_begin(m);
+        do {
+            sum += iter->data;
+        } while (linked_list_iterate(iter));
+        measurement_end(m, size);
+        sink += sum;
+        linked_list_delete_iterator(iter);
+    }
+    measurement_report(m, opts, "linked_list_iterate", size);
+
+    // Finds of values spread evenly over the list, reported per call.
+    //
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        size_t found = 0;
+        measurement_begin(m);
+        for (size_t q = 0; q < FIND_QUERIES; q++) {
+            found += linked_list_find(ll, (unsigned int)((q * size) / FIND_QUERIES));
+        }
+        measurement_end(m, FIND_QUERIES);
+        sink += (unsigned int)found;
+    }
+    measurement_report(m, opts, "linked_list_find", size);
+    (void)sink;
+
+    // Removal from the front until empty.
+    //
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        if (r != 0) {
+            ll = build_list(size);
+        }
+        measurement_begin(m);
+        for (size_t i = 0; i < size; i++) {
+            linked_list_remove(ll, 0);
+        }
+        measurement_end(m, size);
+        linked_list_delete(ll);
+    }
+    measurement_report(m, opts, "linked_list_remove_front", size);
+}
+
+static void benchmark_queue(struct measurement * m,
+                            const struct microbenchmark_options * opts,
+                            size_t size) {
+    unsigned int data = 0;
+
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        struct queue * queue = queue_create();
+        measurement_begin(m);
+        for (size_t i = 0; i < size; i++) {
+            queue_push(queue, (unsigned int)i);
+        }
+        measurement_end(m, size);
+        queue_delete(queue);
+    }
+    measurement_report(m, opts, "queue_push", size);
+
+    for (size_t r = 0; r < opts->repetitions; r++) {
+        struct queue * queue = queue_create();
+        for (size_t i = 0; i < size; i++) {
+            queue_push(queue, (unsigned int)i);
+        }
+        measurement_begin(m);
+        for (size_t i = 0; i < size; i++) {
+            queue_pop(queue, &data);
+        }
+        measurement_end(m, size);
+        queue_delete(queue);
+    }
+    measurement_report(m, opts, "queue_pop", size);
+}
+
+// Parses a comma separated list of sizes.
+static bool parse_sizes(const char * arg, struct microbenchmark_options * opts) {
+    char * end = NULL;
+    opts->size_count = 0;
+
+    while (*arg != '\0' && opts->size_count < MAX_SIZES) {
+        unsigned long long value = strtoull(arg, &end, 10);
+
+        if (end == arg || value == 0) {
+            return false;
+        }
+
+        opts->sizes[opts->size_count] = (size_t)value;
+        opts->size_count += 1;
+        arg = (*end == ',') ? end + 1 : end;
+    }
+
+    return opts->size_count != 0;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s [-s size,size,...] [-r repetitions] [-f text|json] [-o file]\n",
+            program);
+}
+
+int main(int argc, char ** argv) {
+    struct microbenchmark_options opts = {
+        .sizes = {1000, 10000, 100000},
+        .size_count = 3,
+        .repetitions = 10,
+        .format = BENCH_FORMAT_TEXT,
+        .out = stdout
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:r:f:o:h")) != -1) {
+        switch (opt) {
+        case 's':
+            if (!parse_sizes(optarg, &opts)) {
+                usage(argv[0]);
+                return 2;
+            }
+            break;
+        case 'r':
+            opts.repetitions = strtoull(optarg, NULL, 10);
+            break;
+        case 'f':
+            opts.format = (strcmp(optarg, "json") == 0) ? BENCH_FORMAT_JSON : BENCH_FORMAT_TEXT;
+            break;
+        case 'o':
+            opts.out = fopen(optarg, "w");
+            if (opts.out == NULL) {
+                perror(optarg);
+                return 2;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (opts.repetitions == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+    queue_register_malloc(&malloc);
+    queue_register_free(&free);
+
+    struct measurement m;
+    memset(&m, 0, sizeof(m));
+    bench_samples_init(&m.samples, opts.repetitions);
+    perf_counters_open(&m.pc);
+
+    for (size_t i = 0; i < opts.size_count; i++) {
+        benchmark_linked_list(&m, &opts, opts.sizes[i]);
+        benchmark_queue(&m, &opts, opts.sizes[i]);
+    }
+
+    perf_counters_close(&m.pc);
+    bench_samples_free(&m.samples);
+    linked_list_final_cleanup();
+
+    if (opts.out != stdout) {
+        fclose(opts.out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "perf_counters.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+static const char * perf_counter_names[PERF_COUNTER_MAX] = {
+    "cycles_per_op",
+    "instructions_per_op",
+    "cache_references_per_op",
+    "cache_misses_per_op",
+    "l1d_read_misses_per_op"
+};
+
+#ifdef __linux__
+// glibc does not provide a wrapper for perf_event_open().
+static int __perf_event_open(struct perf_event_attr * attr) {
+    return (int)syscall(SYS_perf_event_open, attr, 0, -1, -1, 0);
+}
+
+// Fills in the type/config pair for a counter.
+static void __perf_counters_attr(enum perf_counter_id id, struct perf_event_attr * attr) {
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->disabled = 1;
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    attr->type = PERF_TYPE_HARDWARE;
+
+    switch (id) {
+    case PERF_COUNTER_CYCLES:
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PERF_COUNTER_INSTRUCTIONS:
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERF_COUNTER_CACHE_REFERENCES:
+        attr->config = PERF_COUNT_HW_CACHE_REFERENCES;
+        break;
+    case PERF_COUNTER_CACHE_MISSES:
+        attr->config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    default:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_L1D |
+                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    }
+}
+#endif
+
+// Opens whichever of the hardware counters are available.
+bool perf_counters_open(struct perf_counters * pc) {
+    memset(pc, 0, sizeof(*pc));
+
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        pc->fds[id] = -1;
+
+#ifdef __linux__
+        struct perf_event_attr attr;
+        __perf_counters_attr((enum perf_counter_id)id, &attr);
+        pc->fds[id] = __perf_event_open(&attr);
+
+        if (pc->fds[id] >= 0) {
+            pc->open_count += 1;
+        }
+#endif
+    }
+
+    return pc->open_count != 0;
+}
+
+// Resets and enables all open counters.
+void perf_counters_start(struct perf_counters * pc) {
+#ifdef __linux__
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        if (pc->fds[id] >= 0) {
+            ioctl(pc->fds[id], PERF_EVENT_IOC_RESET, 0);
+            ioctl(pc->fds[id], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#else
+    (void)pc;
+#endif
+}
+
+// Disables all open counters and reads their values.
+void perf_counters_stop(struct perf_counters * pc) {
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        pc->values[id] = 0;
+
+        if (pc->fds[id] < 0) {
+            continue;
+        }
+
+#ifdef __linux__
+        ioctl(pc->fds[id], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(pc->fds[id], &pc->values[id], sizeof(uint64_t)) != sizeof(uint64_t)) {
+            pc->values[id] = 0;
+        }
+#endif
+    }
+}
+
+// Returns whether a particular counter is open.
+bool perf_counters_available(const struct perf_counters * pc,
+                             enum perf_counter_id id) {
+    return id < PERF_COUNTER_MAX && pc->fds[id] >= 0;
+}
+
+// Returns the name used for a counter in benchmark records.
+const char * perf_counters_name(enum perf_counter_id id) {
+    return id < PERF_COUNTER_MAX ? perf_counter_names[id] : "unknown";
+}
+
+// Adds every open counter, per operation, to a benchmark record.
+void perf_counters_add_to_record(const struct perf_counters * pc,
+                                 struct bench_record * record,
+                                 size_t operations) {
+
+    if (operations == 0) {
+        return;
+    }
+
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        if (pc->fds[id] >= 0) {
+            bench_record_add_counter(record, perf_counter_names[id],
+                                     (double)pc->values[id] / (double)operations);
+        }
+    }
+}
+
+// Closes all open counters.
+void perf_counters_close(struct perf_counters * pc) {
+    for (int id = 0; id < PERF_COUNTER_MAX; id++) {
+        if (pc->fds[id] >= 0) {
+            close(pc->fds[id]);
+            pc->fds[id] = -1;
+        }
+    }
+
+    pc->open_count = 0;
+}
@@ -0,0 +1,98 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _PERF_COUNTERS_H
+#define _PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bench.h"
+
+// Thin wrapper over Linux perf_event_open() hardware counters for the
+// benchmark drivers. On other platforms, or when the kernel refuses
+// access (see /proc/sys/kernel/perf_event_paranoid), no counters are
+// opened and every function degrades to a no-op.
+
+enum perf_counter_id {
+    PERF_COUNTER_CYCLES,
+    PERF_COUNTER_INSTRUCTIONS,
+    PERF_COUNTER_CACHE_REFERENCES,
+    PERF_COUNTER_CACHE_MISSES,
+    PERF_COUNTER_L1D_READ_MISSES,
+    PERF_COUNTER_MAX
+};
+
+struct perf_counters {
+    int fds[PERF_COUNTER_MAX];
+    uint64_t values[PERF_COUNTER_MAX];
+    size_t open_count;
+};
+
+// Opens whichever of the hardware counters are available for the
+// calling thread. Counters start disabled.
+// \param pc : Pointer to perf_counters (provided by caller).
+// Returns TRUE if at least one counter was opened, FALSE otherwise.
+//
+bool perf_counters_open(struct perf_counters * pc);
+
+// Resets and enables all open counters.
+// \param pc : Pointer to perf_counters.
+//
+void perf_counters_start(struct perf_counters * pc);
+
+// Disables all open counters and reads their values into pc->values.
+// \param pc : Pointer to perf_counters.
+//
+void perf_counters_stop(struct perf_counters * pc);
+
+// Returns whether a particular counter is open.
+// \param pc : Pointer to perf_counters.
+// \param id : Counter to check.
+//
+bool perf_counters_available(const struct perf_counters * pc,
+                             enum perf_counter_id id);
+
+// Returns the name used for a counter in benchmark records.
+// \param id : Counter to name.
+//
+const char * perf_counters_name(enum perf_counter_id id);
+
+// Adds every open counter, divided by the number of operations, to
+// a benchmark record.
+// \param pc         : Pointer to perf_counters.
+// \param record     : Record to add counters to.
+// \param operations : Number of operations measured while enabled.
+//
+void perf_counters_add_to_record(const struct perf_counters * pc,
+                                 struct bench_record * record,
+                                 size_t operations);
+
+// Closes all open counters.
+// \param pc : Pointer to perf_counters.
+//
+void perf_counters_close(struct perf_counters * pc);
+
+#endif
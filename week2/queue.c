@@ -24,6 +24,11 @@ SOFTWARE. */
 
 #include "queue.h"
 
+#include <string.h>
+
+// Slots a new deque starts with, doubled whenever it fills up.
+#define DEQUE_INITIAL_CAPACITY 64
+
 // Implement your queue functions here.
 //
 
@@ -54,11 +59,36 @@ struct queue * queue_create(void) {
 
     if (q != NULL) {
         q->ll = linked_list_create();
+        q->visited = NULL;
+        q->vertex_count = 0;
     }
 
     return q;
 }
 
+// Creates a new queue that owns a cleared visited bitmap.
+struct queue * queue_create_with_visited(size_t vertex_count) {
+
+    struct queue *q = queue_create();
+
+    if (q == NULL) {
+        return NULL;
+    }
+
+    size_t words = (vertex_count + 63) / 64;
+    q->visited = (uint64_t *)malloc_fptr((words == 0 ? 1 : words) * sizeof(uint64_t));
+
+    if (q->visited == NULL) {
+        queue_delete(q);
+        return NULL;
+    }
+
+    memset(q->visited, 0, words * sizeof(uint64_t));
+    q->vertex_count = vertex_count;
+
+    return q;
+}
+
 // Deletes a queue.
 bool queue_delete(struct queue * queue) {
 
@@ -67,6 +97,9 @@ bool queue_delete(struct queue * queue) {
     }
 
     linked_list_delete(queue->ll);
+    if (queue->visited != NULL) {
+        free_fptr(queue->visited);
+    }
     free_fptr(queue);
 
     return true;
@@ -82,6 +115,136 @@ bool queue_push(struct queue * queue, unsigned int data) {
     return linked_list_insert_end(queue->ll, data);
 }
 
+// Pushes an unsigned int unless it has been visited before.
+bool queue_push_if_new(struct queue * queue, unsigned int data) {
+
+    if (queue == NULL || queue->visited == NULL || data >= queue->vertex_count) {
+        return false;
+    }
+
+    uint64_t mask = 1ull << (data % 64);
+    uint64_t * word = &queue->visited[data / 64];
+
+    if (*word & mask) {
+        return false;
+    }
+
+    // Only a value that made it into the queue counts as visited.
+    //
+    if (!linked_list_insert_end(queue->ll, data)) {
+        return false;
+    }
+
+    *word |= mask;
+    return true;
+}
+
+// Pushes the values of one bitmap word that have not been visited yet.
+size_t queue_push_if_new_word(struct queue * queue, size_t word, uint64_t mask) {
+
+    if (queue == NULL || queue->visited == NULL || word >= (queue->vertex_count + 63) / 64) {
+        return SIZE_MAX;
+    }
+
+    // Bits past the end of the value space are never pushed.
+    //
+    if (word == queue->vertex_count / 64) {
+        mask &= (1ull << (queue->vertex_count % 64)) - 1;
+    }
+
+    uint64_t fresh = mask & ~queue->visited[word];
+    queue->visited[word] |= fresh;
+
+    size_t pushed = 0;
+    while (fresh != 0) {
+        unsigned int data = (unsigned int)(word * 64 + (size_t)__builtin_ctzll(fresh));
+
+        // The values that were not pushed must not stay visited.
+        //
+        if (!linked_list_insert_end(queue->ll, data)) {
+            queue->visited[word] &= ~fresh;
+            return SIZE_MAX;
+        }
+
+        fresh &= fresh - 1;
+        pushed += 1;
+    }
+
+    return pushed;
+}
+
+// Pushes an array of unsigned ints, one bitmap word at a time.
+size_t queue_push_if_new_bulk(struct queue * queue, const unsigned int * data, size_t count) {
+
+    if (queue == NULL || queue->visited == NULL || (data == NULL && count != 0)) {
+        return SIZE_MAX;
+    }
+
+    size_t pushed = 0;
+    size_t i = 0;
+
+    while (i < count) {
+        size_t word = data[i] / 64;
+        uint64_t mask = 0;
+
+        // Out of range values are skipped, like queue_push_if_new().
+        //
+        for (; i < count && data[i] / 64 == word; i++) {
+            if (data[i] < queue->vertex_count) {
+                mask |= 1ull << (data[i] % 64);
+            }
+        }
+
+        if (mask == 0) {
+            continue;
+        }
+
+        size_t word_pushed = queue_push_if_new_word(queue, word, mask);
+        if (word_pushed == SIZE_MAX) {
+            return SIZE_MAX;
+        }
+
+        pushed += word_pushed;
+    }
+
+    return pushed;
+}
+
+// Returns whether a value has been marked visited.
+bool queue_visited(struct queue * queue, unsigned int data) {
+
+    if (queue == NULL || queue->visited == NULL || data >= queue->vertex_count) {
+        return false;
+    }
+
+    return (queue->visited[data / 64] >> (data % 64)) & 1;
+}
+
+// Marks a value visited without pushing it.
+bool queue_mark_visited(struct queue * queue, unsigned int data) {
+
+    if (queue == NULL || queue->visited == NULL || data >= queue->vertex_count) {
+        return false;
+    }
+
+    uint64_t bit = 1ull << (data % 64);
+    bool fresh = (queue->visited[data / 64] & bit) == 0;
+    queue->visited[data / 64] |= bit;
+
+    return fresh;
+}
+
+// Clears the visited bitmap.
+bool queue_clear_visited(struct queue * queue) {
+
+    if (queue == NULL || queue->visited == NULL) {
+        return false;
+    }
+
+    memset(queue->visited, 0, ((queue->vertex_count + 63) / 64) * sizeof(uint64_t));
+    return true;
+}
+
 // Returns the size of the queue.
 size_t queue_size(struct queue * queue) {
 
@@ -131,4 +294,162 @@ bool queue_pop(struct queue * queue, unsigned int * popped_data) {
     }
 
     return false;
-}
\ No newline at end of file
+}
+
+// Creates a new, empty deque.
+struct deque * deque_create(void) {
+
+    struct deque * d = (struct deque *)malloc_fptr(sizeof(struct deque));
+
+    if (d == NULL) {
+        return NULL;
+    }
+
+    d->data = (unsigned int *)malloc_fptr(DEQUE_INITIAL_CAPACITY * sizeof(unsigned int));
+
+    if (d->data == NULL) {
+        free_fptr(d);
+        return NULL;
+    }
+
+    d->capacity = DEQUE_INITIAL_CAPACITY;
+    d->head = 0;
+    d->size = 0;
+
+    return d;
+}
+
+// Deletes a deque.
+bool deque_delete(struct deque * deque) {
+
+    if (deque == NULL) {
+        return false;
+    }
+
+    free_fptr(deque->data);
+    free_fptr(deque);
+
+    return true;
+}
+
+// Doubles the ring buffer, unwrapping the values to its start.
+static bool __deque_grow(struct deque * deque) {
+    size_t capacity = deque->capacity * 2;
+    unsigned int * data = (unsigned int *)malloc_fptr(capacity * sizeof(unsigned int));
+
+    if (data == NULL) {
+        return false;
+    }
+
+    size_t first = deque->capacity - deque->head;
+    if (first > deque->size) {
+        first = deque->size;
+    }
+
+    memcpy(data, deque->data + deque->head, first * sizeof(unsigned int));
+    memcpy(data + first, deque->data, (deque->size - first) * sizeof(unsigned int));
+    free_fptr(deque->data);
+
+    deque->data = data;
+    deque->capacity = capacity;
+    deque->head = 0;
+
+    return true;
+}
+
+// Pushes an unsigned int onto the back of the deque.
+bool deque_push_back(struct deque * deque, unsigned int data) {
+
+    if (deque == NULL || (deque->size == deque->capacity && !__deque_grow(deque))) {
+        return false;
+    }
+
+    deque->data[(deque->head + deque->size) & (deque->capacity - 1)] = data;
+    deque->size += 1;
+
+    return true;
+}
+
+// Pushes an unsigned int onto the front of the deque.
+bool deque_push_front(struct deque * deque, unsigned int data) {
+
+    if (deque == NULL || (deque->size == deque->capacity && !__deque_grow(deque))) {
+        return false;
+    }
+
+    deque->head = (deque->head - 1) & (deque->capacity - 1);
+    deque->data[deque->head] = data;
+    deque->size += 1;
+
+    return true;
+}
+
+// Returns the value at the front of the deque, but does not pop it.
+bool deque_peek_front(struct deque * deque, unsigned int * popped_data) {
+
+    if (deque == NULL || popped_data == NULL || deque->size == 0) {
+        return false;
+    }
+
+    *popped_data = deque->data[deque->head];
+    return true;
+}
+
+// Returns the value at the back of the deque, but does not pop it.
+bool deque_peek_back(struct deque * deque, unsigned int * popped_data) {
+
+    if (deque == NULL || popped_data == NULL || deque->size == 0) {
+        return false;
+    }
+
+    *popped_data = deque->data[(deque->head + deque->size - 1) & (deque->capacity - 1)];
+    return true;
+}
+
+// Pops an unsigned int from the front of the deque, if one exists.
+bool deque_pop_front(struct deque * deque, unsigned int * popped_data) {
+
+    if (!deque_peek_front(deque, popped_data)) {
+        return false;
+    }
+
+    deque->head = (deque->head + 1) & (deque->capacity - 1);
+    deque->size -= 1;
+
+    return true;
+}
+
+// Pops an unsigned int from the back of the deque, if one exists.
+bool deque_pop_back(struct deque * deque, unsigned int * popped_data) {
+
+    if (!deque_peek_back(deque, popped_data)) {
+        return false;
+    }
+
+    deque->size -= 1;
+
+    return true;
+}
+
+// Returns the size of the deque.
+size_t deque_size(struct deque * deque) {
+
+    if (deque == NULL) {
+        return SIZE_MAX;
+    }
+
+    return deque->size;
+}
+
+// Empties the deque, keeping its buffer.
+bool deque_clear(struct deque * deque) {
+
+    if (deque == NULL) {
+        return false;
+    }
+
+    deque->head = 0;
+    deque->size = 0;
+
+    return true;
+}
@@ -39,9 +39,18 @@ SOFTWARE. */
 //    declarations of those function pointers.
 
 // Definition of the queue.
+//
+// A queue created by queue_create_with_visited() also owns a bitmap
+// over the vertex ID space [0, vertex_count), with a bit set for every
+// value ever pushed through queue_push_if_new() and friends. A value
+// is pushed at most once, so a BFS frontier never holds duplicates and
+// the caller does not keep a visited set of its own. visited is NULL
+// for a plain queue.
 // 
 struct queue {
     struct linked_list* ll;
+    uint64_t * visited;
+    size_t vertex_count;
 };
 
 
@@ -93,6 +102,155 @@ bool queue_has_next(struct queue * queue);
 //
 bool queue_next(struct queue * queue, unsigned int * popped_data);
 
+// Creates a new queue that owns a cleared visited bitmap.
+// PRECONDITION: Same as queue_create().
+// \param vertex_count : Size of the value space, every value pushed
+//                       through queue_push_if_new() must be below it.
+// Returns a new queue on success, NULL on failure.
+//
+struct queue * queue_create_with_visited(size_t vertex_count);
+
+// Pushes an unsigned int onto the queue and marks it visited, unless it
+// has been marked visited before. One test-and-set and a push.
+// \param queue : Pointer to queue created by queue_create_with_visited().
+// \param data  : Data to insert.
+// Returns TRUE if data was pushed, FALSE if it was visited already (or
+// out of range, or on failure).
+//
+bool queue_push_if_new(struct queue * queue, unsigned int data);
+
+// Pushes the values of one 64-bit word of the bitmap at once: every bit
+// b set in mask stands for value 64 * word + b. Those not visited yet
+// are marked with a single word operation and pushed in increasing
+// order.
+// \param queue : Pointer to queue created by queue_create_with_visited().
+// \param word  : Index of the bitmap word, below (vertex_count + 63) / 64.
+// \param mask  : Values of the word to push.
+// Returns the number of values pushed, SIZE_MAX on failure (values not
+// pushed by then are left unvisited).
+//
+size_t queue_push_if_new_word(struct queue * queue, size_t word, uint64_t mask);
+
+// Pushes an array of unsigned ints like queue_push_if_new(), gathering
+// runs of values that share a bitmap word into one
+// queue_push_if_new_word() call. Values within such a run are pushed in
+// increasing order, so a sorted array keeps its order; duplicates in the
+// array are pushed once.
+// \param queue : Pointer to queue created by queue_create_with_visited().
+// \param data  : Array of data to insert.
+// \param count : Number of entries in data.
+// Returns the number of values pushed, SIZE_MAX on failure.
+//
+size_t queue_push_if_new_bulk(struct queue * queue, const unsigned int * data, size_t count);
+
+// Returns whether a value has been marked visited.
+// \param queue : Pointer to queue created by queue_create_with_visited().
+// \param data  : Value to check.
+// Returns TRUE if visited, FALSE otherwise (including out of range).
+//
+bool queue_visited(struct queue * queue, unsigned int data);
+
+// Marks a value visited without pushing it, so that later
+// queue_push_if_new() calls skip it, e.g. to rule a vertex out of a
+// search.
+// \param queue : Pointer to queue created by queue_create_with_visited().
+// \param data  : Value to mark.
+// Returns TRUE if it was not visited before, FALSE otherwise (including
+// out of range).
+//
+bool queue_mark_visited(struct queue * queue, unsigned int data);
+
+// Clears the visited bitmap, so the queue can be reused for another
+// search. Queued values stay queued.
+// \param queue : Pointer to queue created by queue_create_with_visited().
+// Returns TRUE on success, FALSE otherwise.
+//
+bool queue_clear_visited(struct queue * queue);
+
+// Definition of the double-ended queue.
+//
+// The node list behind struct queue is singly linked, so removing its
+// last node means walking the list. A deque instead keeps its values in
+// a ring buffer, a power of two in size and doubled when full, so that
+// pushing and popping at either end is O(1) (amortized, for pushes).
+// Values are contiguous, which also suits a BFS that streams through
+// them.
+//
+struct deque {
+    unsigned int * data;
+    size_t capacity;
+    size_t head;
+    size_t size;
+};
+
+// Creates a new, empty deque.
+// PRECONDITION: Same as queue_create().
+// Returns a new deque on success, NULL on failure.
+//
+struct deque * deque_create(void);
+
+// Deletes a deque.
+// \param deque : Pointer to deque to delete.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_delete(struct deque * deque);
+
+// Pushes an unsigned int onto the back of the deque, like queue_push().
+// \param deque : Pointer to deque.
+// \param data  : Data to insert.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_push_back(struct deque * deque, unsigned int data);
+
+// Pushes an unsigned int onto the front of the deque, so that it is
+// popped before everything already queued.
+// \param deque : Pointer to deque.
+// \param data  : Data to insert.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_push_front(struct deque * deque, unsigned int data);
+
+// Pops an unsigned int from the front of the deque, if one exists, like
+// queue_pop().
+// \param deque       : Pointer to deque.
+// \param popped_data : Pointer to popped data (provided by caller), if pop occurs.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_pop_front(struct deque * deque, unsigned int * popped_data);
+
+// Pops an unsigned int from the back of the deque, if one exists.
+// \param deque       : Pointer to deque.
+// \param popped_data : Pointer to popped data (provided by caller), if pop occurs.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_pop_back(struct deque * deque, unsigned int * popped_data);
+
+// Returns the value at the front of the deque, but does not pop it.
+// \param deque       : Pointer to deque.
+// \param popped_data : Pointer to data (provided by caller), if one exists.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_peek_front(struct deque * deque, unsigned int * popped_data);
+
+// Returns the value at the back of the deque, but does not pop it.
+// \param deque       : Pointer to deque.
+// \param popped_data : Pointer to data (provided by caller), if one exists.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_peek_back(struct deque * deque, unsigned int * popped_data);
+
+// Returns the size of the deque.
+// \param deque : Pointer to deque.
+// Returns size on success, SIZE_MAX otherwise.
+//
+size_t deque_size(struct deque * deque);
+
+// Empties the deque, keeping its buffer for reuse.
+// \param deque : Pointer to deque.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool deque_clear(struct deque * deque);
+
 // Registers malloc() function.
 // \param malloc : Function pointer to malloc()-like function.
 // POSTCONDITION: Initializes malloc() function pointer in linked_list.
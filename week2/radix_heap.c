@@ -0,0 +1,268 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include "radix_heap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Life of an item between clears.
+enum radix_heap_state {
+    RADIX_HEAP_NEW,
+    RADIX_HEAP_QUEUED,
+    RADIX_HEAP_POPPED
+};
+
+// Returns the bucket of a key: 0 if it equals the last key popped,
+// otherwise one more than the highest bit it differs from it in.
+static inline unsigned int __radix_heap_bucket(const struct radix_heap * heap, unsigned int key) {
+    return key == heap->last ? 0 : 32 - (unsigned int)__builtin_clz(key ^ heap->last);
+}
+
+// Returns whether an entry still holds its item's key, i.e. it was not
+// left behind by decrease_key or a pop.
+static inline bool __radix_heap_live(const struct radix_heap * heap, struct radix_heap_entry entry) {
+    return heap->states[entry.item] == RADIX_HEAP_QUEUED && heap->keys[entry.item] == entry.key;
+}
+
+// Appends an entry to a bucket, doubling it when it is full.
+static bool __radix_heap_append(struct radix_heap_bucket * bucket, unsigned int item, unsigned int key) {
+
+    if (bucket->size == bucket->capacity) {
+        size_t capacity = bucket->capacity == 0 ? 16 : bucket->capacity * 2;
+        struct radix_heap_entry * entries = (struct radix_heap_entry *)realloc(bucket->entries,
+                                                                               capacity * sizeof(struct radix_heap_entry));
+        if (entries == NULL) {
+            return false;
+        }
+
+        bucket->entries = entries;
+        bucket->capacity = capacity;
+    }
+
+    bucket->entries[bucket->size].item = item;
+    bucket->entries[bucket->size].key = key;
+    bucket->size += 1;
+
+    return true;
+}
+
+// Creates a new, empty radix heap.
+struct radix_heap * radix_heap_create(size_t capacity) {
+    struct radix_heap * heap = (struct radix_heap *)calloc(1, sizeof(struct radix_heap));
+
+    if (heap == NULL) {
+        return NULL;
+    }
+
+    heap->capacity = capacity;
+    heap->keys = (unsigned int *)malloc((capacity == 0 ? 1 : capacity) * sizeof(unsigned int));
+    heap->states = (unsigned char *)calloc(capacity == 0 ? 1 : capacity, sizeof(unsigned char));
+
+    if (heap->keys == NULL || heap->states == NULL) {
+        radix_heap_delete(heap);
+        return NULL;
+    }
+
+    return heap;
+}
+
+// Deletes a radix heap.
+bool radix_heap_delete(struct radix_heap * heap) {
+
+    if (heap == NULL) {
+        return false;
+    }
+
+    for (unsigned int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        free(heap->buckets[b].entries);
+    }
+
+    free(heap->keys);
+    free(heap->states);
+    free(heap);
+
+    return true;
+}
+
+// Pushes an item that has not been pushed before.
+bool radix_heap_push(struct radix_heap * heap, unsigned int item, unsigned int key) {
+
+    if (heap == NULL || item >= heap->capacity || heap->states[item] != RADIX_HEAP_NEW || key < heap->last) {
+        return false;
+    }
+
+    if (!__radix_heap_append(&heap->buckets[__radix_heap_bucket(heap, key)], item, key)) {
+        return false;
+    }
+
+    heap->keys[item] = key;
+    heap->states[item] = RADIX_HEAP_QUEUED;
+    heap->size += 1;
+
+    return true;
+}
+
+// Lowers the key of an item, leaving its old entry to be dropped later.
+bool radix_heap_decrease_key(struct radix_heap * heap, unsigned int item, unsigned int key) {
+
+    if (heap == NULL || item >= heap->capacity || heap->states[item] != RADIX_HEAP_QUEUED ||
+        key >= heap->keys[item] || key < heap->last) {
+        return false;
+    }
+
+    if (!__radix_heap_append(&heap->buckets[__radix_heap_bucket(heap, key)], item, key)) {
+        return false;
+    }
+
+    heap->keys[item] = key;
+    return true;
+}
+
+// Refills bucket 0 from the lowest bucket with a live entry: its
+// smallest key becomes the last key, and every live entry in it moves
+// to a lower bucket. Returns FALSE if no bucket has a live entry.
+static bool __radix_heap_redistribute(struct radix_heap * heap) {
+
+    for (unsigned int b = 1; b < RADIX_HEAP_BUCKETS; b++) {
+        struct radix_heap_bucket * bucket = &heap->buckets[b];
+        unsigned int smallest = UINT32_MAX;
+        size_t live = 0;
+
+        // Compacts the live entries to the front while looking for the
+        // smallest key, so a bucket of stale entries is just emptied.
+        //
+        for (size_t i = 0; i < bucket->size; i++) {
+            struct radix_heap_entry entry = bucket->entries[i];
+
+            if (__radix_heap_live(heap, entry)) {
+                bucket->entries[live++] = entry;
+                if (entry.key < smallest) {
+                    smallest = entry.key;
+                }
+            }
+        }
+
+        bucket->size = 0;
+        if (live == 0) {
+            continue;
+        }
+
+        // Every key in this bucket differs from the new last key below
+        // bit b - 1, so each entry lands in a lower bucket, never this one.
+        //
+        heap->last = smallest;
+        for (size_t i = 0; i < live; i++) {
+            struct radix_heap_entry entry = bucket->entries[i];
+
+            if (!__radix_heap_append(&heap->buckets[__radix_heap_bucket(heap, entry.key)], entry.item, entry.key)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+// Pops an item with the smallest key.
+bool radix_heap_pop_min(struct radix_heap * heap, unsigned int * popped_item, unsigned int * popped_key) {
+
+    if (heap == NULL || popped_item == NULL || heap->size == 0) {
+        return false;
+    }
+
+    for (;;) {
+        struct radix_heap_bucket * bucket = &heap->buckets[0];
+
+        while (bucket->size != 0) {
+            bucket->size -= 1;
+            struct radix_heap_entry entry = bucket->entries[bucket->size];
+
+            if (!__radix_heap_live(heap, entry)) {
+                continue;
+            }
+
+            heap->states[entry.item] = RADIX_HEAP_POPPED;
+            heap->size -= 1;
+            *popped_item = entry.item;
+            if (popped_key != NULL) {
+                *popped_key = entry.key;
+            }
+            return true;
+        }
+
+        if (!__radix_heap_redistribute(heap)) {
+            return false;
+        }
+    }
+}
+
+// Returns the number of items in the heap.
+size_t radix_heap_size(struct radix_heap * heap) {
+
+    if (heap == NULL) {
+        return SIZE_MAX;
+    }
+
+    return heap->size;
+}
+
+// Returns whether an item can be popped.
+bool radix_heap_has_next(struct radix_heap * heap) {
+    return heap != NULL && heap->size != 0;
+}
+
+// Returns whether an item is in the heap, and its key if so.
+bool radix_heap_contains(struct radix_heap * heap, unsigned int item, unsigned int * key) {
+
+    if (heap == NULL || item >= heap->capacity || heap->states[item] != RADIX_HEAP_QUEUED) {
+        return false;
+    }
+
+    if (key != NULL) {
+        *key = heap->keys[item];
+    }
+
+    return true;
+}
+
+// Empties the heap, keeping the bucket storage.
+bool radix_heap_clear(struct radix_heap * heap) {
+
+    if (heap == NULL) {
+        return false;
+    }
+
+    for (unsigned int b = 0; b < RADIX_HEAP_BUCKETS; b++) {
+        heap->buckets[b].size = 0;
+    }
+
+    memset(heap->states, 0, heap->capacity * sizeof(unsigned char));
+    heap->size = 0;
+    heap->last = 0;
+
+    return true;
+}
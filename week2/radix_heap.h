@@ -0,0 +1,136 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _RADIX_HEAP_H
+#define _RADIX_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Monotone priority queue of items 0 .. capacity - 1 keyed by unsigned
+// int, for Dijkstra's algorithm: a radix heap. Keys popped never
+// decrease, so every key in the heap is at least the last one popped,
+// and an item goes in bucket b when its key first differs from the last
+// popped key in bit b - 1 (bucket 0 when it is equal). Popping empties
+// the lowest non-empty bucket into the lower ones when bucket 0 is
+// empty, which moves each item at most 32 times over its life: pushes
+// and pops are O(1) amortized, with no comparisons between keys.
+//
+// Buckets are growable arrays of (item, key) entries, so emptying one
+// is a sequential scan. decrease_key does not look for the item's entry:
+// it records the new key and appends another entry, and entries whose
+// key is no longer the item's are dropped when they come up.
+//
+#define RADIX_HEAP_BUCKETS 33
+
+struct radix_heap_entry {
+    unsigned int item;
+    unsigned int key;
+};
+
+struct radix_heap_bucket {
+    struct radix_heap_entry * entries;
+    size_t size;
+    size_t capacity;
+};
+
+struct radix_heap {
+    struct radix_heap_bucket buckets[RADIX_HEAP_BUCKETS];
+    size_t capacity;
+    // Items in the heap, not entries in the buckets.
+    size_t size;
+    unsigned int last;
+    unsigned int * keys;
+    unsigned char * states;
+};
+
+// Creates a new, empty radix heap.
+// \param capacity : Number of items, every item must be below it.
+// Returns a new heap on success, NULL on failure.
+//
+struct radix_heap * radix_heap_create(size_t capacity);
+
+// Deletes a radix heap.
+// \param heap : Pointer to heap to delete.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool radix_heap_delete(struct radix_heap * heap);
+
+// Pushes an item that has not been pushed since the heap was created or
+// cleared.
+// \param heap : Pointer to heap.
+// \param item : Item to insert.
+// \param key  : Key of the item, at least the last key popped.
+// Returns TRUE on success, FALSE otherwise (including an item pushed
+// before or a key below the last one popped).
+//
+bool radix_heap_push(struct radix_heap * heap, unsigned int item, unsigned int key);
+
+// Lowers the key of an item in the heap.
+// \param heap : Pointer to heap.
+// \param item : Item in the heap.
+// \param key  : New key, below the item's key and at least the last key
+//               popped.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool radix_heap_decrease_key(struct radix_heap * heap, unsigned int item, unsigned int key);
+
+// Pops an item with the smallest key, if one exists. Items with equal
+// keys pop in no particular order.
+// \param heap        : Pointer to heap.
+// \param popped_item : Pointer to popped item (provided by caller), if pop occurs.
+// \param popped_key  : Pointer to its key (provided by caller), or NULL.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool radix_heap_pop_min(struct radix_heap * heap, unsigned int * popped_item, unsigned int * popped_key);
+
+// Returns the number of items in the heap.
+// \param heap : Pointer to heap.
+// Returns size on success, SIZE_MAX otherwise.
+//
+size_t radix_heap_size(struct radix_heap * heap);
+
+// Returns whether an item can be popped.
+// \param heap : Pointer to heap.
+// Returns TRUE if an item can be popped, FALSE otherwise.
+//
+bool radix_heap_has_next(struct radix_heap * heap);
+
+// Returns whether an item is in the heap, and its key if so.
+// \param heap : Pointer to heap.
+// \param item : Item to look up.
+// \param key  : Pointer to key (provided by caller), or NULL.
+// Returns TRUE if item is in the heap, FALSE otherwise.
+//
+bool radix_heap_contains(struct radix_heap * heap, unsigned int item, unsigned int * key);
+
+// Empties the heap, so that every item can be pushed again and keys
+// start from 0.
+// \param heap : Pointer to heap.
+// Returns TRUE on success, FALSE otherwise.
+//
+bool radix_heap_clear(struct radix_heap * heap);
+
+#endif
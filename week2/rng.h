@@ -0,0 +1,72 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#ifndef _RNG_H
+#define _RNG_H
+
+#include <stdint.h>
+
+// Small deterministic pseudo-random number generator (splitmix64) shared
+// by the benchmarks and the graph generator, so that a given seed
+// produces the same workload on every machine and libc.
+
+struct rng {
+    uint64_t state;
+};
+
+// Seeds a generator.
+// \param rng  : Pointer to generator (provided by caller).
+// \param seed : Seed value, any value including zero is valid.
+//
+static inline void rng_seed(struct rng * rng, uint64_t seed) {
+    rng->state = seed;
+}
+
+// Returns the next 64 random bits.
+// \param rng : Pointer to generator.
+//
+static inline uint64_t rng_next(struct rng * rng) {
+    uint64_t z = (rng->state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Returns a value uniformly distributed in [0, bound), bound must be non-zero.
+// \param rng   : Pointer to generator.
+// \param bound : Exclusive upper bound.
+//
+static inline uint64_t rng_bounded(struct rng * rng, uint64_t bound) {
+    // Lemire's multiply-shift reduction, the bias is negligible for our bounds.
+    return (uint64_t)(((unsigned __int128)rng_next(rng) * bound) >> 64);
+}
+
+// Returns a double uniformly distributed in [0, 1).
+// \param rng : Pointer to generator.
+//
+static inline double rng_double(struct rng * rng) {
+    return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
@@ -0,0 +1,637 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "linked_list.h"
+#include "queue.h"
+
+// Thread-count scalability benchmark for the queue and the node pool.
+//
+// Workloads, each run over increasing thread counts up to -t:
+//  1p1c  : one producer, one consumer on a shared queue.
+//  np1c  : threads - 1 producers, one consumer.
+//  npnc  : threads / 2 producers, threads / 2 consumers.
+//  churn : every thread inserts into and removes from its own private
+//          linked_list, exercising only the shared node pool.
+//
+// The queue and node pool are not thread safe, so each workload runs
+// against a "variant": a table of operations wrapping the queue.h and
+// linked_list.h APIs with some form of synchronization. New concurrent
+// queues or allocators are benchmarked by adding a row to variants[].
+//
+// Every record reports ns per operation over the repetitions along with
+// total throughput, Jain's fairness index over the per-thread rates,
+// and the efficiency relative to linear scaling from the smallest
+// thread count run for that workload.
+//
+// Usage: scalability_benchmark [-t max_threads] [-n ops_per_thread] [-r repetitions]
+//                              [-v variant] [-P] [-f text|json] [-o file]
+
+#define MAX_THREADS 256
+#define CHURN_LIST_LENGTH 64
+
+enum workload {
+    WORKLOAD_1P1C,
+    WORKLOAD_NP1C,
+    WORKLOAD_NPNC,
+    WORKLOAD_CHURN,
+    WORKLOAD_MAX
+};
+
+static const char * workload_names[WORKLOAD_MAX] = {
+    "1p1c",
+    "np1c",
+    "npnc",
+    "churn"
+};
+
+// Operations a concurrent variant provides. The shared queue is created
+// once per run; the list functions are used by the churn workload.
+struct variant {
+    const char * name;
+    void (*init)(void);
+    void (*destroy)(void);
+    struct queue * (*queue_create)(void);
+    bool (*queue_delete)(struct queue * queue);
+    bool (*queue_push)(struct queue * queue, unsigned int data);
+    bool (*queue_pop)(struct queue * queue, unsigned int * data);
+    struct linked_list * (*list_create)(void);
+    bool (*list_delete)(struct linked_list * ll);
+    bool (*list_insert_front)(struct linked_list * ll, unsigned int data);
+    bool (*list_remove_front)(struct linked_list * ll);
+};
+
+// Variant: a single mutex around every queue and node pool operation.
+//
+static pthread_mutex_t global_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+#define LOCKED(lock, unlock, type, call) \
+    type result;                        \
+    lock;                               \
+    result = call;                      \
+    unlock;                             \
+    return result;
+
+static void mutex_init(void) {}
+static void mutex_destroy(void) {}
+static struct queue * mutex_queue_create(void) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           struct queue *, queue_create())
+}
+static bool mutex_queue_delete(struct queue * queue) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           bool, queue_delete(queue))
+}
+static bool mutex_queue_push(struct queue * queue, unsigned int data) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           bool, queue_push(queue, data))
+}
+static bool mutex_queue_pop(struct queue * queue, unsigned int * data) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           bool, queue_pop(queue, data))
+}
+static struct linked_list * mutex_list_create(void) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           struct linked_list *, linked_list_create())
+}
+static bool mutex_list_delete(struct linked_list * ll) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           bool, linked_list_delete(ll))
+}
+static bool mutex_list_insert_front(struct linked_list * ll, unsigned int data) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           bool, linked_list_insert_front(ll, data))
+}
+static bool mutex_list_remove_front(struct linked_list * ll) {
+    LOCKED(pthread_mutex_lock(&global_mutex), pthread_mutex_unlock(&global_mutex),
+           bool, linked_list_remove(ll, 0))
+}
+
+// Variant: the same, with a spinlock instead of a mutex.
+//
+static pthread_spinlock_t global_spinlock;
+
+static void spin_init(void) {
+    pthread_spin_init(&global_spinlock, PTHREAD_PROCESS_PRIVATE);
+}
+static void spin_destroy(void) {
+    pthread_spin_destroy(&global_spinlock);
+}
+static struct queue * spin_queue_create(void) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           struct queue *, queue_create())
+}
+static bool spin_queue_delete(struct queue * queue) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           bool, queue_delete(queue))
+}
+static bool spin_queue_push(struct queue * queue, unsigned int data) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           bool, queue_push(queue, data))
+}
+static bool spin_queue_pop(struct queue * queue, unsigned int * data) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           bool, queue_pop(queue, data))
+}
+static struct linked_list * spin_list_create(void) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           struct linked_list *, linked_list_create())
+}
+static bool spin_list_delete(struct linked_list * ll) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           bool, linked_list_delete(ll))
+}
+static bool spin_list_insert_front(struct linked_list * ll, unsigned int data) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           bool, linked_list_insert_front(ll, data))
+}
+static bool spin_list_remove_front(struct linked_list * ll) {
+    LOCKED(pthread_spin_lock(&global_spinlock), pthread_spin_unlock(&global_spinlock),
+           bool, linked_list_remove(ll, 0))
+}
+
+static const struct variant variants[] = {
+    {"mutex", mutex_init, mutex_destroy,
+     mutex_queue_create, mutex_queue_delete, mutex_queue_push, mutex_queue_pop,
+     mutex_list_create, mutex_list_delete, mutex_list_insert_front, mutex_list_remove_front},
+    {"spinlock", spin_init, spin_destroy,
+     spin_queue_create, spin_queue_delete, spin_queue_push, spin_queue_pop,
+     spin_list_create, spin_list_delete, spin_list_insert_front, spin_list_remove_front},
+};
+
+#define VARIANT_COUNT (sizeof(variants) / sizeof(variants[0]))
+
+struct scalability_options {
+    size_t max_threads;
+    size_t ops_per_thread;
+    size_t repetitions;
+    const char * variant;
+    bool pin;
+    enum bench_format format;
+    FILE * out;
+};
+
+enum thread_role {
+    ROLE_PRODUCER,
+    ROLE_CONSUMER,
+    ROLE_CHURN
+};
+
+// State shared by all threads of one run.
+struct run {
+    const struct variant * variant;
+    struct queue * queue;
+    size_t ops_per_thread;
+    atomic_size_t remaining_pops;
+    pthread_barrier_t start;
+
+    // Threads are parked on this until all of them have been created,
+    // so that the start barrier only counts threads that exist.
+    pthread_mutex_t mutex;
+    pthread_cond_t created_cond;
+    bool created;
+    bool aborted;
+};
+
+struct worker {
+    pthread_t thread;
+    struct run * run;
+    enum thread_role role;
+    int cpu;
+    size_t ops;
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+static void pin_to_cpu(int cpu) {
+    if (cpu < 0) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void * worker_main(void * arg) {
+    struct worker * w = (struct worker *)arg;
+    struct run * run = w->run;
+    const struct variant * v = run->variant;
+    unsigned int data = 0;
+
+    pin_to_cpu(w->cpu);
+
+    pthread_mutex_lock(&run->mutex);
+    while (!run->created && !run->aborted) {
+        pthread_cond_wait(&run->created_cond, &run->mutex);
+    }
+    pthread_mutex_unlock(&run->mutex);
+
+    if (run->aborted) {
+        return NULL;
+    }
+
+    pthread_barrier_wait(&run->start);
+    w->start_ns = bench_now_ns();
+
+    if (w->role == ROLE_PRODUCER) {
+        for (size_t i = 0; i < run->ops_per_thread; i++) {
+            v->queue_push(run->queue, (unsigned int)i);
+        }
+        w->ops = run->ops_per_thread;
+    } else if (w->role == ROLE_CONSUMER) {
+        // Consumers share the total number of pops owed; claim one before
+        // popping so that every consumer exits once the work is drained.
+        //
+        while (true) {
+            size_t left = atomic_load(&run->remaining_pops);
+            if (left == 0) {
+                break;
+            }
+            if (!atomic_compare_exchange_weak(&run->remaining_pops, &left, left - 1)) {
+                continue;
+            }
+            while (!v->queue_pop(run->queue, &data)) {
+                sched_yield();
+            }
+            w->ops += 1;
+        }
+    } else {
+        struct linked_list * ll = v->list_create();
+        for (size_t i = 0; i < run->ops_per_thread; i += 2) {
+            v->list_insert_front(ll, (unsigned int)i);
+            if (linked_list_size(ll) > CHURN_LIST_LENGTH) {
+                v->list_remove_front(ll);
+                v->list_remove_front(ll);
+            }
+        }
+        v->list_delete(ll);
+        w->ops = run->ops_per_thread;
+    }
+
+    w->end_ns = bench_now_ns();
+    return NULL;
+}
+
+// Measured result of one run.
+struct run_result {
+    double wall_ns;
+    size_t total_ops;
+    double fairness;
+    double min_rate;
+    double max_rate;
+};
+
+static bool run_workload(const struct variant * variant,
+                         enum workload workload,
+                         size_t threads,
+                         const struct scalability_options * opts,
+                         const int * cpus,
+                         size_t cpu_count,
+                         struct run_result * result) {
+    struct worker workers[MAX_THREADS];
+    struct run run;
+    size_t producers = 0;
+
+    memset(workers, 0, sizeof(workers));
+    run.variant = variant;
+    run.ops_per_thread = opts->ops_per_thread;
+    run.queue = NULL;
+
+    for (size_t i = 0; i < threads; i++) {
+        if (workload == WORKLOAD_CHURN) {
+            workers[i].role = ROLE_CHURN;
+        } else if (workload == WORKLOAD_NPNC) {
+            workers[i].role = (i % 2 == 0) ? ROLE_PRODUCER : ROLE_CONSUMER;
+        } else {
+            workers[i].role = (i == threads - 1) ? ROLE_CONSUMER : ROLE_PRODUCER;
+        }
+        producers += (workers[i].role == ROLE_PRODUCER);
+        workers[i].run = &run;
+        workers[i].cpu = (opts->pin && cpu_count != 0) ? cpus[i % cpu_count] : -1;
+    }
+
+    atomic_init(&run.remaining_pops, producers * opts->ops_per_thread);
+    if (workload != WORKLOAD_CHURN) {
+        run.queue = variant->queue_create();
+        if (run.queue == NULL) {
+            fprintf(stderr, "%s: failed to create queue\n", variant->name);
+            return false;
+        }
+    }
+
+    pthread_mutex_init(&run.mutex, NULL);
+    pthread_cond_init(&run.created_cond, NULL);
+    run.created = false;
+    run.aborted = false;
+
+    size_t created = 0;
+    while (created < threads &&
+           pthread_create(&workers[created].thread, NULL, worker_main, &workers[created]) == 0) {
+        created++;
+    }
+
+    // The threads that were created are told to exit when the others
+    // could not be.
+    //
+    pthread_mutex_lock(&run.mutex);
+    if (created == threads) {
+        pthread_barrier_init(&run.start, NULL, (unsigned)threads + 1);
+        run.created = true;
+    } else {
+        run.aborted = true;
+    }
+    pthread_cond_broadcast(&run.created_cond);
+    pthread_mutex_unlock(&run.mutex);
+
+    if (run.created) {
+        pthread_barrier_wait(&run.start);
+    }
+    for (size_t i = 0; i < created; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    if (run.created) {
+        pthread_barrier_destroy(&run.start);
+    }
+    pthread_cond_destroy(&run.created_cond);
+    pthread_mutex_destroy(&run.mutex);
+
+    if (run.aborted) {
+        fprintf(stderr, "%s: failed to create %zu threads\n", variant->name, threads);
+        if (run.queue != NULL) {
+            variant->queue_delete(run.queue);
+        }
+        return false;
+    }
+
+    // Wall time spans from the first thread starting to the last finishing.
+    //
+    uint64_t first_start = workers[0].start_ns;
+    uint64_t last_end = workers[0].end_ns;
+    for (size_t i = 1; i < threads; i++) {
+        first_start = (workers[i].start_ns < first_start) ? workers[i].start_ns : first_start;
+        last_end = (workers[i].end_ns > last_end) ? workers[i].end_ns : last_end;
+    }
+    result->wall_ns = (double)(last_end - first_start);
+
+    if (run.queue != NULL) {
+        variant->queue_delete(run.queue);
+    }
+
+    // Jain's fairness index over the per-thread rates: 1.0 when all
+    // threads progress equally, 1/threads when one thread does all work.
+    //
+    double sum = 0.0;
+    double squares = 0.0;
+    result->total_ops = 0;
+    result->min_rate = 0.0;
+    result->max_rate = 0.0;
+
+    for (size_t i = 0; i < threads; i++) {
+        uint64_t elapsed = workers[i].end_ns - workers[i].start_ns;
+        double rate = (elapsed == 0) ? 0.0 : (double)workers[i].ops * 1e9 / (double)elapsed;
+        sum += rate;
+        squares += rate * rate;
+        result->total_ops += workers[i].ops;
+        if (i == 0 || rate < result->min_rate) {
+            result->min_rate = rate;
+        }
+        if (rate > result->max_rate) {
+            result->max_rate = rate;
+        }
+    }
+
+    result->fairness = (squares == 0.0) ? 0.0 : (sum * sum) / ((double)threads * squares);
+    return true;
+}
+
+// Returns the thread counts to run a workload with.
+static size_t thread_counts(enum workload workload, size_t max_threads, size_t * counts) {
+    size_t n = 0;
+    size_t first = (workload == WORKLOAD_CHURN) ? 1 : 2;
+
+    if (workload == WORKLOAD_1P1C) {
+        counts[n++] = 2;
+        return n;
+    }
+
+    for (size_t t = first; t <= max_threads; t *= 2) {
+        counts[n++] = t;
+    }
+
+    if (n == 0 || counts[n - 1] != max_threads) {
+        counts[n++] = max_threads;
+    }
+
+    return n;
+}
+
+static void benchmark_variant(const struct variant * variant,
+                              const struct scalability_options * opts,
+                              const int * cpus,
+                              size_t cpu_count) {
+    struct bench_samples samples;
+    bench_samples_init(&samples, opts->repetitions);
+    variant->init();
+
+    for (int workload = 0; workload < WORKLOAD_MAX; workload++) {
+        size_t counts[64];
+        size_t count = thread_counts((enum workload)workload, opts->max_threads, counts);
+        double base_per_thread = 0.0;
+
+        for (size_t c = 0; c < count; c++) {
+            size_t threads = counts[c];
+            double throughput = 0.0;
+            double fairness = 0.0;
+            double min_rate = 0.0;
+            double max_rate = 0.0;
+            size_t completed = 0;
+            char operation[64];
+
+            if (threads < 2 && workload != WORKLOAD_CHURN) {
+                continue;
+            }
+
+            for (size_t r = 0; r < opts->repetitions; r++) {
+                struct run_result result;
+                if (!run_workload(variant, (enum workload)workload, threads,
+                                  opts, cpus, cpu_count, &result)) {
+                    break;
+                }
+                completed += 1;
+                bench_samples_add(&samples, result.wall_ns / (double)result.total_ops);
+                throughput += (double)result.total_ops * 1e3 / result.wall_ns;
+                fairness += result.fairness;
+                min_rate += result.min_rate;
+                max_rate += result.max_rate;
+            }
+
+            // Averages are over the repetitions that ran, and a thread
+            // count none of them ran at gets no record.
+            //
+            if (completed == 0) {
+                bench_samples_reset(&samples);
+                continue;
+            }
+
+            double reps = (double)completed;
+            throughput /= reps;
+            if (base_per_thread == 0.0) {
+                base_per_thread = throughput / (double)threads;
+            }
+
+            snprintf(operation, sizeof(operation), "%s.%s", variant->name, workload_names[workload]);
+
+            struct bench_record record;
+            bench_record_init(&record, "scalability", operation, threads);
+            bench_samples_summarize(&samples, &record.summary);
+            bench_record_add_counter(&record, "throughput_mops", throughput);
+            bench_record_add_counter(&record, "jain_fairness", fairness / reps);
+            bench_record_add_counter(&record, "min_thread_mops", min_rate / reps / 1e6);
+            bench_record_add_counter(&record, "max_thread_mops", max_rate / reps / 1e6);
+            bench_record_add_counter(&record, "scaling_efficiency",
+                                     throughput / (base_per_thread * (double)threads));
+            bench_record_emit(opts->out, opts->format, &record);
+            bench_samples_reset(&samples);
+        }
+    }
+
+    variant->destroy();
+    bench_samples_free(&samples);
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s [-t max_threads] [-n ops_per_thread] [-r repetitions] "
+                    "[-v variant] [-P] [-f text|json] [-o file]\n", program);
+    fprintf(stderr, "Variants:");
+    for (size_t i = 0; i < VARIANT_COUNT; i++) {
+        fprintf(stderr, " %s", variants[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char ** argv) {
+    struct scalability_options opts = {
+        .max_threads = (size_t)sysconf(_SC_NPROCESSORS_ONLN),
+        .ops_per_thread = 200000,
+        .repetitions = 5,
+        .variant = NULL,
+        .pin = true,
+        .format = BENCH_FORMAT_TEXT,
+        .out = stdout
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:n:r:v:Pf:o:h")) != -1) {
+        switch (opt) {
+        case 't':
+            opts.max_threads = strtoull(optarg, NULL, 10);
+            break;
+        case 'n':
+            opts.ops_per_thread = strtoull(optarg, NULL, 10);
+            break;
+        case 'r':
+            opts.repetitions = strtoull(optarg, NULL, 10);
+            break;
+        case 'v':
+            opts.variant = optarg;
+            break;
+        case 'P':
+            opts.pin = false;
+            break;
+        case 'f':
+            opts.format = (strcmp(optarg, "json") == 0) ? BENCH_FORMAT_JSON : BENCH_FORMAT_TEXT;
+            break;
+        case 'o':
+            opts.out = fopen(optarg, "w");
+            if (opts.out == NULL) {
+                perror(optarg);
+                return 2;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (opts.max_threads < 2) {
+        opts.max_threads = 2;
+    }
+
+    if (opts.max_threads > MAX_THREADS || opts.repetitions == 0 || opts.ops_per_thread == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Threads are pinned round-robin over the CPUs this process may use.
+    //
+    int cpus[CPU_SETSIZE];
+    size_t cpu_count = 0;
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus[cpu_count++] = cpu;
+            }
+        }
+    }
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+    queue_register_malloc(&malloc);
+    queue_register_free(&free);
+
+    bool found = false;
+    for (size_t i = 0; i < VARIANT_COUNT; i++) {
+        if (opts.variant == NULL || strcmp(opts.variant, variants[i].name) == 0) {
+            benchmark_variant(&variants[i], &opts, cpus, cpu_count);
+            found = true;
+        }
+    }
+
+    if (!found) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    linked_list_final_cleanup();
+
+    if (opts.out != stdout) {
+        fclose(opts.out);
+    }
+
+    return 0;
+}
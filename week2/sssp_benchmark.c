@@ -0,0 +1,405 @@
+/*
+
+MIT License
+
+Copyright (c) 2025 Dan Jose
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bfs.h"
+#include "bfs_multi_source.h"
+#include "graph.h"
+#include "graph_weights.h"
+#include "linked_list.h"
+#include "queue.h"
+#include "rng.h"
+
+// Weighted shortest path benchmark: Dijkstra's algorithm on the radix
+// heap of radix_heap.h against the same loop on a binary heap, and the
+// 0-1 BFS where every weight is 0 or 1. Weights are the values of the
+// Matrix Market file (see graph_generator -w and -W); a pattern file
+// weighs every edge 1. Every engine answers the same random queries,
+// and answers are checked against the first engine run: any
+// disagreement is reported and makes the exit status 1.
+//
+// The binary heap is the textbook one, without decrease-key: a vertex
+// is pushed again each time its distance drops, and stale entries are
+// skipped when popped. It lives here, as a baseline only.
+//
+// Usage: sssp_benchmark -g graph.mtx [-q queries] [-S seed] [-n] [-j threads]
+//                       [-e engine,engine,...] [-f text|json] [-o file]
+
+#define MAX_ENGINES 4
+
+struct sssp_benchmark_options {
+    const char * graph_path;
+    size_t queries;
+    uint64_t seed;
+    struct graph_load_options load;
+    const char * engines;
+    enum bench_format format;
+    FILE * out;
+};
+
+typedef bool (*path_exists_fn)(const struct graph * graph,
+                               const struct graph_weights * weights,
+                               unsigned int source,
+                               unsigned int target,
+                               struct bfs_stats * stats);
+
+struct engine {
+    const char * name;
+    const char * operation;
+    // Largest edge weight the engine supports.
+    unsigned int max_weight;
+    path_exists_fn path_exists;
+};
+
+// Binary min-heap of (distance << 32 | vertex) entries.
+struct binary_heap {
+    uint64_t * entries;
+    size_t size;
+    size_t capacity;
+};
+
+static bool binary_heap_push(struct binary_heap * heap, uint64_t entry) {
+    if (heap->size == heap->capacity) {
+        size_t capacity = heap->capacity == 0 ? 1024 : heap->capacity * 2;
+        uint64_t * entries = realloc(heap->entries, capacity * sizeof(uint64_t));
+
+        if (entries == NULL) {
+            return false;
+        }
+
+        heap->entries = entries;
+        heap->capacity = capacity;
+    }
+
+    size_t i = heap->size++;
+    while (i > 0 && heap->entries[(i - 1) / 2] > entry) {
+        heap->entries[i] = heap->entries[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->entries[i] = entry;
+
+    return true;
+}
+
+static uint64_t binary_heap_pop(struct binary_heap * heap) {
+    uint64_t top = heap->entries[0];
+    uint64_t last = heap->entries[--heap->size];
+    size_t i = 0;
+
+    for (;;) {
+        size_t child = 2 * i + 1;
+
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && heap->entries[child + 1] < heap->entries[child]) {
+            child += 1;
+        }
+        if (heap->entries[child] >= last) {
+            break;
+        }
+
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+
+    if (heap->size != 0) {
+        heap->entries[i] = last;
+    }
+
+    return top;
+}
+
+// Dijkstra's algorithm on a binary heap, the same loop as
+// bfs_dijkstra_path_exists() otherwise.
+static bool binary_heap_path_exists(const struct graph * graph,
+                                    const struct graph_weights * weights,
+                                    unsigned int source,
+                                    unsigned int target,
+                                    struct bfs_stats * stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->distance = BFS_UNREACHABLE;
+
+    unsigned int * distances = malloc((size_t)graph->vertex_count * sizeof(unsigned int));
+    struct binary_heap heap = {NULL, 0, 0};
+    bool found = false;
+
+    if (distances == NULL) {
+        return false;
+    }
+
+    for (unsigned int v = 0; v < graph->vertex_count; v++) {
+        distances[v] = BFS_UNREACHABLE;
+    }
+
+    distances[source] = 0;
+    binary_heap_push(&heap, source);
+
+    while (heap.size != 0) {
+        uint64_t entry = binary_heap_pop(&heap);
+        unsigned int vertex = (unsigned int)entry;
+
+        if ((unsigned int)(entry >> 32) != distances[vertex]) {
+            continue;
+        }
+
+        stats->vertices_visited += 1;
+        if (vertex == target) {
+            found = true;
+            stats->distance = distances[vertex];
+            break;
+        }
+
+        for (uint64_t e = graph->offsets[vertex]; e < graph->offsets[vertex + 1]; e++) {
+            unsigned int neighbor = graph->neighbors[e];
+            uint64_t distance = (uint64_t)distances[vertex] + weights->weights[e];
+            stats->edges_traversed += 1;
+
+            if (distance >= distances[neighbor]) {
+                continue;
+            }
+
+            distances[neighbor] = (unsigned int)distance;
+            if (!binary_heap_push(&heap, distance << 32 | neighbor)) {
+                found = false;
+                break;
+            }
+        }
+
+        if (heap.size > stats->peak_queue_size) {
+            stats->peak_queue_size = heap.size;
+        }
+    }
+
+    free(heap.entries);
+    free(distances);
+    return found;
+}
+
+static const struct engine engines[] = {
+    {"binary", "dijkstra_binary_heap", UINT32_MAX, binary_heap_path_exists},
+    {"radix", "bfs_dijkstra_path_exists", UINT32_MAX, bfs_dijkstra_path_exists},
+    {"zero_one", "bfs_0_1_path_exists", 1, bfs_0_1_path_exists},
+};
+
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+// Looks up the engines named in a comma separated list.
+static size_t select_engines(const char * list, const struct engine ** selected) {
+    size_t count = 0;
+
+    while (*list != '\0') {
+        size_t length = strcspn(list, ",");
+        size_t e = 0;
+
+        while (e < ENGINE_COUNT &&
+               (strlen(engines[e].name) != length || strncmp(engines[e].name, list, length) != 0)) {
+            e++;
+        }
+
+        if (e == ENGINE_COUNT || count == MAX_ENGINES) {
+            fprintf(stderr, "Unknown engine or too many engines: %.*s\n", (int)length, list);
+            return 0;
+        }
+
+        selected[count] = &engines[e];
+        count += 1;
+        list += length + (list[length] == ',');
+    }
+
+    return count;
+}
+
+// Answers every query with one engine and emits its record. Distances
+// are written to answers, or checked against them if check is TRUE.
+// Returns the number of disagreements.
+static size_t run_engine(const struct engine * engine,
+                         const struct sssp_benchmark_options * opts,
+                         const struct graph * graph,
+                         const struct graph_weights * weights,
+                         const struct bfs_query * queries,
+                         unsigned int * answers,
+                         bool check) {
+    struct bench_samples samples;
+    struct bench_record record;
+
+    bench_samples_init(&samples, opts->queries);
+
+    uint64_t total_edges = 0;
+    uint64_t total_vertices = 0;
+    size_t reachable = 0;
+    size_t peak_queue_size = 0;
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < opts->queries; i++) {
+        struct bfs_stats stats;
+
+        uint64_t start = bench_now_ns();
+        engine->path_exists(graph, weights, queries[i].source, queries[i].target, &stats);
+        bench_samples_add(&samples, (double)(bench_now_ns() - start));
+
+        total_edges += stats.edges_traversed;
+        total_vertices += stats.vertices_visited;
+        reachable += (stats.distance != BFS_UNREACHABLE);
+        if (stats.peak_queue_size > peak_queue_size) {
+            peak_queue_size = stats.peak_queue_size;
+        }
+
+        if (!check) {
+            answers[i] = stats.distance;
+        } else if (answers[i] != stats.distance) {
+            fprintf(stderr, "%s: query %zu (%u -> %u) answered distance %u, expected %u\n",
+                    engine->name, i, queries[i].source, queries[i].target, stats.distance, answers[i]);
+            mismatches += 1;
+        }
+    }
+
+    bench_record_init(&record, "sssp", engine->operation, graph->vertex_count);
+    bench_samples_summarize(&samples, &record.summary);
+    bench_record_add_counter(&record, "edges_per_query", (double)total_edges / (double)opts->queries);
+    bench_record_add_counter(&record, "settled_per_query", (double)total_vertices / (double)opts->queries);
+    bench_record_add_counter(&record, "reachable_fraction", (double)reachable / (double)opts->queries);
+    bench_record_add_counter(&record, "peak_queue_size", (double)peak_queue_size);
+    bench_record_emit(opts->out, opts->format, &record);
+
+    bench_samples_free(&samples);
+    return mismatches;
+}
+
+static void usage(const char * program) {
+    fprintf(stderr, "Usage: %s -g graph.mtx [-q queries] [-S seed] [-n] [-j threads] "
+                    "[-e engine,engine,...] [-f text|json] [-o file]\n", program);
+}
+
+int main(int argc, char ** argv) {
+    struct sssp_benchmark_options opts = {
+        .graph_path = NULL,
+        .queries = 100,
+        .seed = 1,
+        .load = {.use_cache = true, .threads = 0},
+        .engines = "binary,radix,zero_one",
+        .format = BENCH_FORMAT_TEXT,
+        .out = stdout
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "g:q:S:nj:e:f:o:h")) != -1) {
+        switch (opt) {
+        case 'g':
+            opts.graph_path = optarg;
+            break;
+        case 'q':
+            opts.queries = strtoull(optarg, NULL, 10);
+            break;
+        case 'S':
+            opts.seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'n':
+            opts.load.use_cache = false;
+            break;
+        case 'j':
+            opts.load.threads = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'e':
+            opts.engines = optarg;
+            break;
+        case 'f':
+            opts.format = (strcmp(optarg, "json") == 0) ? BENCH_FORMAT_JSON : BENCH_FORMAT_TEXT;
+            break;
+        case 'o':
+            opts.out = fopen(optarg, "w");
+            if (opts.out == NULL) {
+                perror(optarg);
+                return 2;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    const struct engine * selected[MAX_ENGINES];
+    size_t engine_count = opts.engines[0] == '\0' ? 0 : select_engines(opts.engines, selected);
+
+    if (opts.graph_path == NULL || opts.queries == 0 || engine_count == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    linked_list_register_malloc(&malloc);
+    linked_list_register_free(&free);
+    queue_register_malloc(&malloc);
+    queue_register_free(&free);
+
+    struct graph * graph = graph_load(opts.graph_path, &opts.load);
+    struct graph_weights * weights = graph == NULL ? NULL : graph_weights_load(opts.graph_path, graph);
+    struct bfs_query * queries = malloc(opts.queries * sizeof(struct bfs_query));
+    unsigned int * answers = malloc(opts.queries * sizeof(unsigned int));
+
+    if (weights == NULL || queries == NULL || answers == NULL) {
+        free(answers);
+        free(queries);
+        graph_weights_delete(weights);
+        graph_delete(graph);
+        return 1;
+    }
+
+    struct rng rng;
+    rng_seed(&rng, opts.seed);
+    for (size_t i = 0; i < opts.queries; i++) {
+        queries[i].source = graph_vertex_id(graph, (unsigned int)rng_bounded(&rng, graph->vertex_count));
+        queries[i].target = graph_vertex_id(graph, (unsigned int)rng_bounded(&rng, graph->vertex_count));
+    }
+
+    size_t mismatches = 0;
+    bool first = true;
+    for (size_t e = 0; e < engine_count; e++) {
+        if (weights->max_weight > selected[e]->max_weight) {
+            fprintf(stderr, "%s: skipped, the graph has weights up to %u\n", selected[e]->name,
+                    weights->max_weight);
+            continue;
+        }
+
+        mismatches += run_engine(selected[e], &opts, graph, weights, queries, answers, !first);
+        first = false;
+    }
+
+    free(answers);
+    free(queries);
+    graph_weights_delete(weights);
+    graph_delete(graph);
+    linked_list_final_cleanup();
+
+    if (opts.out != stdout) {
+        fclose(opts.out);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}